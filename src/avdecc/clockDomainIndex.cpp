@@ -0,0 +1,193 @@
+/*
+* Copyright 2017-2018, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be usefu_state,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "clockDomainIndex.hpp"
+
+namespace avdecc
+{
+namespace
+{
+constexpr auto NoAvbInterface = la::avdecc::entity::model::AvbInterfaceIndex(-1);
+
+template<class StreamNodes>
+std::vector<la::avdecc::entity::model::AvbInterfaceIndex> buildBindings(StreamNodes const& streamNodes) noexcept
+{
+	auto bindings = std::vector<la::avdecc::entity::model::AvbInterfaceIndex>{};
+	for (auto const& [streamIndex, streamNode] : streamNodes)
+	{
+		if (streamIndex >= bindings.size())
+		{
+			bindings.resize(streamIndex + 1u, NoAvbInterface);
+		}
+		bindings[streamIndex] = streamNode.staticModel->avbInterfaceIndex;
+	}
+	return bindings;
+}
+
+} // namespace
+
+void ClockDomainIndex::addEntity(la::avdecc::controller::ControlledEntity const& controlledEntity) noexcept
+{
+	try
+	{
+		auto const& entity = controlledEntity.getEntity();
+		auto const& entityNode = controlledEntity.getEntityNode();
+		auto const& configurationNode = controlledEntity.getConfigurationNode(entityNode.dynamicModel->currentConfiguration);
+
+		auto domains = EntityDomains{};
+		domains.entityDomain = internDomain(entity.getGptpGrandmasterID(), entity.getGptpDomainNumber());
+		for (auto const& [avbInterfaceIndex, avbInterfaceNode] : configurationNode.avbInterfaces)
+		{
+			if (avbInterfaceIndex >= domains.interfaceDomains.size())
+			{
+				domains.interfaceDomains.resize(avbInterfaceIndex + 1u, domains.entityDomain);
+			}
+			auto const& avbInfo = avbInterfaceNode.dynamicModel->avbInfo;
+			domains.interfaceDomains[avbInterfaceIndex] = internDomain(avbInfo.gptpGrandmasterID, avbInfo.gptpDomainNumber);
+		}
+		domains.streamInputInterfaces = buildBindings(configurationNode.streamInputs);
+		domains.streamOutputInterfaces = buildBindings(configurationNode.streamOutputs);
+
+		_entities[entity.getEntityID()] = std::move(domains);
+	}
+	catch (...)
+	{
+		// Entity without valid configuration, its streams will have an unknown domain
+		removeEntity(controlledEntity.getEntity().getEntityID());
+	}
+}
+
+void ClockDomainIndex::removeEntity(la::avdecc::UniqueIdentifier const entityID) noexcept
+{
+	_entities.erase(entityID);
+}
+
+void ClockDomainIndex::clear() noexcept
+{
+	_entities.clear();
+	_domainIDs.clear();
+}
+
+bool ClockDomainIndex::setInterfaceDomain(la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::AvbInterfaceIndex const avbInterfaceIndex, la::avdecc::UniqueIdentifier const grandmasterID, std::uint8_t const domainNumber) noexcept
+{
+	auto const entityIt = _entities.find(entityID);
+	if (entityIt == _entities.end())
+	{
+		return false;
+	}
+
+	auto& domains = entityIt->second;
+	auto& domain = avbInterfaceIndex < domains.interfaceDomains.size() ? domains.interfaceDomains[avbInterfaceIndex] : domains.entityDomain;
+	auto const newDomain = internDomain(grandmasterID, domainNumber);
+	if (domain == newDomain)
+	{
+		return false;
+	}
+	domain = newDomain;
+	return true;
+}
+
+ClockDomainIndex::DomainID ClockDomainIndex::getStreamInputDomain(la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::StreamIndex const streamIndex) const noexcept
+{
+	return getStreamDomain(entityID, &EntityDomains::streamInputInterfaces, streamIndex);
+}
+
+ClockDomainIndex::DomainID ClockDomainIndex::getStreamOutputDomain(la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::StreamIndex const streamIndex) const noexcept
+{
+	return getStreamDomain(entityID, &EntityDomains::streamOutputInterfaces, streamIndex);
+}
+
+std::vector<la::avdecc::entity::model::StreamIndex> ClockDomainIndex::getBoundStreamInputs(la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::AvbInterfaceIndex const avbInterfaceIndex) const noexcept
+{
+	return getBoundStreams(entityID, &EntityDomains::streamInputInterfaces, avbInterfaceIndex);
+}
+
+std::vector<la::avdecc::entity::model::StreamIndex> ClockDomainIndex::getBoundStreamOutputs(la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::AvbInterfaceIndex const avbInterfaceIndex) const noexcept
+{
+	return getBoundStreams(entityID, &EntityDomains::streamOutputInterfaces, avbInterfaceIndex);
+}
+
+ClockDomainIndex::DomainID ClockDomainIndex::internDomain(la::avdecc::UniqueIdentifier const grandmasterID, std::uint8_t const domainNumber) noexcept
+{
+	// No grandmaster reported yet: compatible with any domain, instead of being a domain of its own
+	if (!grandmasterID.isValid())
+	{
+		return UnknownDomain;
+	}
+
+	auto const key = std::make_pair(grandmasterID.getValue(), domainNumber);
+	auto const it = _domainIDs.find(key);
+	if (it != _domainIDs.end())
+	{
+		return it->second;
+	}
+
+	auto const domainID = static_cast<DomainID>(_domainIDs.size() + 1u); // UnknownDomain is never used
+	_domainIDs.emplace(key, domainID);
+	return domainID;
+}
+
+ClockDomainIndex::DomainID ClockDomainIndex::getStreamDomain(la::avdecc::UniqueIdentifier const entityID, InterfaceBindings EntityDomains::*const bindings, la::avdecc::entity::model::StreamIndex const streamIndex) const noexcept
+{
+	auto const entityIt = _entities.find(entityID);
+	if (entityIt == _entities.end())
+	{
+		return UnknownDomain;
+	}
+
+	auto const& domains = entityIt->second;
+	auto const& streamInterfaces = domains.*bindings;
+	if (streamIndex < streamInterfaces.size())
+	{
+		auto const avbInterfaceIndex = streamInterfaces[streamIndex];
+		if (avbInterfaceIndex < domains.interfaceDomains.size())
+		{
+			return domains.interfaceDomains[avbInterfaceIndex];
+		}
+	}
+	return domains.entityDomain;
+}
+
+std::vector<la::avdecc::entity::model::StreamIndex> ClockDomainIndex::getBoundStreams(la::avdecc::UniqueIdentifier const entityID, InterfaceBindings EntityDomains::*const bindings, la::avdecc::entity::model::AvbInterfaceIndex const avbInterfaceIndex) const noexcept
+{
+	auto streams = std::vector<la::avdecc::entity::model::StreamIndex>{};
+
+	auto const entityIt = _entities.find(entityID);
+	if (entityIt == _entities.end())
+	{
+		return streams;
+	}
+
+	auto const& domains = entityIt->second;
+	auto const interfacesCount = domains.interfaceDomains.size();
+	auto const isEntityDomain = avbInterfaceIndex >= interfacesCount;
+	auto const& streamInterfaces = domains.*bindings;
+	for (auto streamIndex = std::size_t{ 0u }; streamIndex < streamInterfaces.size(); ++streamIndex)
+	{
+		auto const streamInterface = streamInterfaces[streamIndex];
+		// Streams without valid interface follow the domain of the entity
+		if (isEntityDomain ? streamInterface >= interfacesCount : streamInterface == avbInterfaceIndex)
+		{
+			streams.push_back(static_cast<la::avdecc::entity::model::StreamIndex>(streamIndex));
+		}
+	}
+	return streams;
+}
+
+} // namespace avdecc
@@ -0,0 +1,84 @@
+/*
+* Copyright 2017-2018, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be usefu_state,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <la/avdecc/internals/uniqueIdentifier.hpp>
+#include <la/avdecc/controller/internals/avdeccControlledEntity.hpp>
+#include <cstdint>
+#include <map>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace avdecc
+{
+/**
+* @brief gPTP domain of each AVB interface of the entities, and the interface each stream is bound to.
+* @details Domains (grandmaster ID and domain number) are interned to small integers, so checking if two streams are in the same domain is a lookup and an integer compare.
+*          Streams bound to no known AVB interface (entities without AVB_INTERFACE descriptor) use the grandmaster advertised by the entity.
+*          Not thread-safe, must be used from a single thread.
+*/
+class ClockDomainIndex final
+{
+public:
+	using DomainID = std::uint32_t;
+	static constexpr DomainID UnknownDomain = 0u;
+
+	/** Indexes the AVB interfaces and streams of the current configuration of the entity */
+	void addEntity(la::avdecc::controller::ControlledEntity const& controlledEntity) noexcept;
+	void removeEntity(la::avdecc::UniqueIdentifier const entityID) noexcept;
+	void clear() noexcept;
+
+	/** Sets the gPTP domain of an AVB interface (or of the entity itself if avbInterfaceIndex is not one of its interfaces). Returns true if the domain changed */
+	bool setInterfaceDomain(la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::AvbInterfaceIndex const avbInterfaceIndex, la::avdecc::UniqueIdentifier const grandmasterID, std::uint8_t const domainNumber) noexcept;
+
+	DomainID getStreamInputDomain(la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::StreamIndex const streamIndex) const noexcept;
+	DomainID getStreamOutputDomain(la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::StreamIndex const streamIndex) const noexcept;
+
+	/** Returns the streams whose domain follows the specified AVB interface */
+	std::vector<la::avdecc::entity::model::StreamIndex> getBoundStreamInputs(la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::AvbInterfaceIndex const avbInterfaceIndex) const noexcept;
+	std::vector<la::avdecc::entity::model::StreamIndex> getBoundStreamOutputs(la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::AvbInterfaceIndex const avbInterfaceIndex) const noexcept;
+
+	/** Returns true if both domains are the same, or if any of them is not known (no warning without information) */
+	static bool areDomainsCompatible(DomainID const lhs, DomainID const rhs) noexcept
+	{
+		return lhs == rhs || lhs == UnknownDomain || rhs == UnknownDomain;
+	}
+
+private:
+	using InterfaceBindings = std::vector<la::avdecc::entity::model::AvbInterfaceIndex>; // AVB interface of each stream, indexed by StreamIndex
+
+	struct EntityDomains
+	{
+		std::vector<DomainID> interfaceDomains{}; // Indexed by AvbInterfaceIndex
+		DomainID entityDomain{ UnknownDomain }; // Advertised by the entity, used by streams without valid interface
+		InterfaceBindings streamInputInterfaces{};
+		InterfaceBindings streamOutputInterfaces{};
+	};
+
+	DomainID internDomain(la::avdecc::UniqueIdentifier const grandmasterID, std::uint8_t const domainNumber) noexcept;
+	DomainID getStreamDomain(la::avdecc::UniqueIdentifier const entityID, InterfaceBindings EntityDomains::*const bindings, la::avdecc::entity::model::StreamIndex const streamIndex) const noexcept;
+	std::vector<la::avdecc::entity::model::StreamIndex> getBoundStreams(la::avdecc::UniqueIdentifier const entityID, InterfaceBindings EntityDomains::*const bindings, la::avdecc::entity::model::AvbInterfaceIndex const avbInterfaceIndex) const noexcept;
+
+	std::unordered_map<la::avdecc::UniqueIdentifier, EntityDomains, la::avdecc::UniqueIdentifier::hash> _entities{};
+	std::map<std::pair<std::uint64_t, std::uint8_t>, DomainID> _domainIDs{}; // Only grows, there are few domains on a network
+};
+
+} // namespace avdecc
@@ -19,9 +19,17 @@
 
 #include "controllerManager.hpp"
 #include <atomic>
+#include <algorithm>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <tuple>
 #include <la/avdecc/logger.hpp>
 #include "avdecc/helper.hpp"
 #include "settingsManager/settings.hpp"
+#include "profiler/profiler.hpp"
 
 #if __cpp_lib_experimental_atomic_smart_pointers
 #define HAVE_ATOMIC_SMART_POINTERS
@@ -29,6 +37,103 @@
 
 namespace avdecc
 {
+namespace
+{
+/** Trace event names must be string literals, so they cannot come from typeToString */
+char const* profilerName(ControllerManager::AecpCommandType const type) noexcept
+{
+	switch (type)
+	{
+		case ControllerManager::AecpCommandType::AcquireEntity:
+			return "AECP AcquireEntity";
+		case ControllerManager::AecpCommandType::ReleaseEntity:
+			return "AECP ReleaseEntity";
+		case ControllerManager::AecpCommandType::SetConfiguration:
+			return "AECP SetConfiguration";
+		case ControllerManager::AecpCommandType::SetStreamFormat:
+			return "AECP SetStreamFormat";
+		case ControllerManager::AecpCommandType::SetEntityName:
+			return "AECP SetEntityName";
+		case ControllerManager::AecpCommandType::SetEntityGroupName:
+			return "AECP SetEntityGroupName";
+		case ControllerManager::AecpCommandType::SetConfigurationName:
+			return "AECP SetConfigurationName";
+		case ControllerManager::AecpCommandType::SetStreamName:
+			return "AECP SetStreamName";
+		case ControllerManager::AecpCommandType::SetSamplingRate:
+			return "AECP SetSamplingRate";
+		case ControllerManager::AecpCommandType::SetClockSource:
+			return "AECP SetClockSource";
+		case ControllerManager::AecpCommandType::StartStream:
+			return "AECP StartStream";
+		case ControllerManager::AecpCommandType::StopStream:
+			return "AECP StopStream";
+		case ControllerManager::AecpCommandType::AddStreamPortAudioMappings:
+			return "AECP AddStreamPortAudioMappings";
+		case ControllerManager::AecpCommandType::RemoveStreamPortAudioMappings:
+			return "AECP RemoveStreamPortAudioMappings";
+		case ControllerManager::AecpCommandType::SetMemoryObjectLength:
+			return "AECP SetMemoryObjectLength";
+		default:
+			return "AECP Unknown";
+	}
+}
+
+char const* profilerName(ControllerManager::AcmpCommandType const type) noexcept
+{
+	switch (type)
+	{
+		case ControllerManager::AcmpCommandType::ConnectStream:
+			return "ACMP ConnectStream";
+		case ControllerManager::AcmpCommandType::DisconnectStream:
+			return "ACMP DisconnectStream";
+		case ControllerManager::AcmpCommandType::DisconnectTalkerStream:
+			return "ACMP DisconnectTalkerStream";
+		default:
+			return "ACMP Unknown";
+	}
+}
+
+/**
+* @brief Trace IDs of the commands in flight, so the begin and end events of each command are paired in the trace.
+* @details Several commands with the same key can be in flight at once, they complete in the order they were sent. Thread-safe.
+*/
+template<typename Key>
+class ProfilerIds final
+{
+public:
+	void push(Key const& key, std::uint64_t const id) noexcept
+	{
+		auto const lg = std::lock_guard{ _lock };
+		_ids[key].push_back(id);
+	}
+
+	/** Returns the ID of the oldest command in flight with this key, or 0 if there is none (sent while the profiler was disabled) */
+	std::uint64_t pop(Key const& key) noexcept
+	{
+		auto const lg = std::lock_guard{ _lock };
+		auto const idsIt = _ids.find(key);
+		if (idsIt == _ids.end())
+		{
+			return 0u;
+		}
+		auto const id = idsIt->second.front();
+		idsIt->second.pop_front();
+		if (idsIt->second.empty())
+		{
+			_ids.erase(idsIt);
+		}
+		return id;
+	}
+
+private:
+	std::mutex _lock{};
+	std::map<Key, std::deque<std::uint64_t>> _ids{};
+};
+
+using AecpProfilerKey = std::tuple<la::avdecc::UniqueIdentifier, ControllerManager::AecpCommandType>;
+using AcmpProfilerKey = std::tuple<la::avdecc::UniqueIdentifier, la::avdecc::entity::model::StreamIndex, la::avdecc::UniqueIdentifier, la::avdecc::entity::model::StreamIndex, ControllerManager::AcmpCommandType>;
+} // namespace
 
 class ControllerManagerImpl final : public ControllerManager, private la::avdecc::controller::Controller::Observer, public settings::SettingsManager::Observer
 {
@@ -68,6 +173,51 @@ public:
 		// Configure settings observers
 		auto& settings = settings::SettingsManager::getInstance();
 		settings.registerSettingObserver(settings::AemCacheEnabled.name, this);
+
+		// Trace command lifetimes, using direct connections so events are timestamped when emitted
+		connect(this, &ControllerManager::beginAecpCommand, this,
+			[this](la::avdecc::UniqueIdentifier const entityID, AecpCommandType const commandType)
+			{
+				auto& profiler = profiler::Profiler::getInstance();
+				if (profiler.isEnabled())
+				{
+					auto const id = ++_lastProfilerId;
+					_aecpProfilerIds.push({ entityID, commandType }, id);
+					profiler.addAsyncBegin("aecp", profilerName(commandType), id);
+				}
+			},
+			Qt::DirectConnection);
+		connect(this, &ControllerManager::endAecpCommand, this,
+			[this](la::avdecc::UniqueIdentifier const entityID, AecpCommandType const commandType, la::avdecc::entity::ControllerEntity::AemCommandStatus const /*status*/)
+			{
+				// Always consumed, the profiler might have been disabled since the command was sent
+				if (auto const id = _aecpProfilerIds.pop({ entityID, commandType }); id != 0u)
+				{
+					profiler::Profiler::getInstance().addAsyncEnd("aecp", profilerName(commandType), id);
+				}
+			},
+			Qt::DirectConnection);
+		connect(this, &ControllerManager::beginAcmpCommand, this,
+			[this](la::avdecc::UniqueIdentifier const talkerEntityID, la::avdecc::entity::model::StreamIndex const talkerStreamIndex, la::avdecc::UniqueIdentifier const listenerEntityID, la::avdecc::entity::model::StreamIndex const listenerStreamIndex, AcmpCommandType const commandType)
+			{
+				auto& profiler = profiler::Profiler::getInstance();
+				if (profiler.isEnabled())
+				{
+					auto const id = ++_lastProfilerId;
+					_acmpProfilerIds.push({ talkerEntityID, talkerStreamIndex, listenerEntityID, listenerStreamIndex, commandType }, id);
+					profiler.addAsyncBegin("acmp", profilerName(commandType), id);
+				}
+			},
+			Qt::DirectConnection);
+		connect(this, &ControllerManager::endAcmpCommand, this,
+			[this](la::avdecc::UniqueIdentifier const talkerEntityID, la::avdecc::entity::model::StreamIndex const talkerStreamIndex, la::avdecc::UniqueIdentifier const listenerEntityID, la::avdecc::entity::model::StreamIndex const listenerStreamIndex, AcmpCommandType const commandType, la::avdecc::entity::ControllerEntity::ControlStatus const /*status*/)
+			{
+				if (auto const id = _acmpProfilerIds.pop({ talkerEntityID, talkerStreamIndex, listenerEntityID, listenerStreamIndex, commandType }); id != 0u)
+				{
+					profiler::Profiler::getInstance().addAsyncEnd("acmp", profilerName(commandType), id);
+				}
+			},
+			Qt::DirectConnection);
 	}
 
 	~ControllerManagerImpl() noexcept
@@ -78,6 +228,53 @@ public:
 	}
 
 private:
+	struct AudioMappingsBatch
+	{
+		AudioMappingsBatch(std::size_t const commandsCount)
+			: remainingCommands{ commandsCount }
+		{
+		}
+
+		std::atomic<std::size_t> remainingCommands{ 0u };
+		std::atomic<la::avdecc::entity::ControllerEntity::AemCommandStatus> status{ la::avdecc::entity::ControllerEntity::AemCommandStatus::Success };
+	};
+
+	/** Splits the mappings in commands fitting in an AECP PDU. All commands are queued at once (the controller sends them in order) and a single endAecpCommand is emitted once all of them completed */
+	template<typename SendFunction>
+	void sendAudioMappings(la::avdecc::UniqueIdentifier const targetEntityID, AecpCommandType const commandType, la::avdecc::entity::model::AudioMappings const& mappings, SendFunction const& sendFunction) noexcept
+	{
+		if (mappings.empty())
+		{
+			return;
+		}
+
+		auto const commandsCount = (mappings.size() + MaxAudioMappingsPerCommand - 1u) / MaxAudioMappingsPerCommand;
+		auto batch = std::make_shared<AudioMappingsBatch>(commandsCount);
+
+		emit beginAecpCommand(targetEntityID, commandType);
+
+		for (auto offset = std::size_t{ 0u }; offset < mappings.size(); offset += MaxAudioMappingsPerCommand)
+		{
+			auto const last = std::min(mappings.size(), offset + MaxAudioMappingsPerCommand);
+			auto const chunk = la::avdecc::entity::model::AudioMappings(mappings.begin() + offset, mappings.begin() + last);
+
+			sendFunction(chunk, [this, targetEntityID, commandType, batch](la::avdecc::controller::ControlledEntity const* const /*entity*/, la::avdecc::entity::ControllerEntity::AemCommandStatus const status) noexcept
+			{
+				// Keep the first error
+				if (status != la::avdecc::entity::ControllerEntity::AemCommandStatus::Success)
+				{
+					auto expected = la::avdecc::entity::ControllerEntity::AemCommandStatus::Success;
+					batch->status.compare_exchange_strong(expected, status);
+				}
+
+				if (--batch->remainingCommands == 0u)
+				{
+					emit endAecpCommand(targetEntityID, commandType, batch->status.load());
+				}
+			});
+		}
+	}
+
 	// settings::SettingsManager::Observer overrides
 	virtual void onSettingChanged(settings::SettingsManager::Setting const& name, QVariant const& value) noexcept override
 	{
@@ -99,110 +296,146 @@ private:
 	// Global notifications
 	virtual void onTransportError(la::avdecc::controller::Controller const* const /*controller*/) noexcept override
 	{
+		PROFILER_SCOPE("controllerManager", "ControllerManager::onTransportError");
 		emit transportError();
 	}
 	virtual void onEntityQueryError(la::avdecc::controller::Controller const* const /*controller*/, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::controller::Controller::QueryCommandError const error) noexcept override
 	{
+		PROFILER_SCOPE("controllerManager", "ControllerManager::onEntityQueryError");
 		emit entityQueryError(entity->getEntity().getEntityID(), error);
 	}
 	// Discovery notifications (ADP)
 	virtual void onEntityOnline(la::avdecc::controller::Controller const* const /*controller*/, la::avdecc::controller::ControlledEntity const* const entity) noexcept override
 	{
-		emit entityOnline(entity->getEntity().getEntityID());
+		PROFILER_SCOPE("controllerManager", "ControllerManager::onEntityOnline");
+		auto const entityID = entity->getEntity().getEntityID();
+		{
+			auto const lg = std::lock_guard{ _onlineEntitiesLock };
+			_onlineEntities.insert(entityID);
+		}
+		emit entityOnline(entityID);
 	}
 	virtual void onEntityOffline(la::avdecc::controller::Controller const* const /*controller*/, la::avdecc::controller::ControlledEntity const* const entity) noexcept override
 	{
-		emit entityOffline(entity->getEntity().getEntityID());
+		PROFILER_SCOPE("controllerManager", "ControllerManager::onEntityOffline");
+		auto const entityID = entity->getEntity().getEntityID();
+		{
+			auto const lg = std::lock_guard{ _onlineEntitiesLock };
+			_onlineEntities.erase(entityID);
+		}
+		emit entityOffline(entityID);
 	}
 	virtual void onGptpChanged(la::avdecc::controller::Controller const* const /*controller*/, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::AvbInterfaceIndex const avbInterfaceIndex, la::avdecc::UniqueIdentifier const grandMasterID, std::uint8_t const grandMasterDomain) noexcept override
 	{
+		PROFILER_SCOPE("controllerManager", "ControllerManager::onGptpChanged");
 		auto const& e = entity->getEntity();
 		emit gptpChanged(e.getEntityID(), avbInterfaceIndex, grandMasterID, grandMasterDomain);
 	}
 	// Connection notifications (sniffed ACMP)
 	virtual void onStreamConnectionChanged(la::avdecc::controller::Controller const* const /*controller*/, la::avdecc::controller::model::StreamConnectionState const& state, bool const /*changedByOther*/) noexcept override
 	{
+		PROFILER_SCOPE("controllerManager", "ControllerManager::onStreamConnectionChanged");
 		emit streamConnectionChanged(state);
 	}
 	virtual void onStreamConnectionsChanged(la::avdecc::controller::Controller const* const /*controller*/, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::StreamIndex const streamIndex, la::avdecc::controller::model::StreamConnections const& connections) noexcept override
 	{
+		PROFILER_SCOPE("controllerManager", "ControllerManager::onStreamConnectionsChanged");
 		emit streamConnectionsChanged({entity->getEntity().getEntityID(), streamIndex}, connections);
 	}
 	// Entity model notifications (unsolicited AECP or changes this controller sent)
 	virtual void onAcquireStateChanged(la::avdecc::controller::Controller const* const /*controller*/, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::controller::model::AcquireState const acquireState, la::avdecc::UniqueIdentifier const owningEntity) noexcept override
 	{
+		PROFILER_SCOPE("controllerManager", "ControllerManager::onAcquireStateChanged");
 		emit acquireStateChanged(entity->getEntity().getEntityID(), acquireState, owningEntity);
 	}
 	virtual void onStreamInputFormatChanged(la::avdecc::controller::Controller const* const /*controller*/, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::StreamIndex const streamIndex, la::avdecc::entity::model::StreamFormat const streamFormat) noexcept override
 	{
+		PROFILER_SCOPE("controllerManager", "ControllerManager::onStreamInputFormatChanged");
 		emit streamFormatChanged(entity->getEntity().getEntityID(), la::avdecc::entity::model::DescriptorType::StreamInput, streamIndex, streamFormat);
 	}
 	virtual void onStreamOutputFormatChanged(la::avdecc::controller::Controller const* const /*controller*/, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::StreamIndex const streamIndex, la::avdecc::entity::model::StreamFormat const streamFormat) noexcept override
 	{
+		PROFILER_SCOPE("controllerManager", "ControllerManager::onStreamOutputFormatChanged");
 		emit streamFormatChanged(entity->getEntity().getEntityID(), la::avdecc::entity::model::DescriptorType::StreamOutput, streamIndex, streamFormat);
 	}
 	virtual void onStreamInputInfoChanged(la::avdecc::controller::Controller const* const /*controller*/, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::StreamIndex const streamIndex, la::avdecc::entity::model::StreamInfo const& info) noexcept override
 	{
+		PROFILER_SCOPE("controllerManager", "ControllerManager::onStreamInputInfoChanged");
 		emit streamInfoChanged(entity->getEntity().getEntityID(), la::avdecc::entity::model::DescriptorType::StreamInput, streamIndex, info);
 	}
 	virtual void onStreamOutputInfoChanged(la::avdecc::controller::Controller const* const /*controller*/, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::StreamIndex const streamIndex, la::avdecc::entity::model::StreamInfo const& info) noexcept override
 	{
+		PROFILER_SCOPE("controllerManager", "ControllerManager::onStreamOutputInfoChanged");
 		emit streamInfoChanged(entity->getEntity().getEntityID(), la::avdecc::entity::model::DescriptorType::StreamOutput, streamIndex, info);
 	}
 	virtual void onEntityNameChanged(la::avdecc::controller::Controller const* const /*controller*/, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::AvdeccFixedString const& entityName) noexcept override
 	{
+		PROFILER_SCOPE("controllerManager", "ControllerManager::onEntityNameChanged");
 		emit entityNameChanged(entity->getEntity().getEntityID(), QString::fromStdString(entityName));
 	}
 	virtual void onEntityGroupNameChanged(la::avdecc::controller::Controller const* const /*controller*/, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::AvdeccFixedString const& entityGroupName) noexcept override
 	{
+		PROFILER_SCOPE("controllerManager", "ControllerManager::onEntityGroupNameChanged");
 		emit entityGroupNameChanged(entity->getEntity().getEntityID(), QString::fromStdString(entityGroupName));
 	}
 	virtual void onConfigurationNameChanged(la::avdecc::controller::Controller const* const /*controller*/, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::AvdeccFixedString const& configurationName) noexcept override
 	{
+		PROFILER_SCOPE("controllerManager", "ControllerManager::onConfigurationNameChanged");
 		emit configurationNameChanged(entity->getEntity().getEntityID(), configurationIndex, QString::fromStdString(configurationName));
 	}
 	virtual void onStreamInputNameChanged(la::avdecc::controller::Controller const* const /*controller*/, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::StreamIndex const streamIndex, la::avdecc::entity::model::AvdeccFixedString const& streamName) noexcept override
 	{
+		PROFILER_SCOPE("controllerManager", "ControllerManager::onStreamInputNameChanged");
 		emit streamNameChanged(entity->getEntity().getEntityID(), configurationIndex, la::avdecc::entity::model::DescriptorType::StreamInput, streamIndex, QString::fromStdString(streamName));
 	}
 	virtual void onStreamOutputNameChanged(la::avdecc::controller::Controller const* const /*controller*/, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::StreamIndex const streamIndex, la::avdecc::entity::model::AvdeccFixedString const& streamName) noexcept override
 	{
+		PROFILER_SCOPE("controllerManager", "ControllerManager::onStreamOutputNameChanged");
 		emit streamNameChanged(entity->getEntity().getEntityID(), configurationIndex, la::avdecc::entity::model::DescriptorType::StreamOutput, streamIndex, QString::fromStdString(streamName));
 	}
 	virtual void onAudioUnitSamplingRateChanged(la::avdecc::controller::Controller const* const /*controller*/, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::AudioUnitIndex const audioUnitIndex, la::avdecc::entity::model::SamplingRate const samplingRate) noexcept override
 	{
+		PROFILER_SCOPE("controllerManager", "ControllerManager::onAudioUnitSamplingRateChanged");
 		emit audioUnitSamplingRateChanged(entity->getEntity().getEntityID(), audioUnitIndex, samplingRate);
 	}
 	virtual void onClockSourceChanged(la::avdecc::controller::Controller const* const /*controller*/, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::ClockDomainIndex const clockDomainIndex, la::avdecc::entity::model::ClockSourceIndex const clockSourceIndex) noexcept override
 	{
+		PROFILER_SCOPE("controllerManager", "ControllerManager::onClockSourceChanged");
 		emit clockSourceChanged(entity->getEntity().getEntityID(), clockDomainIndex, clockSourceIndex);
 	}
 	virtual void onStreamInputStarted(la::avdecc::controller::Controller const* const /*controller*/, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::StreamIndex const streamIndex) noexcept override
 	{
+		PROFILER_SCOPE("controllerManager", "ControllerManager::onStreamInputStarted");
 		emit streamRunningChanged(entity->getEntity().getEntityID(), la::avdecc::entity::model::DescriptorType::StreamInput, streamIndex, true);
 	}
 	virtual void onStreamOutputStarted(la::avdecc::controller::Controller const* const /*controller*/, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::StreamIndex const streamIndex) noexcept override
 	{
+		PROFILER_SCOPE("controllerManager", "ControllerManager::onStreamOutputStarted");
 		emit streamRunningChanged(entity->getEntity().getEntityID(), la::avdecc::entity::model::DescriptorType::StreamOutput, streamIndex, true);
 	}
 	virtual void onStreamInputStopped(la::avdecc::controller::Controller const* const /*controller*/, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::StreamIndex const streamIndex) noexcept override
 	{
+		PROFILER_SCOPE("controllerManager", "ControllerManager::onStreamInputStopped");
 		emit streamRunningChanged(entity->getEntity().getEntityID(), la::avdecc::entity::model::DescriptorType::StreamInput, streamIndex, false);
 	}
 	virtual void onStreamOutputStopped(la::avdecc::controller::Controller const* const /*controller*/, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::StreamIndex const streamIndex) noexcept override
 	{
+		PROFILER_SCOPE("controllerManager", "ControllerManager::onStreamOutputStopped");
 		emit streamRunningChanged(entity->getEntity().getEntityID(), la::avdecc::entity::model::DescriptorType::StreamOutput, streamIndex, false);
 	}
 	virtual void onAvbInfoChanged(la::avdecc::controller::Controller const* const /*controller*/, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::AvbInterfaceIndex const avbInterfaceIndex, la::avdecc::entity::model::AvbInfo const& info) noexcept override
 	{
+		PROFILER_SCOPE("controllerManager", "ControllerManager::onAvbInfoChanged");
 		emit avbInfoChanged(entity->getEntity().getEntityID(), avbInterfaceIndex, info);
 	}
 	virtual void onStreamPortInputAudioMappingsChanged(la::avdecc::controller::Controller const* const /*controller*/, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::StreamPortIndex const streamPortIndex) noexcept override
 	{
+		PROFILER_SCOPE("controllerManager", "ControllerManager::onStreamPortInputAudioMappingsChanged");
 		emit streamPortAudioMappingsChanged(entity->getEntity().getEntityID(), la::avdecc::entity::model::DescriptorType::StreamInput, streamPortIndex);
 	}
 	virtual void onStreamPortOutputAudioMappingsChanged(la::avdecc::controller::Controller const* const /*controller*/, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::StreamPortIndex const streamPortIndex) noexcept override
 	{
+		PROFILER_SCOPE("controllerManager", "ControllerManager::onStreamPortOutputAudioMappingsChanged");
 		emit streamPortAudioMappingsChanged(entity->getEntity().getEntityID(), la::avdecc::entity::model::DescriptorType::StreamOutput, streamPortIndex);
 	}
 
@@ -222,6 +455,11 @@ private:
 			std::atomic_store(&_controller, SharedController{ nullptr });
 #endif // HAVE_ATOMIC_SMART_POINTERS
 
+			{
+				auto const lg = std::lock_guard{ _onlineEntitiesLock };
+				_onlineEntities.clear();
+			}
+
 			emit controllerOffline();
 		}
 
@@ -267,6 +505,12 @@ private:
 		return {};
 	}
 
+	virtual std::vector<la::avdecc::UniqueIdentifier> getOnlineEntities() const noexcept override
+	{
+		auto const lg = std::lock_guard{ _onlineEntitiesLock };
+		return { _onlineEntities.begin(), _onlineEntities.end() };
+	}
+
 	/* Enumeration and Control Protocol (AECP) */
 	virtual void acquireEntity(la::avdecc::UniqueIdentifier const targetEntityID, bool const isPersistent) noexcept override
 	{
@@ -497,11 +741,9 @@ private:
 		auto controller = getController();
 		if (controller)
 		{
-			emit beginAecpCommand(targetEntityID, AecpCommandType::AddStreamPortAudioMappings);
-			controller->addStreamPortInputAudioMappings(targetEntityID, streamPortIndex, mappings, [this, targetEntityID](la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::ControllerEntity::AemCommandStatus const status) noexcept
+			sendAudioMappings(targetEntityID, AecpCommandType::AddStreamPortAudioMappings, mappings, [&controller, targetEntityID, streamPortIndex](la::avdecc::entity::model::AudioMappings const& chunk, auto const& handler)
 			{
-				//la::avdecc::Logger::getInstance().log(la::avdecc::Logger::Layer::FirstUserLayer, la::avdecc::Logger::Level::Trace, "addStreamPortInputAudioMappings: " + la::avdecc::entity::ControllerEntity::statusToString(status));
-				emit endAecpCommand(targetEntityID, AecpCommandType::AddStreamPortAudioMappings, status);
+				controller->addStreamPortInputAudioMappings(targetEntityID, streamPortIndex, chunk, handler);
 			});
 		}
 	}
@@ -511,11 +753,9 @@ private:
 		auto controller = getController();
 		if (controller)
 		{
-			emit beginAecpCommand(targetEntityID, AecpCommandType::AddStreamPortAudioMappings);
-			controller->addStreamPortOutputAudioMappings(targetEntityID, streamPortIndex, mappings, [this, targetEntityID](la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::ControllerEntity::AemCommandStatus const status) noexcept
+			sendAudioMappings(targetEntityID, AecpCommandType::AddStreamPortAudioMappings, mappings, [&controller, targetEntityID, streamPortIndex](la::avdecc::entity::model::AudioMappings const& chunk, auto const& handler)
 			{
-				//la::avdecc::Logger::getInstance().log(la::avdecc::Logger::Layer::FirstUserLayer, la::avdecc::Logger::Level::Trace, "addStreamPortOutputAudioMappings: " + la::avdecc::entity::ControllerEntity::statusToString(status));
-				emit endAecpCommand(targetEntityID, AecpCommandType::AddStreamPortAudioMappings, status);
+				controller->addStreamPortOutputAudioMappings(targetEntityID, streamPortIndex, chunk, handler);
 			});
 		}
 	}
@@ -525,11 +765,9 @@ private:
 		auto controller = getController();
 		if (controller)
 		{
-			emit beginAecpCommand(targetEntityID, AecpCommandType::RemoveStreamPortAudioMappings);
-			controller->removeStreamPortInputAudioMappings(targetEntityID, streamPortIndex, mappings, [this, targetEntityID](la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::ControllerEntity::AemCommandStatus const status) noexcept
+			sendAudioMappings(targetEntityID, AecpCommandType::RemoveStreamPortAudioMappings, mappings, [&controller, targetEntityID, streamPortIndex](la::avdecc::entity::model::AudioMappings const& chunk, auto const& handler)
 			{
-				//la::avdecc::Logger::getInstance().log(la::avdecc::Logger::Layer::FirstUserLayer, la::avdecc::Logger::Level::Trace, "removeStreamPortInputAudioMappings: " + la::avdecc::entity::ControllerEntity::statusToString(status));
-				emit endAecpCommand(targetEntityID, AecpCommandType::RemoveStreamPortAudioMappings, status);
+				controller->removeStreamPortInputAudioMappings(targetEntityID, streamPortIndex, chunk, handler);
 			});
 		}
 	}
@@ -539,11 +777,23 @@ private:
 		auto controller = getController();
 		if (controller)
 		{
-			emit beginAecpCommand(targetEntityID, AecpCommandType::RemoveStreamPortAudioMappings);
-			controller->removeStreamPortOutputAudioMappings(targetEntityID, streamPortIndex, mappings, [this, targetEntityID](la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::ControllerEntity::AemCommandStatus const status) noexcept
+			sendAudioMappings(targetEntityID, AecpCommandType::RemoveStreamPortAudioMappings, mappings, [&controller, targetEntityID, streamPortIndex](la::avdecc::entity::model::AudioMappings const& chunk, auto const& handler)
+			{
+				controller->removeStreamPortOutputAudioMappings(targetEntityID, streamPortIndex, chunk, handler);
+			});
+		}
+	}
+
+	virtual void setMemoryObjectLength(la::avdecc::UniqueIdentifier const targetEntityID, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::MemoryObjectIndex const memoryObjectIndex, std::uint64_t const length, la::avdecc::controller::Controller::SetMemoryObjectLengthHandler const& handler) noexcept override
+	{
+		auto controller = getController();
+		if (controller)
+		{
+			emit beginAecpCommand(targetEntityID, AecpCommandType::SetMemoryObjectLength);
+			controller->setMemoryObjectLength(targetEntityID, configurationIndex, memoryObjectIndex, length, [this, targetEntityID, handler](la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::ControllerEntity::AemCommandStatus const status) noexcept
 			{
-				//la::avdecc::Logger::getInstance().log(la::avdecc::Logger::Layer::FirstUserLayer, la::avdecc::Logger::Level::Trace, "removeStreamPortOutputAudioMappings: " + la::avdecc::entity::ControllerEntity::statusToString(status));
-				emit endAecpCommand(targetEntityID, AecpCommandType::RemoveStreamPortAudioMappings, status);
+				emit endAecpCommand(targetEntityID, AecpCommandType::SetMemoryObjectLength, status);
+				la::avdecc::invokeProtectedHandler(handler, entity, status);
 			});
 		}
 	}
@@ -649,6 +899,11 @@ private:
 #else // !HAVE_ATOMIC_SMART_POINTERS
 	SharedController _controller{ nullptr };
 #endif // HAVE_ATOMIC_SMART_POINTERS
+	mutable std::mutex _onlineEntitiesLock{};
+	std::set<la::avdecc::UniqueIdentifier> _onlineEntities{}; // Updated from the controller thread, before the entityOnline/entityOffline signals are emitted
+	std::atomic<std::uint64_t> _lastProfilerId{ 0u }; // Commands are only given a trace ID while the profiler is enabled
+	ProfilerIds<AecpProfilerKey> _aecpProfilerIds{};
+	ProfilerIds<AcmpProfilerKey> _acmpProfilerIds{};
 };
 
 QString ControllerManager::typeToString(AecpCommandType const type) noexcept
@@ -686,6 +941,8 @@ QString ControllerManager::typeToString(AecpCommandType const type) noexcept
 			return "Add Audio Mappings";
 		case AecpCommandType::RemoveStreamPortAudioMappings:
 			return "Remove Audio Mappings";
+		case AecpCommandType::SetMemoryObjectLength:
+			return "Set Memory Object Length";
 		default:
 			AVDECC_ASSERT(false, "Unhandled type");
 			return "Unknown";
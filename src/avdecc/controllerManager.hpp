@@ -21,6 +21,7 @@
 
 #include <la/avdecc/controller/avdeccController.hpp>
 #include <memory>
+#include <vector>
 #include <QObject>
 
 namespace avdecc
@@ -49,6 +50,7 @@ public:
 		StopStream,
 		AddStreamPortAudioMappings,
 		RemoveStreamPortAudioMappings,
+		SetMemoryObjectLength,
 	};
 
 	enum class AcmpCommandType
@@ -74,6 +76,9 @@ public:
 	/** Gets a ControlledEntity */
 	virtual la::avdecc::controller::ControlledEntityGuard getControlledEntity(la::avdecc::UniqueIdentifier const entityID) const noexcept = 0;
 
+	/** Gets the entities currently online (sorted), tracked by the manager itself so it does not depend on when the entityOnline signal is connected */
+	virtual std::vector<la::avdecc::UniqueIdentifier> getOnlineEntities() const noexcept = 0;
+
 	/* Enumeration and Control Protocol (AECP) */
 	virtual void acquireEntity(la::avdecc::UniqueIdentifier const targetEntityID, bool const isPersistent) noexcept = 0;
 	virtual void releaseEntity(la::avdecc::UniqueIdentifier const targetEntityID) noexcept = 0;
@@ -91,10 +96,15 @@ public:
 	virtual void stopStreamInput(la::avdecc::UniqueIdentifier const targetEntityID, la::avdecc::entity::model::StreamIndex const streamIndex) noexcept = 0;
 	virtual void startStreamOutput(la::avdecc::UniqueIdentifier const targetEntityID, la::avdecc::entity::model::StreamIndex const streamIndex) noexcept = 0;
 	virtual void stopStreamOutput(la::avdecc::UniqueIdentifier const targetEntityID, la::avdecc::entity::model::StreamIndex const streamIndex) noexcept = 0;
+	/** Maximum number of mappings in a single ADD/REMOVE_AUDIO_MAPPINGS command: 524 bytes of AEM control data, minus 12 bytes of AEM header and 8 bytes of command fields, 8 bytes per mapping (IEEE1722.1 7.4.44) */
+	static constexpr std::size_t MaxAudioMappingsPerCommand = 63;
+	/** Audio mappings are sent in as many commands as needed (see MaxAudioMappingsPerCommand), in order, with a single begin/endAecpCommand pair reporting the first error if any */
 	virtual void addStreamPortInputAudioMappings(la::avdecc::UniqueIdentifier const targetEntityID, la::avdecc::entity::model::StreamPortIndex const streamPortIndex, la::avdecc::entity::model::AudioMappings const& mappings) noexcept = 0;
 	virtual void addStreamPortOutputAudioMappings(la::avdecc::UniqueIdentifier const targetEntityID, la::avdecc::entity::model::StreamPortIndex const streamPortIndex, la::avdecc::entity::model::AudioMappings const& mappings) noexcept = 0;
 	virtual void removeStreamPortInputAudioMappings(la::avdecc::UniqueIdentifier const targetEntityID, la::avdecc::entity::model::StreamPortIndex const streamPortIndex, la::avdecc::entity::model::AudioMappings const& mappings) noexcept = 0;
 	virtual void removeStreamPortOutputAudioMappings(la::avdecc::UniqueIdentifier const targetEntityID, la::avdecc::entity::model::StreamPortIndex const streamPortIndex, la::avdecc::entity::model::AudioMappings const& mappings) noexcept = 0;
+	/** The handler is called in addition to the begin/endAecpCommand signals, from the controller thread */
+	virtual void setMemoryObjectLength(la::avdecc::UniqueIdentifier const targetEntityID, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::MemoryObjectIndex const memoryObjectIndex, std::uint64_t const length, la::avdecc::controller::Controller::SetMemoryObjectLengthHandler const& handler) noexcept = 0;
 
 	/* Enumeration and Control Protocol (AECP) AA */
 	virtual void readDeviceMemory(la::avdecc::UniqueIdentifier const targetEntityID, std::uint64_t const address, std::uint64_t const length, la::avdecc::controller::Controller::ReadDeviceMemoryHandler const& handler) const noexcept = 0;
@@ -26,21 +26,11 @@
 #include "settingsManager/settings.hpp"
 #include <algorithm>
 #include <array>
-
-enum class ControllerModelColumn
-{
-	EntityLogo,
-	EntityId,
-	Name,
-	Group,
-	AcquireState,
-	GrandmasterId,
-	GptpDomain,
-	InterfaceIndex,
-	AssociationId,
-
-	Count
-};
+#include <functional>
+#include <iterator>
+#include <unordered_map>
+#include <unordered_set>
+#include <QTimer>
 
 namespace avdecc
 {
@@ -60,6 +50,37 @@ public:
 	la::avdecc::UniqueIdentifier controlledEntityID(QModelIndex const& index) const;
 
 private:
+	enum class AcquireState
+	{
+		NotAcquired = 0,
+		Acquired = 1,
+		AcquiredByOther = 2,
+	};
+
+	/** Cached display data of an entity, refreshed only by change signals so data() never has to lock the entity */
+	struct EntityData
+	{
+		la::avdecc::UniqueIdentifier entityID{};
+		bool aemSupported{ false };
+		QString entityIDString{};
+		QString name{};
+		QString group{};
+		QString grandmasterID{};
+		std::uint8_t gptpDomain{ 0u };
+		QVariant interfaceIndex{};
+		QString associationID{};
+		AcquireState acquireState{ AcquireState::NotAcquired };
+		EntityLogoCache::Key logoKey{};
+	};
+
+	static EntityData buildEntityData(la::avdecc::controller::ControlledEntity const& controlledEntity) noexcept;
+	static void refreshGptpData(EntityData& data, la::avdecc::controller::ControlledEntity const& controlledEntity) noexcept;
+	static AcquireState computeAcquireState(la::avdecc::controller::ControlledEntity const& controlledEntity) noexcept;
+	EntityData* entityData(la::avdecc::UniqueIdentifier const entityID) noexcept;
+	void rebuildEntityRowMap(std::size_t const fromRow) noexcept;
+	void scheduleChurnFlush() noexcept;
+	Q_SLOT void flushPendingChanges();
+
 	int entityRow(la::avdecc::UniqueIdentifier const entityID) const;
 	QModelIndex createIndex(la::avdecc::UniqueIdentifier const entityID, ControllerModelColumn column) const;
 	void dataChanged(la::avdecc::UniqueIdentifier const entityID, ControllerModelColumn column, QVector<int> const &roles = {Qt::DisplayRole});
@@ -84,8 +105,18 @@ private:
 	ControllerModel * const q_ptr{ nullptr };
 	Q_DECLARE_PUBLIC(ControllerModel);
 
-	using Entities = std::vector<la::avdecc::UniqueIdentifier>;
+	using Entities = std::vector<EntityData>;
+	using EntityRowMap = std::unordered_map<la::avdecc::UniqueIdentifier, int, la::avdecc::UniqueIdentifier::hash>;
 	Entities _entities{};
+	EntityRowMap _entityRowMap{};
+
+	// Entity online/offline churn is coalesced over a short window and applied as bulk inserts/removes
+	static constexpr int ChurnCoalescingDelay = 100; // msec
+	using EntitySet = std::unordered_set<la::avdecc::UniqueIdentifier, la::avdecc::UniqueIdentifier::hash>;
+	std::vector<la::avdecc::UniqueIdentifier> _pendingOnline{}; // Keep arrival order
+	EntitySet _pendingOnlineSet{};
+	EntitySet _pendingOffline{};
+	QTimer _churnTimer{ this };
 	
 	std::array<QImage, 3> _acquireStateImages
 	{
@@ -116,15 +147,19 @@ ControllerModelPrivate::ControllerModelPrivate(ControllerModel* model)
 	
 	auto& logoCache = EntityLogoCache::getInstance();
 	connect(&logoCache, &EntityLogoCache::imageChanged, this, &ControllerModelPrivate::imageChanged);
+
+	_churnTimer.setSingleShot(true);
+	_churnTimer.setInterval(ChurnCoalescingDelay);
+	connect(&_churnTimer, &QTimer::timeout, this, &ControllerModelPrivate::flushPendingChanges);
 	
 	auto& settings = settings::SettingsManager::getInstance();
-	settings.registerSettingObserver(settings::AemCacheEnabled.name, this);
+	settings.registerSettingObserver(settings::AutomaticPNGDownloadEnabled.name, this);
 }
 
 ControllerModelPrivate::~ControllerModelPrivate()
 {
 	auto& settings = settings::SettingsManager::getInstance();
-	settings.unregisterSettingObserver(settings::AemCacheEnabled.name, this);
+	settings.unregisterSettingObserver(settings::AutomaticPNGDownloadEnabled.name, this);
 }
 
 int ControllerModelPrivate::rowCount() const
@@ -139,35 +174,27 @@ int ControllerModelPrivate::columnCount() const
 
 QVariant ControllerModelPrivate::data(QModelIndex const& index, int role) const
 {
-	auto const entityID = _entities.at(index.row());
-	auto& manager = avdecc::ControllerManager::getInstance();
-	auto controlledEntity = manager.getControlledEntity(entityID);
-
-	if (!controlledEntity)
-		return {};
-
+	auto const& data = _entities.at(index.row());
 	auto const column = static_cast<ControllerModelColumn>(index.column());
 
 	if (role == Qt::DisplayRole)
 	{
-		auto const& entity = controlledEntity->getEntity();
-
 		switch (column)
 		{
 			case ControllerModelColumn::EntityId:
-				return helper::uniqueIdentifierToString(entityID);
+				return data.entityIDString;
 			case ControllerModelColumn::Name:
-				return helper::entityName(*controlledEntity);
+				return data.name;
 			case ControllerModelColumn::Group:
-				return helper::groupName(*controlledEntity);
+				return data.group;
 			case ControllerModelColumn::GrandmasterId:
-				return helper::uniqueIdentifierToString(entity.getGptpGrandmasterID());
+				return data.grandmasterID;
 			case ControllerModelColumn::GptpDomain:
-				return entity.getGptpDomainNumber();
+				return data.gptpDomain;
 			case ControllerModelColumn::InterfaceIndex:
-				return entity.getInterfaceIndex();
+				return data.interfaceIndex;
 			case ControllerModelColumn::AssociationId:
-				return helper::uniqueIdentifierToString(entity.getAssociationID());
+				return data.associationID;
 			default:
 				break;
 		}
@@ -176,14 +203,10 @@ QVariant ControllerModelPrivate::data(QModelIndex const& index, int role) const
 	{
 		if (role == Qt::UserRole)
 		{
-			auto const& entity = controlledEntity->getEntity();
-			if (la::avdecc::hasFlag(entity.getEntityCapabilities(), la::avdecc::entity::EntityCapabilities::AemSupported))
+			if (data.aemSupported)
 			{
-				auto& settings = settings::SettingsManager::getInstance();
-				auto const& forceDownload{ settings.getValue(settings::AutomaticPNGDownloadEnabled.name).toBool() };
-
 				auto& logoCache = EntityLogoCache::getInstance();
-				return logoCache.getImage(entityID, EntityLogoCache::Type::Entity, forceDownload);
+				return logoCache.getImage(data.entityID, data.logoKey, EntityLogoCache::Type::Entity, settings::AutomaticPNGDownloadEnabled.get());
 			}
 		}
 	}
@@ -192,9 +215,17 @@ QVariant ControllerModelPrivate::data(QModelIndex const& index, int role) const
 		switch (role)
 		{
 			case Qt::UserRole:
-				return _acquireStateImages[controlledEntity->isAcquiredByOther() ? 2 : (controlledEntity->isAcquired() ? 1 : 0)];
+				return _acquireStateImages[la::avdecc::to_integral(data.acquireState)];
 			case Qt::ToolTipRole:
-				return controlledEntity->isAcquiredByOther() ? "Acquired by another controller" : (controlledEntity->isAcquired() ? "Acquired" : "Not acquired");
+				switch (data.acquireState)
+				{
+					case AcquireState::AcquiredByOther:
+						return "Acquired by another controller";
+					case AcquireState::Acquired:
+						return "Acquired";
+					default:
+						return "Not acquired";
+				}
 			default:
 				break;
 		}
@@ -238,19 +269,76 @@ la::avdecc::UniqueIdentifier ControllerModelPrivate::controlledEntityID(QModelIn
 {
 	if (index.isValid())
 	{
-		return _entities.at(index.row());
+		return _entities.at(index.row()).entityID;
 	}
 	return la::avdecc::UniqueIdentifier{};
 }
 
+ControllerModelPrivate::EntityData ControllerModelPrivate::buildEntityData(la::avdecc::controller::ControlledEntity const& controlledEntity) noexcept
+{
+	auto const& entity = controlledEntity.getEntity();
+
+	auto data = EntityData{};
+	data.entityID = entity.getEntityID();
+	data.aemSupported = la::avdecc::hasFlag(entity.getEntityCapabilities(), la::avdecc::entity::EntityCapabilities::AemSupported);
+	data.entityIDString = helper::uniqueIdentifierToString(data.entityID);
+	data.name = helper::entityName(controlledEntity);
+	data.group = helper::groupName(controlledEntity);
+	data.interfaceIndex = entity.getInterfaceIndex();
+	data.associationID = helper::uniqueIdentifierToString(entity.getAssociationID());
+	data.acquireState = computeAcquireState(controlledEntity);
+	data.logoKey = EntityLogoCache::makeKey(controlledEntity);
+	refreshGptpData(data, controlledEntity);
+
+	return data;
+}
+
+void ControllerModelPrivate::refreshGptpData(EntityData& data, la::avdecc::controller::ControlledEntity const& controlledEntity) noexcept
+{
+	auto const& entity = controlledEntity.getEntity();
+	data.grandmasterID = helper::uniqueIdentifierToString(entity.getGptpGrandmasterID());
+	data.gptpDomain = entity.getGptpDomainNumber();
+}
+
+ControllerModelPrivate::AcquireState ControllerModelPrivate::computeAcquireState(la::avdecc::controller::ControlledEntity const& controlledEntity) noexcept
+{
+	if (controlledEntity.isAcquiredByOther())
+	{
+		return AcquireState::AcquiredByOther;
+	}
+	if (controlledEntity.isAcquired())
+	{
+		return AcquireState::Acquired;
+	}
+	return AcquireState::NotAcquired;
+}
+
+ControllerModelPrivate::EntityData* ControllerModelPrivate::entityData(la::avdecc::UniqueIdentifier const entityID) noexcept
+{
+	auto const row = entityRow(entityID);
+	if (row == -1)
+	{
+		return nullptr;
+	}
+	return &_entities[row];
+}
+
+void ControllerModelPrivate::rebuildEntityRowMap(std::size_t const fromRow) noexcept
+{
+	for (auto row = fromRow; row < _entities.size(); ++row)
+	{
+		_entityRowMap[_entities[row].entityID] = static_cast<int>(row);
+	}
+}
+
 int ControllerModelPrivate::entityRow(la::avdecc::UniqueIdentifier const entityID) const
 {
-	auto const it = std::find(_entities.begin(), _entities.end(), entityID);
-	if (it == _entities.end())
+	auto const it = _entityRowMap.find(entityID);
+	if (it == _entityRowMap.end())
 	{
 		return -1;
 	}
-	return static_cast<int>(std::distance(_entities.begin(), it));
+	return it->second;
 }
 
 QModelIndex ControllerModelPrivate::createIndex(la::avdecc::UniqueIdentifier const entityID, ControllerModelColumn column) const
@@ -269,65 +357,188 @@ void ControllerModelPrivate::dataChanged(la::avdecc::UniqueIdentifier const enti
 	}
 }
 
+void ControllerModelPrivate::scheduleChurnFlush() noexcept
+{
+	// Don't restart an already running timer, so a continuous churn is still flushed at regular interval
+	if (!_churnTimer.isActive())
+	{
+		_churnTimer.start();
+	}
+}
+
+void ControllerModelPrivate::flushPendingChanges()
+{
+	Q_Q(ControllerModel);
+
+	// Bulk remove, by contiguous ranges starting from the end so rows of pending ranges are not shifted
+	if (!_pendingOffline.empty())
+	{
+		auto rows = std::vector<int>{};
+		rows.reserve(_pendingOffline.size());
+		for (auto const& entityID : _pendingOffline)
+		{
+			auto const row = entityRow(entityID);
+			if (row != -1)
+			{
+				rows.push_back(row);
+			}
+			_entityRowMap.erase(entityID);
+		}
+		_pendingOffline.clear();
+
+		std::sort(rows.begin(), rows.end(), std::greater<int>{});
+
+		auto it = rows.begin();
+		while (it != rows.end())
+		{
+			auto const last = *it;
+			auto first = last;
+			while (++it != rows.end() && *it == first - 1)
+			{
+				first = *it;
+			}
+
+			q->beginRemoveRows({}, first, last);
+			_entities.erase(_entities.begin() + first, _entities.begin() + last + 1);
+			q->endRemoveRows();
+		}
+
+		if (!rows.empty())
+		{
+			rebuildEntityRowMap(static_cast<std::size_t>(rows.back()));
+		}
+	}
+
+	// Bulk insert at the end of the list
+	if (!_pendingOnline.empty())
+	{
+		auto& manager = avdecc::ControllerManager::getInstance();
+		auto newEntities = Entities{};
+		newEntities.reserve(_pendingOnline.size());
+		for (auto const& entityID : _pendingOnline)
+		{
+			auto controlledEntity = manager.getControlledEntity(entityID);
+			if (controlledEntity && entityRow(entityID) == -1)
+			{
+				newEntities.emplace_back(buildEntityData(*controlledEntity));
+			}
+		}
+		_pendingOnline.clear();
+		_pendingOnlineSet.clear();
+
+		if (!newEntities.empty())
+		{
+			auto const first = static_cast<int>(_entities.size());
+			auto const last = first + static_cast<int>(newEntities.size()) - 1;
+
+			q->beginInsertRows({}, first, last);
+			std::move(newEntities.begin(), newEntities.end(), std::back_inserter(_entities));
+			rebuildEntityRowMap(static_cast<std::size_t>(first));
+			q->endInsertRows();
+		}
+	}
+}
+
 void ControllerModelPrivate::controllerOffline()
 {
 	Q_Q(ControllerModel);
 
+	_churnTimer.stop();
+	_pendingOnline.clear();
+	_pendingOnlineSet.clear();
+	_pendingOffline.clear();
+
 	q->beginResetModel();
 	_entities.clear();
+	_entityRowMap.clear();
 	q->endResetModel();
 }
 
 void ControllerModelPrivate::entityOnline(la::avdecc::UniqueIdentifier const entityID)
 {
-	auto& manager = avdecc::ControllerManager::getInstance();
-	auto controlledEntity = manager.getControlledEntity(entityID);
-	if (controlledEntity)
+	// Entity went offline then online again during the coalescing window: cancel the removal, but refresh its data
+	if (_pendingOffline.erase(entityID) != 0)
 	{
-		Q_Q(ControllerModel);
-
-		auto const row = static_cast<int>(_entities.size());
+		auto& manager = avdecc::ControllerManager::getInstance();
+		auto controlledEntity = manager.getControlledEntity(entityID);
+		auto const row = entityRow(entityID);
+		if (controlledEntity && row != -1)
+		{
+			Q_Q(ControllerModel);
+			_entities[row] = buildEntityData(*controlledEntity);
+			emit q->dataChanged(q->createIndex(row, 0), q->createIndex(row, columnCount() - 1));
+		}
+		return;
+	}
 
-		emit q->beginInsertRows({}, row, row);
-		_entities.emplace_back(entityID);
-		emit q->endInsertRows();
+	if (entityRow(entityID) == -1 && _pendingOnlineSet.insert(entityID).second)
+	{
+		_pendingOnline.push_back(entityID);
+		scheduleChurnFlush();
 	}
 }
 
 void ControllerModelPrivate::entityOffline(la::avdecc::UniqueIdentifier const entityID)
 {
-	auto const it = std::find(_entities.begin(), _entities.end(), entityID);
-	if (it != _entities.end())
+	// Entity went online then offline during the coalescing window: cancel the insertion
+	if (_pendingOnlineSet.erase(entityID) != 0)
 	{
-		Q_Q(ControllerModel);
-
-		auto const row = static_cast<int>(std::distance(_entities.begin(), it));
+		_pendingOnline.erase(std::remove(_pendingOnline.begin(), _pendingOnline.end(), entityID), _pendingOnline.end());
+		return;
+	}
 
-		emit q->beginRemoveRows({}, row, row);
-		_entities.erase(it);
-		emit q->endRemoveRows();
+	if (entityRow(entityID) != -1)
+	{
+		_pendingOffline.insert(entityID);
+		scheduleChurnFlush();
 	}
 }
 
 void ControllerModelPrivate::entityNameChanged(la::avdecc::UniqueIdentifier const entityID, QString const& entityName)
 {
-	dataChanged(entityID, ControllerModelColumn::Name);
+	if (auto* data = entityData(entityID))
+	{
+		data->name = entityName;
+		dataChanged(entityID, ControllerModelColumn::Name);
+	}
 }
 
 void ControllerModelPrivate::entityGroupNameChanged(la::avdecc::UniqueIdentifier const entityID, QString const& entityGroupName)
 {
-	dataChanged(entityID, ControllerModelColumn::Group);
+	if (auto* data = entityData(entityID))
+	{
+		data->group = entityGroupName;
+		dataChanged(entityID, ControllerModelColumn::Group);
+	}
 }
 
 void ControllerModelPrivate::acquireStateChanged(la::avdecc::UniqueIdentifier const entityID, la::avdecc::controller::model::AcquireState const acquireState, la::avdecc::UniqueIdentifier const owningEntity)
 {
-	dataChanged(entityID, ControllerModelColumn::AcquireState, {Qt::UserRole});
+	if (auto* data = entityData(entityID))
+	{
+		auto& manager = avdecc::ControllerManager::getInstance();
+		auto controlledEntity = manager.getControlledEntity(entityID);
+		if (controlledEntity)
+		{
+			data->acquireState = computeAcquireState(*controlledEntity);
+			dataChanged(entityID, ControllerModelColumn::AcquireState, { Qt::UserRole, Qt::ToolTipRole });
+		}
+	}
 }
 
 void ControllerModelPrivate::gptpChanged(la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::AvbInterfaceIndex const avbInterfaceIndex, la::avdecc::UniqueIdentifier const grandMasterID, std::uint8_t const grandMasterDomain)
 {
-	dataChanged(entityID, ControllerModelColumn::GrandmasterId);
-	dataChanged(entityID, ControllerModelColumn::GptpDomain);
+	if (auto* data = entityData(entityID))
+	{
+		auto& manager = avdecc::ControllerManager::getInstance();
+		auto controlledEntity = manager.getControlledEntity(entityID);
+		if (controlledEntity)
+		{
+			refreshGptpData(*data, *controlledEntity);
+			dataChanged(entityID, ControllerModelColumn::GrandmasterId);
+			dataChanged(entityID, ControllerModelColumn::GptpDomain);
+		}
+	}
 }
 
 void ControllerModelPrivate::imageChanged(la::avdecc::UniqueIdentifier const entityID, EntityLogoCache::Type const type)
@@ -342,13 +553,13 @@ void ControllerModelPrivate::onSettingChanged(settings::SettingsManager::Setting
 {
 	if (name == settings::AutomaticPNGDownloadEnabled.name)
 	{
-		if (value.toBool())
+		if (value.toBool() && !_entities.empty())
 		{
 			Q_Q(ControllerModel);
 			auto const column{la::avdecc::to_integral(ControllerModelColumn::EntityLogo)};
 			
 			auto const top{q->createIndex(0, column, nullptr)};
-			auto const bottom{q->createIndex(rowCount(), column, nullptr)};
+			auto const bottom{q->createIndex(rowCount() - 1, column, nullptr)};
 			
 			emit q->dataChanged(top, bottom, {Qt::UserRole});
 		}
@@ -24,6 +24,21 @@
 
 namespace avdecc
 {
+enum class ControllerModelColumn
+{
+	EntityLogo,
+	EntityId,
+	Name,
+	Group,
+	AcquireState,
+	GrandmasterId,
+	GptpDomain,
+	InterfaceIndex,
+	AssociationId,
+
+	Count
+};
+
 class ControllerModelPrivate;
 class ControllerModel : public QAbstractTableModel
 {
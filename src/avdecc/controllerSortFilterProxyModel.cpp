@@ -0,0 +1,664 @@
+/*
+* Copyright 2017-2018, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be usefu_state,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "controllerSortFilterProxyModel.hpp"
+#include <la/avdecc/utils.hpp>
+#include <algorithm>
+#include <functional>
+#include <vector>
+
+namespace avdecc
+{
+class ControllerSortFilterProxyModelPrivate : public QObject
+{
+	Q_OBJECT
+public:
+	ControllerSortFilterProxyModelPrivate(ControllerSortFilterProxyModel* q, ControllerModel* model);
+
+	int rowCount() const;
+	int sourceRow(int const proxyRow) const;
+	int proxyRow(int const sourceRow) const;
+
+	void setFilterText(QString const& text);
+	QString filterText() const;
+	void sort(int const column, Qt::SortOrder const order);
+
+private:
+	/** Cached keys of a source row, computed once per change instead of on each comparison */
+	struct RowKey
+	{
+		QString sortKey{}; // Lowercase display value of the sort column
+		QString filterKey{}; // Lowercase entity name and ID
+		std::uint64_t entityID{ 0u };
+	};
+
+	RowKey buildKey(int const sourceRow) const noexcept;
+	bool isAccepted(RowKey const& key) const noexcept;
+	bool lessThan(int const lhsSourceRow, int const rhsSourceRow) const noexcept;
+	int insertionPosition(int const sourceRow) const noexcept;
+	void updateSourceToProxy(int const fromProxyRow) noexcept;
+	void rebuild() noexcept;
+
+	/** Inserts the specified (not yet mapped) source rows, grouped in contiguous blocks */
+	void insertSourceRows(std::vector<int> sourceRows) noexcept;
+	/** Removes the specified proxy rows, grouped in contiguous blocks */
+	void removeProxyRows(std::vector<int> proxyRows) noexcept;
+	/** Moves a single row to its new sorted position, after its sort key changed */
+	void repositionSourceRow(int const sourceRow) noexcept;
+
+	// Slots for source model signals
+	Q_SLOT void sourceRowsInserted(QModelIndex const& parent, int first, int last);
+	Q_SLOT void sourceRowsAboutToBeRemoved(QModelIndex const& parent, int first, int last);
+	Q_SLOT void sourceRowsRemoved(QModelIndex const& parent, int first, int last);
+	Q_SLOT void sourceDataChanged(QModelIndex const& topLeft, QModelIndex const& bottomRight, QVector<int> const& roles);
+	Q_SLOT void sourceModelAboutToBeReset();
+	Q_SLOT void sourceModelReset();
+
+private:
+	ControllerSortFilterProxyModel * const q_ptr{ nullptr };
+	Q_DECLARE_PUBLIC(ControllerSortFilterProxyModel);
+
+	ControllerModel* _model{ nullptr };
+	std::vector<RowKey> _keys{}; // Indexed by source row
+	std::vector<int> _proxyToSource{};
+	std::vector<int> _sourceToProxy{}; // -1 if the source row is filtered out
+	int _sortColumn{ -1 }; // -1 to keep source order
+	Qt::SortOrder _sortOrder{ Qt::AscendingOrder };
+	QString _filterText{}; // Lowercase
+};
+
+//////////////////////////////////////
+
+ControllerSortFilterProxyModelPrivate::ControllerSortFilterProxyModelPrivate(ControllerSortFilterProxyModel* q, ControllerModel* model)
+	: q_ptr(q)
+	, _model(model)
+{
+	connect(_model, &QAbstractItemModel::rowsInserted, this, &ControllerSortFilterProxyModelPrivate::sourceRowsInserted);
+	connect(_model, &QAbstractItemModel::rowsAboutToBeRemoved, this, &ControllerSortFilterProxyModelPrivate::sourceRowsAboutToBeRemoved);
+	connect(_model, &QAbstractItemModel::rowsRemoved, this, &ControllerSortFilterProxyModelPrivate::sourceRowsRemoved);
+	connect(_model, &QAbstractItemModel::dataChanged, this, &ControllerSortFilterProxyModelPrivate::sourceDataChanged);
+	connect(_model, &QAbstractItemModel::modelAboutToBeReset, this, &ControllerSortFilterProxyModelPrivate::sourceModelAboutToBeReset);
+	connect(_model, &QAbstractItemModel::modelReset, this, &ControllerSortFilterProxyModelPrivate::sourceModelReset);
+	// ControllerModel never reorders its rows, but be safe
+	connect(_model, &QAbstractItemModel::layoutAboutToBeChanged, this, &ControllerSortFilterProxyModelPrivate::sourceModelAboutToBeReset);
+	connect(_model, &QAbstractItemModel::layoutChanged, this, &ControllerSortFilterProxyModelPrivate::sourceModelReset);
+
+	rebuild();
+}
+
+int ControllerSortFilterProxyModelPrivate::rowCount() const
+{
+	return static_cast<int>(_proxyToSource.size());
+}
+
+int ControllerSortFilterProxyModelPrivate::sourceRow(int const proxyRow) const
+{
+	if (proxyRow < 0 || proxyRow >= static_cast<int>(_proxyToSource.size()))
+	{
+		return -1;
+	}
+	return _proxyToSource[proxyRow];
+}
+
+int ControllerSortFilterProxyModelPrivate::proxyRow(int const sourceRow) const
+{
+	if (sourceRow < 0 || sourceRow >= static_cast<int>(_sourceToProxy.size()))
+	{
+		return -1;
+	}
+	return _sourceToProxy[sourceRow];
+}
+
+void ControllerSortFilterProxyModelPrivate::setFilterText(QString const& text)
+{
+	auto const filterText = text.trimmed().toLower();
+	if (filterText == _filterText)
+	{
+		return;
+	}
+
+	// A more specific filter can only hide rows, no need to check the ones already filtered out
+	auto const isNarrowing = filterText.contains(_filterText);
+	_filterText = filterText;
+
+	auto toRemove = std::vector<int>{};
+	for (auto row = 0; row < static_cast<int>(_proxyToSource.size()); ++row)
+	{
+		if (!isAccepted(_keys[_proxyToSource[row]]))
+		{
+			toRemove.push_back(row);
+		}
+	}
+	removeProxyRows(std::move(toRemove));
+
+	if (!isNarrowing)
+	{
+		auto toInsert = std::vector<int>{};
+		for (auto row = 0; row < static_cast<int>(_keys.size()); ++row)
+		{
+			if (_sourceToProxy[row] == -1 && isAccepted(_keys[row]))
+			{
+				toInsert.push_back(row);
+			}
+		}
+		insertSourceRows(std::move(toInsert));
+	}
+}
+
+QString ControllerSortFilterProxyModelPrivate::filterText() const
+{
+	return _filterText;
+}
+
+void ControllerSortFilterProxyModelPrivate::sort(int const column, Qt::SortOrder const order)
+{
+	if (column == _sortColumn && order == _sortOrder)
+	{
+		return;
+	}
+
+	Q_Q(ControllerSortFilterProxyModel);
+
+	emit q->layoutAboutToBeChanged({}, QAbstractItemModel::VerticalSortHint);
+
+	// Save persistent indexes as source rows
+	auto const persistentIndexes = q->persistentIndexList();
+	auto persistentSourceRows = std::vector<int>{};
+	persistentSourceRows.reserve(persistentIndexes.size());
+	for (auto const& index : persistentIndexes)
+	{
+		persistentSourceRows.push_back(sourceRow(index.row()));
+	}
+
+	_sortColumn = column;
+	_sortOrder = order;
+
+	for (auto row = 0; row < static_cast<int>(_keys.size()); ++row)
+	{
+		_keys[row] = buildKey(row);
+	}
+	std::sort(_proxyToSource.begin(), _proxyToSource.end(), [this](int const lhs, int const rhs)
+	{
+		return lessThan(lhs, rhs);
+	});
+	updateSourceToProxy(0);
+
+	// Restore persistent indexes
+	for (auto i = 0; i < persistentIndexes.size(); ++i)
+	{
+		auto const& index = persistentIndexes[i];
+		q->changePersistentIndex(index, q->index(proxyRow(persistentSourceRows[i]), index.column()));
+	}
+
+	emit q->layoutChanged({}, QAbstractItemModel::VerticalSortHint);
+}
+
+ControllerSortFilterProxyModelPrivate::RowKey ControllerSortFilterProxyModelPrivate::buildKey(int const sourceRow) const noexcept
+{
+	auto key = RowKey{};
+
+	auto const entityIDString = _model->data(_model->index(sourceRow, la::avdecc::to_integral(ControllerModelColumn::EntityId))).toString().toLower();
+	auto const name = _model->data(_model->index(sourceRow, la::avdecc::to_integral(ControllerModelColumn::Name))).toString().toLower();
+
+	key.filterKey = name + QChar('\n') + entityIDString;
+	key.entityID = _model->controlledEntityID(_model->index(sourceRow, 0)).getValue();
+	if (_sortColumn >= 0)
+	{
+		key.sortKey = _model->data(_model->index(sourceRow, _sortColumn)).toString().toLower();
+	}
+
+	return key;
+}
+
+bool ControllerSortFilterProxyModelPrivate::isAccepted(RowKey const& key) const noexcept
+{
+	return _filterText.isEmpty() || key.filterKey.contains(_filterText);
+}
+
+bool ControllerSortFilterProxyModelPrivate::lessThan(int const lhsSourceRow, int const rhsSourceRow) const noexcept
+{
+	// Keep source order
+	if (_sortColumn < 0)
+	{
+		return lhsSourceRow < rhsSourceRow;
+	}
+
+	auto const& lhs = _keys[lhsSourceRow];
+	auto const& rhs = _keys[rhsSourceRow];
+
+	auto const compare = [](RowKey const& a, RowKey const& b)
+	{
+		auto const result = a.sortKey.compare(b.sortKey);
+		if (result != 0)
+		{
+			return result < 0;
+		}
+		// Equal keys, use EntityID so the order is stable whatever the insertion order
+		return a.entityID < b.entityID;
+	};
+
+	return _sortOrder == Qt::AscendingOrder ? compare(lhs, rhs) : compare(rhs, lhs);
+}
+
+int ControllerSortFilterProxyModelPrivate::insertionPosition(int const sourceRow) const noexcept
+{
+	auto const it = std::lower_bound(_proxyToSource.begin(), _proxyToSource.end(), sourceRow, [this](int const lhs, int const rhs)
+	{
+		return lessThan(lhs, rhs);
+	});
+	return static_cast<int>(std::distance(_proxyToSource.begin(), it));
+}
+
+void ControllerSortFilterProxyModelPrivate::updateSourceToProxy(int const fromProxyRow) noexcept
+{
+	for (auto row = fromProxyRow; row < static_cast<int>(_proxyToSource.size()); ++row)
+	{
+		_sourceToProxy[_proxyToSource[row]] = row;
+	}
+}
+
+void ControllerSortFilterProxyModelPrivate::rebuild() noexcept
+{
+	auto const count = _model->rowCount();
+
+	_keys.clear();
+	_keys.reserve(count);
+	_proxyToSource.clear();
+	_sourceToProxy.assign(count, -1);
+
+	for (auto row = 0; row < count; ++row)
+	{
+		_keys.push_back(buildKey(row));
+		if (isAccepted(_keys.back()))
+		{
+			_proxyToSource.push_back(row);
+		}
+	}
+
+	std::sort(_proxyToSource.begin(), _proxyToSource.end(), [this](int const lhs, int const rhs)
+	{
+		return lessThan(lhs, rhs);
+	});
+	updateSourceToProxy(0);
+}
+
+void ControllerSortFilterProxyModelPrivate::insertSourceRows(std::vector<int> sourceRows) noexcept
+{
+	if (sourceRows.empty())
+	{
+		return;
+	}
+
+	Q_Q(ControllerSortFilterProxyModel);
+
+	std::sort(sourceRows.begin(), sourceRows.end(), [this](int const lhs, int const rhs)
+	{
+		return lessThan(lhs, rhs);
+	});
+
+	// Sorted rows landing between the same two existing rows are inserted as a single block
+	auto it = sourceRows.begin();
+	while (it != sourceRows.end())
+	{
+		auto const position = insertionPosition(*it);
+		auto blockEnd = std::next(it);
+		while (blockEnd != sourceRows.end() && insertionPosition(*blockEnd) == position)
+		{
+			++blockEnd;
+		}
+
+		auto const count = static_cast<int>(std::distance(it, blockEnd));
+		q->beginInsertRows({}, position, position + count - 1);
+		_proxyToSource.insert(_proxyToSource.begin() + position, it, blockEnd);
+		updateSourceToProxy(position);
+		q->endInsertRows();
+
+		it = blockEnd;
+	}
+}
+
+void ControllerSortFilterProxyModelPrivate::removeProxyRows(std::vector<int> proxyRows) noexcept
+{
+	if (proxyRows.empty())
+	{
+		return;
+	}
+
+	Q_Q(ControllerSortFilterProxyModel);
+
+	// Remove contiguous ranges starting from the end, so rows of pending ranges are not shifted
+	std::sort(proxyRows.begin(), proxyRows.end(), std::greater<int>{});
+
+	auto it = proxyRows.begin();
+	while (it != proxyRows.end())
+	{
+		auto const last = *it;
+		auto first = last;
+		while (++it != proxyRows.end() && *it == first - 1)
+		{
+			first = *it;
+		}
+
+		q->beginRemoveRows({}, first, last);
+		for (auto row = first; row <= last; ++row)
+		{
+			_sourceToProxy[_proxyToSource[row]] = -1;
+		}
+		_proxyToSource.erase(_proxyToSource.begin() + first, _proxyToSource.begin() + last + 1);
+		q->endRemoveRows();
+	}
+
+	updateSourceToProxy(proxyRows.back());
+}
+
+void ControllerSortFilterProxyModelPrivate::repositionSourceRow(int const sourceRow) noexcept
+{
+	Q_Q(ControllerSortFilterProxyModel);
+
+	auto const oldPosition = _sourceToProxy[sourceRow];
+
+	// Compute new position without the row itself
+	_proxyToSource.erase(_proxyToSource.begin() + oldPosition);
+	auto const newPosition = insertionPosition(sourceRow);
+	_proxyToSource.insert(_proxyToSource.begin() + oldPosition, sourceRow);
+
+	if (newPosition == oldPosition)
+	{
+		return;
+	}
+
+	// beginMoveRows destination is expressed in pre-move indexes
+	auto const destination = newPosition > oldPosition ? newPosition + 1 : newPosition;
+	if (!q->beginMoveRows({}, oldPosition, oldPosition, {}, destination))
+	{
+		return;
+	}
+	_proxyToSource.erase(_proxyToSource.begin() + oldPosition);
+	_proxyToSource.insert(_proxyToSource.begin() + newPosition, sourceRow);
+	updateSourceToProxy(std::min(oldPosition, newPosition));
+	q->endMoveRows();
+}
+
+void ControllerSortFilterProxyModelPrivate::sourceRowsInserted(QModelIndex const& parent, int first, int last)
+{
+	if (parent.isValid())
+	{
+		return;
+	}
+
+	auto const count = last - first + 1;
+
+	// Shift existing source rows
+	for (auto& row : _proxyToSource)
+	{
+		if (row >= first)
+		{
+			row += count;
+		}
+	}
+	_keys.insert(_keys.begin() + first, count, RowKey{});
+	_sourceToProxy.insert(_sourceToProxy.begin() + first, count, -1);
+
+	auto toInsert = std::vector<int>{};
+	for (auto row = first; row <= last; ++row)
+	{
+		_keys[row] = buildKey(row);
+		if (isAccepted(_keys[row]))
+		{
+			toInsert.push_back(row);
+		}
+	}
+	insertSourceRows(std::move(toInsert));
+}
+
+void ControllerSortFilterProxyModelPrivate::sourceRowsAboutToBeRemoved(QModelIndex const& parent, int first, int last)
+{
+	if (parent.isValid())
+	{
+		return;
+	}
+
+	auto toRemove = std::vector<int>{};
+	for (auto row = first; row <= last; ++row)
+	{
+		auto const proxy = _sourceToProxy[row];
+		if (proxy != -1)
+		{
+			toRemove.push_back(proxy);
+		}
+	}
+	removeProxyRows(std::move(toRemove));
+}
+
+void ControllerSortFilterProxyModelPrivate::sourceRowsRemoved(QModelIndex const& parent, int first, int last)
+{
+	if (parent.isValid())
+	{
+		return;
+	}
+
+	auto const count = last - first + 1;
+
+	_keys.erase(_keys.begin() + first, _keys.begin() + last + 1);
+	_sourceToProxy.erase(_sourceToProxy.begin() + first, _sourceToProxy.begin() + last + 1);
+	for (auto& row : _proxyToSource)
+	{
+		if (row > last)
+		{
+			row -= count;
+		}
+	}
+}
+
+void ControllerSortFilterProxyModelPrivate::sourceDataChanged(QModelIndex const& topLeft, QModelIndex const& bottomRight, QVector<int> const& roles)
+{
+	if (!topLeft.isValid() || !bottomRight.isValid())
+	{
+		return;
+	}
+
+	Q_Q(ControllerSortFilterProxyModel);
+
+	auto const firstColumn = topLeft.column();
+	auto const lastColumn = bottomRight.column();
+	auto const isColumnInRange = [firstColumn, lastColumn](int const column)
+	{
+		return column >= firstColumn && column <= lastColumn;
+	};
+	auto const affectsKeys = (roles.isEmpty() || roles.contains(Qt::DisplayRole)) && ((_sortColumn >= 0 && isColumnInRange(_sortColumn)) || isColumnInRange(la::avdecc::to_integral(ControllerModelColumn::Name)) || isColumnInRange(la::avdecc::to_integral(ControllerModelColumn::EntityId)));
+
+	// Changes to non-key columns (gPTP, logo, ...) are only forwarded
+	if (!affectsKeys)
+	{
+		// Multiple rows changed, their proxy rows are not contiguous so notify the whole range
+		if (topLeft.row() != bottomRight.row())
+		{
+			if (!_proxyToSource.empty())
+			{
+				emit q->dataChanged(q->index(0, firstColumn), q->index(rowCount() - 1, lastColumn), roles);
+			}
+			return;
+		}
+		auto const proxy = proxyRow(topLeft.row());
+		if (proxy != -1)
+		{
+			emit q->dataChanged(q->index(proxy, firstColumn), q->index(proxy, lastColumn), roles);
+		}
+		return;
+	}
+
+	for (auto row = topLeft.row(); row <= bottomRight.row(); ++row)
+	{
+		auto newKey = buildKey(row);
+		auto const wasAccepted = _sourceToProxy[row] != -1;
+		auto const accepted = isAccepted(newKey);
+		auto const sortKeyChanged = newKey.sortKey != _keys[row].sortKey;
+
+		_keys[row] = std::move(newKey);
+
+		if (wasAccepted && !accepted)
+		{
+			removeProxyRows({ _sourceToProxy[row] });
+			continue;
+		}
+		if (!wasAccepted)
+		{
+			if (accepted)
+			{
+				insertSourceRows({ row });
+			}
+			continue;
+		}
+
+		if (sortKeyChanged)
+		{
+			repositionSourceRow(row);
+		}
+
+		auto const proxy = _sourceToProxy[row];
+		emit q->dataChanged(q->index(proxy, firstColumn), q->index(proxy, lastColumn), roles);
+	}
+}
+
+void ControllerSortFilterProxyModelPrivate::sourceModelAboutToBeReset()
+{
+	Q_Q(ControllerSortFilterProxyModel);
+	q->beginResetModel();
+}
+
+void ControllerSortFilterProxyModelPrivate::sourceModelReset()
+{
+	Q_Q(ControllerSortFilterProxyModel);
+	rebuild();
+	q->endResetModel();
+}
+
+///////////////////////////////////////
+
+ControllerSortFilterProxyModel::ControllerSortFilterProxyModel(ControllerModel* model, QObject* parent)
+	: QAbstractProxyModel(parent)
+	, d_ptr(new ControllerSortFilterProxyModelPrivate(this, model))
+{
+	setSourceModel(model);
+}
+
+ControllerSortFilterProxyModel::~ControllerSortFilterProxyModel()
+{
+	delete d_ptr;
+}
+
+void ControllerSortFilterProxyModel::setFilterText(QString const& text)
+{
+	Q_D(ControllerSortFilterProxyModel);
+	d->setFilterText(text);
+}
+
+QString ControllerSortFilterProxyModel::filterText() const
+{
+	Q_D(const ControllerSortFilterProxyModel);
+	return d->filterText();
+}
+
+la::avdecc::UniqueIdentifier ControllerSortFilterProxyModel::controlledEntityID(QModelIndex const& index) const
+{
+	auto const* model = static_cast<ControllerModel const*>(sourceModel());
+	return model->controlledEntityID(mapToSource(index));
+}
+
+QModelIndex ControllerSortFilterProxyModel::index(int row, int column, QModelIndex const& parent) const
+{
+	if (parent.isValid() || row < 0 || row >= rowCount() || column < 0 || column >= columnCount())
+	{
+		return {};
+	}
+	return createIndex(row, column);
+}
+
+QModelIndex ControllerSortFilterProxyModel::parent(QModelIndex const& /*child*/) const
+{
+	return {};
+}
+
+int ControllerSortFilterProxyModel::rowCount(QModelIndex const& parent) const
+{
+	if (parent.isValid())
+	{
+		return 0;
+	}
+	Q_D(const ControllerSortFilterProxyModel);
+	return d->rowCount();
+}
+
+int ControllerSortFilterProxyModel::columnCount(QModelIndex const& parent) const
+{
+	if (parent.isValid())
+	{
+		return 0;
+	}
+	return sourceModel()->columnCount();
+}
+
+QModelIndex ControllerSortFilterProxyModel::mapToSource(QModelIndex const& proxyIndex) const
+{
+	if (!proxyIndex.isValid())
+	{
+		return {};
+	}
+	Q_D(const ControllerSortFilterProxyModel);
+	auto const row = d->sourceRow(proxyIndex.row());
+	if (row == -1)
+	{
+		return {};
+	}
+	return sourceModel()->index(row, proxyIndex.column());
+}
+
+QModelIndex ControllerSortFilterProxyModel::mapFromSource(QModelIndex const& sourceIndex) const
+{
+	if (!sourceIndex.isValid())
+	{
+		return {};
+	}
+	Q_D(const ControllerSortFilterProxyModel);
+	auto const row = d->proxyRow(sourceIndex.row());
+	if (row == -1)
+	{
+		return {};
+	}
+	return index(row, sourceIndex.column());
+}
+
+QVariant ControllerSortFilterProxyModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+	if (orientation == Qt::Horizontal)
+	{
+		return sourceModel()->headerData(section, orientation, role);
+	}
+	return QAbstractItemModel::headerData(section, orientation, role);
+}
+
+void ControllerSortFilterProxyModel::sort(int column, Qt::SortOrder order)
+{
+	Q_D(ControllerSortFilterProxyModel);
+	d->sort(column, order);
+}
+
+} // namespace avdecc
+
+#include "controllerSortFilterProxyModel.moc"
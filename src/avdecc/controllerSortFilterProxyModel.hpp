@@ -0,0 +1,63 @@
+/*
+* Copyright 2017-2018, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be usefu_state,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "controllerModel.hpp"
+#include <QAbstractProxyModel>
+
+namespace avdecc
+{
+class ControllerSortFilterProxyModelPrivate;
+
+/**
+* @brief Incrementally sorted and filtered view of a ControllerModel.
+* @details Unlike QSortFilterProxyModel, source changes never trigger a full sort:
+*          new rows are inserted using a binary search, a row whose sort key changed is moved alone,
+*          and changes to columns that are neither sorted nor filtered are simply forwarded.
+*          Filtering is a case-insensitive substring match on the entity name and ID.
+*/
+class ControllerSortFilterProxyModel : public QAbstractProxyModel
+{
+	Q_OBJECT
+public:
+	ControllerSortFilterProxyModel(ControllerModel* model, QObject* parent = nullptr);
+	~ControllerSortFilterProxyModel();
+
+	void setFilterText(QString const& text);
+	QString filterText() const;
+
+	// Helpers
+	la::avdecc::UniqueIdentifier controlledEntityID(QModelIndex const& index) const;
+
+	// QAbstractProxyModel overrides
+	virtual QModelIndex index(int row, int column, QModelIndex const& parent = QModelIndex()) const override;
+	virtual QModelIndex parent(QModelIndex const& child) const override;
+	virtual int rowCount(QModelIndex const& parent = QModelIndex()) const override;
+	virtual int columnCount(QModelIndex const& parent = QModelIndex()) const override;
+	virtual QModelIndex mapToSource(QModelIndex const& proxyIndex) const override;
+	virtual QModelIndex mapFromSource(QModelIndex const& sourceIndex) const override;
+	virtual QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+	virtual void sort(int column, Qt::SortOrder order = Qt::AscendingOrder) override;
+
+private:
+	ControllerSortFilterProxyModelPrivate * const d_ptr{ nullptr };
+	Q_DECLARE_PRIVATE(ControllerSortFilterProxyModel)
+};
+} // namespace avdecc
@@ -0,0 +1,212 @@
+/*
+* Copyright 2017-2018, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be usefu_state,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "descriptorDispatcher.hpp"
+#include <QMetaMethod>
+#include <memory>
+#include <unordered_map>
+
+namespace avdecc
+{
+
+bool DescriptorNotifier::hasReceivers() const noexcept
+{
+	auto const* const meta = metaObject();
+	for (auto methodIndex = meta->methodOffset(); methodIndex < meta->methodCount(); ++methodIndex)
+	{
+		auto const method = meta->method(methodIndex);
+		if (method.methodType() == QMetaMethod::Signal && isSignalConnected(method))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+class DescriptorDispatcherImpl final : public QObject, public DescriptorDispatcher
+{
+public:
+	DescriptorDispatcherImpl() noexcept
+	{
+		using DescriptorType = la::avdecc::entity::model::DescriptorType;
+		auto& manager = ControllerManager::getInstance();
+
+		// Entity
+		connect(&manager, &ControllerManager::entityOnline, this, [this](la::avdecc::UniqueIdentifier const entityID)
+		{
+			dispatch(entityID, DescriptorType::Entity, 0u, &DescriptorNotifier::entityOnline);
+		});
+		connect(&manager, &ControllerManager::entityOffline, this, [this](la::avdecc::UniqueIdentifier const entityID)
+		{
+			dispatch(entityID, DescriptorType::Entity, 0u, &DescriptorNotifier::entityOffline);
+			// Receivers of the entity are destroyed while handling the offline signal, so wait for them to disconnect before pruning
+			QMetaObject::invokeMethod(this, [this, entityID]()
+			{
+				pruneNotifiers(entityID);
+			}, Qt::QueuedConnection);
+		});
+		connect(&manager, &ControllerManager::entityNameChanged, this, [this](la::avdecc::UniqueIdentifier const entityID, QString const& entityName)
+		{
+			dispatch(entityID, DescriptorType::Entity, 0u, &DescriptorNotifier::entityNameChanged, entityName);
+		});
+		connect(&manager, &ControllerManager::entityGroupNameChanged, this, [this](la::avdecc::UniqueIdentifier const entityID, QString const& entityGroupName)
+		{
+			dispatch(entityID, DescriptorType::Entity, 0u, &DescriptorNotifier::entityGroupNameChanged, entityGroupName);
+		});
+		connect(&manager, &ControllerManager::beginAecpCommand, this, [this](la::avdecc::UniqueIdentifier const entityID, ControllerManager::AecpCommandType const commandType)
+		{
+			dispatch(entityID, DescriptorType::Entity, 0u, &DescriptorNotifier::beginAecpCommand, commandType);
+		});
+		connect(&manager, &ControllerManager::endAecpCommand, this, [this](la::avdecc::UniqueIdentifier const entityID, ControllerManager::AecpCommandType const commandType, la::avdecc::entity::ControllerEntity::AemCommandStatus const status)
+		{
+			dispatch(entityID, DescriptorType::Entity, 0u, &DescriptorNotifier::endAecpCommand, commandType, status);
+		});
+
+		// Configuration
+		connect(&manager, &ControllerManager::configurationNameChanged, this, [this](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, QString const& configurationName)
+		{
+			dispatch(entityID, DescriptorType::Configuration, configurationIndex, &DescriptorNotifier::configurationNameChanged, configurationName);
+		});
+
+		// Streams
+		connect(&manager, &ControllerManager::streamNameChanged, this, [this](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::DescriptorType const descriptorType, la::avdecc::entity::model::StreamIndex const streamIndex, QString const& streamName)
+		{
+			dispatch(entityID, descriptorType, streamIndex, &DescriptorNotifier::streamNameChanged, configurationIndex, streamName);
+		});
+		connect(&manager, &ControllerManager::streamFormatChanged, this, [this](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::DescriptorType const descriptorType, la::avdecc::entity::model::StreamIndex const streamIndex, la::avdecc::entity::model::StreamFormat const streamFormat)
+		{
+			dispatch(entityID, descriptorType, streamIndex, &DescriptorNotifier::streamFormatChanged, streamFormat);
+		});
+		connect(&manager, &ControllerManager::streamInfoChanged, this, [this](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::DescriptorType const descriptorType, la::avdecc::entity::model::StreamIndex const streamIndex, la::avdecc::entity::model::StreamInfo const& info)
+		{
+			dispatch(entityID, descriptorType, streamIndex, &DescriptorNotifier::streamInfoChanged, info);
+		});
+		connect(&manager, &ControllerManager::streamRunningChanged, this, [this](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::DescriptorType const descriptorType, la::avdecc::entity::model::StreamIndex const streamIndex, bool const isRunning)
+		{
+			dispatch(entityID, descriptorType, streamIndex, &DescriptorNotifier::streamRunningChanged, isRunning);
+		});
+		connect(&manager, &ControllerManager::streamConnectionChanged, this, [this](la::avdecc::controller::model::StreamConnectionState const& state)
+		{
+			dispatch(state.listenerStream.entityID, DescriptorType::StreamInput, state.listenerStream.streamIndex, &DescriptorNotifier::streamConnectionChanged, state);
+		});
+		connect(&manager, &ControllerManager::streamConnectionsChanged, this, [this](la::avdecc::entity::model::StreamIdentification const& stream, la::avdecc::controller::model::StreamConnections const& connections)
+		{
+			dispatch(stream.entityID, DescriptorType::StreamOutput, stream.streamIndex, &DescriptorNotifier::streamConnectionsChanged, connections);
+		});
+
+		// AudioUnit
+		connect(&manager, &ControllerManager::audioUnitSamplingRateChanged, this, [this](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::AudioUnitIndex const audioUnitIndex, la::avdecc::entity::model::SamplingRate const samplingRate)
+		{
+			dispatch(entityID, DescriptorType::AudioUnit, audioUnitIndex, &DescriptorNotifier::audioUnitSamplingRateChanged, samplingRate);
+		});
+
+		// ClockDomain
+		connect(&manager, &ControllerManager::clockSourceChanged, this, [this](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::ClockDomainIndex const clockDomainIndex, la::avdecc::entity::model::ClockSourceIndex const sourceIndex)
+		{
+			dispatch(entityID, DescriptorType::ClockDomain, clockDomainIndex, &DescriptorNotifier::clockSourceChanged, sourceIndex);
+		});
+
+		// AvbInterface
+		connect(&manager, &ControllerManager::avbInfoChanged, this, [this](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::AvbInterfaceIndex const avbInterfaceIndex, la::avdecc::entity::model::AvbInfo const& info)
+		{
+			dispatch(entityID, DescriptorType::AvbInterface, avbInterfaceIndex, &DescriptorNotifier::avbInfoChanged, info);
+		});
+		connect(&manager, &ControllerManager::gptpChanged, this, [this](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::AvbInterfaceIndex const avbInterfaceIndex, la::avdecc::UniqueIdentifier const grandMasterID, std::uint8_t const grandMasterDomain)
+		{
+			dispatch(entityID, DescriptorType::AvbInterface, avbInterfaceIndex, &DescriptorNotifier::gptpChanged, grandMasterID, grandMasterDomain);
+		});
+
+		// MemoryObject
+		connect(&manager, &ControllerManager::memoryObjectLengthChanged, this, [this](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::MemoryObjectIndex const memoryObjectIndex, std::uint64_t const length)
+		{
+			dispatch(entityID, DescriptorType::MemoryObject, memoryObjectIndex, &DescriptorNotifier::memoryObjectLengthChanged, length);
+		});
+	}
+
+	virtual DescriptorNotifier* getNotifier(la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::DescriptorType const descriptorType, la::avdecc::entity::model::DescriptorIndex const descriptorIndex) noexcept override
+	{
+		auto& notifier = _notifiers[Key{ entityID, descriptorType, descriptorIndex }];
+		if (!notifier)
+		{
+			notifier = std::make_unique<DescriptorNotifier>();
+		}
+		return notifier.get();
+	}
+
+private:
+	struct Key
+	{
+		la::avdecc::UniqueIdentifier entityID{};
+		la::avdecc::entity::model::DescriptorType descriptorType{ la::avdecc::entity::model::DescriptorType::Invalid };
+		la::avdecc::entity::model::DescriptorIndex descriptorIndex{ 0u };
+
+		bool operator==(Key const& other) const noexcept
+		{
+			return entityID == other.entityID && descriptorType == other.descriptorType && descriptorIndex == other.descriptorIndex;
+		}
+	};
+
+	struct KeyHash
+	{
+		std::size_t operator()(Key const& key) const noexcept
+		{
+			auto const descriptor = (static_cast<std::uint64_t>(la::avdecc::to_integral(key.descriptorType)) << 16) | static_cast<std::uint64_t>(key.descriptorIndex);
+			return la::avdecc::UniqueIdentifier::hash()(key.entityID) ^ std::hash<std::uint64_t>()(descriptor * 0x9e3779b97f4a7c15ull);
+		}
+	};
+
+	/** Emits the signal of the notifier of the specified descriptor, if anyone ever asked for it */
+	template<typename Signal, typename... Args>
+	void dispatch(la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::DescriptorType const descriptorType, la::avdecc::entity::model::DescriptorIndex const descriptorIndex, Signal const signal, Args&&... args) noexcept
+	{
+		auto const notifierIt = _notifiers.find(Key{ entityID, descriptorType, descriptorIndex });
+		if (notifierIt != _notifiers.end())
+		{
+			emit(notifierIt->second.get()->*signal)(std::forward<Args>(args)...);
+		}
+	}
+
+	/** Destroys the notifiers of the specified entity nobody is connected to anymore */
+	void pruneNotifiers(la::avdecc::UniqueIdentifier const entityID) noexcept
+	{
+		for (auto notifierIt = _notifiers.begin(); notifierIt != _notifiers.end();)
+		{
+			if (notifierIt->first.entityID == entityID && !notifierIt->second->hasReceivers())
+			{
+				notifierIt = _notifiers.erase(notifierIt);
+			}
+			else
+			{
+				++notifierIt;
+			}
+		}
+	}
+
+	std::unordered_map<Key, std::unique_ptr<DescriptorNotifier>, KeyHash> _notifiers{};
+};
+
+DescriptorDispatcher& DescriptorDispatcher::getInstance() noexcept
+{
+	static DescriptorDispatcherImpl s_DescriptorDispatcher{};
+
+	return s_DescriptorDispatcher;
+}
+
+} // namespace avdecc
@@ -0,0 +1,100 @@
+/*
+* Copyright 2017-2018, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be usefu_state,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#pragma once
+
+#include "controllerManager.hpp"
+#include <QObject>
+#include <QString>
+#include <cstdint>
+
+namespace avdecc
+{
+
+/**
+* @brief Signals of a single descriptor of an entity.
+* @details Emitted by the DescriptorDispatcher, only for the descriptor it has been requested for, so no receiver has to filter on entity or descriptor.
+*/
+class DescriptorNotifier : public QObject
+{
+	Q_OBJECT
+public:
+	/** Returns true if at least one of the signals of this notifier is connected */
+	bool hasReceivers() const noexcept;
+
+	/* Entity descriptor */
+	Q_SIGNAL void entityOnline();
+	Q_SIGNAL void entityOffline();
+	Q_SIGNAL void entityNameChanged(QString const& entityName);
+	Q_SIGNAL void entityGroupNameChanged(QString const& entityGroupName);
+	Q_SIGNAL void beginAecpCommand(avdecc::ControllerManager::AecpCommandType const commandType);
+	Q_SIGNAL void endAecpCommand(avdecc::ControllerManager::AecpCommandType const commandType, la::avdecc::entity::ControllerEntity::AemCommandStatus const status);
+
+	/* Configuration descriptor */
+	Q_SIGNAL void configurationNameChanged(QString const& configurationName);
+
+	/* StreamInput and StreamOutput descriptors */
+	Q_SIGNAL void streamNameChanged(la::avdecc::entity::model::ConfigurationIndex const configurationIndex, QString const& streamName);
+	Q_SIGNAL void streamFormatChanged(la::avdecc::entity::model::StreamFormat const streamFormat);
+	Q_SIGNAL void streamInfoChanged(la::avdecc::entity::model::StreamInfo const& info);
+	Q_SIGNAL void streamRunningChanged(bool const isRunning);
+	Q_SIGNAL void streamConnectionChanged(la::avdecc::controller::model::StreamConnectionState const& state); // StreamInput only
+	Q_SIGNAL void streamConnectionsChanged(la::avdecc::controller::model::StreamConnections const& connections); // StreamOutput only
+
+	/* AudioUnit descriptor */
+	Q_SIGNAL void audioUnitSamplingRateChanged(la::avdecc::entity::model::SamplingRate const samplingRate);
+
+	/* ClockDomain descriptor */
+	Q_SIGNAL void clockSourceChanged(la::avdecc::entity::model::ClockSourceIndex const sourceIndex);
+
+	/* AvbInterface descriptor */
+	Q_SIGNAL void avbInfoChanged(la::avdecc::entity::model::AvbInfo const& info);
+	Q_SIGNAL void gptpChanged(la::avdecc::UniqueIdentifier const grandMasterID, std::uint8_t const grandMasterDomain);
+
+	/* MemoryObject descriptor */
+	Q_SIGNAL void memoryObjectLengthChanged(std::uint64_t const length);
+};
+
+/**
+* @brief Routes the ControllerManager signals to the DescriptorNotifier of the descriptor they are about.
+* @details ControllerManager signals are received once, and each one is forwarded with a single hash lookup, so the cost of a notification
+*          only depends on the number of receivers interested in that descriptor, not on the number of widgets listening to the network.
+*          Must be used from the GUI thread.
+*/
+class DescriptorDispatcher
+{
+public:
+	static DescriptorDispatcher& getInstance() noexcept;
+
+	/** Returns the notifier for the specified descriptor (created on first request and owned by the dispatcher, which destroys it once its entity went offline and it has no receivers left, so connect to it right away instead of keeping the pointer) */
+	virtual DescriptorNotifier* getNotifier(la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::DescriptorType const descriptorType, la::avdecc::entity::model::DescriptorIndex const descriptorIndex) noexcept = 0;
+
+	/** Returns the notifier for the Entity descriptor of the specified entity */
+	DescriptorNotifier* getEntityNotifier(la::avdecc::UniqueIdentifier const entityID) noexcept
+	{
+		return getNotifier(entityID, la::avdecc::entity::model::DescriptorType::Entity, 0u);
+	}
+
+protected:
+	DescriptorDispatcher() = default;
+	virtual ~DescriptorDispatcher() = default;
+};
+
+} // namespace avdecc
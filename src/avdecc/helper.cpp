@@ -18,6 +18,7 @@
 */
 
 #include "helper.hpp"
+#include "stringCache.hpp"
 #include <la/avdecc/utils.hpp>
 
 namespace avdecc
@@ -46,12 +47,25 @@ QString protocolInterfaceTypeName(la::avdecc::EndStation::ProtocolInterfaceType
 
 QString uniqueIdentifierToString(la::avdecc::UniqueIdentifier const& identifier)
 {
-	return toHexQString(identifier.getValue(), true, true);
+	return StringCache::getInstance().uniqueIdentifierToString(identifier);
+}
+
+QString localizedString(la::avdecc::controller::ControlledEntity const& controlledEntity, la::avdecc::entity::model::LocalizedStringReference const stringReference)
+{
+	try
+	{
+		auto const configurationIndex = controlledEntity.getEntityNode().dynamicModel->currentConfiguration;
+		return StringCache::getInstance().localizedString(controlledEntity, configurationIndex, stringReference);
+	}
+	catch (...)
+	{
+		return {};
+	}
 }
 
 QString configurationName(la::avdecc::controller::ControlledEntity const* const controlledEntity, la::avdecc::controller::model::ConfigurationNode const& node)
 {
-	return node.dynamicModel->objectName.empty() ? controlledEntity->getLocalizedString(node.descriptorIndex, node.staticModel->localizedDescription).data() : node.dynamicModel->objectName.data();
+	return node.dynamicModel->objectName.empty() ? StringCache::getInstance().localizedString(*controlledEntity, node.descriptorIndex, node.staticModel->localizedDescription) : node.dynamicModel->objectName.data();
 }
 
 QString smartEntityName(la::avdecc::controller::ControlledEntity const& controlledEntity) noexcept
@@ -334,6 +348,11 @@ QString streamFormatToString(la::avdecc::entity::model::StreamFormatInfo const&
 	return fmtStr;
 }
 
+QString streamFormatToString(la::avdecc::entity::model::StreamFormat const streamFormat)
+{
+	return StringCache::getInstance().streamFormatToString(streamFormat);
+}
+
 QString clockSourceToString(la::avdecc::controller::model::ClockSourceNode const& node)
 {
 	auto const* const descriptor = node.staticModel;
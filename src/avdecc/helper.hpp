@@ -22,6 +22,8 @@
 #include <QString>
 #include <QObject>
 #include <functional>
+#include <algorithm>
+#include <type_traits>
 #include <la/avdecc/controller/avdeccController.hpp>
 #include <la/avdecc/internals/streamFormat.hpp>
 #include <la/avdecc/controller/internals/avdeccControlledEntity.hpp>
@@ -37,32 +39,47 @@ inline QString toHexQString(T const v, bool const zeroFilled = false, bool const
 {
 	static_assert(std::numeric_limits<T>::is_integer, "toHexQString requires an integer value");
 
-	try
+	// Formatted in a local buffer, the returned string is the only allocation
+	using NumericType = decltype(la::avdecc::forceNumeric(v));
+	auto value = static_cast<std::make_unsigned_t<NumericType>>(la::avdecc::forceNumeric(v));
+
+	auto const* const digits = upper ? "0123456789ABCDEF" : "0123456789abcdef";
+	char buffer[2 + sizeof(value) * 2];
+	auto* const end = buffer + sizeof(buffer);
+	auto* pos = end;
+	do
 	{
-		std::stringstream stream;
-		stream << "0x";
-		if (zeroFilled)
-			stream << std::setfill('0') << std::setw(sizeof(T) * 2);
-		if (upper)
-			stream << std::uppercase;
-		stream << std::hex << la::avdecc::forceNumeric(v);
-		return QString::fromStdString(stream.str());
-	}
-	catch (...)
+		*--pos = digits[value & 0xf];
+		value >>= 4;
+	} while (value != 0);
+
+	if (zeroFilled)
 	{
-		return "[Invalid Conversion]";
+		auto* const first = end - std::min(sizeof(T) * 2, sizeof(value) * 2);
+		while (pos > first)
+		{
+			*--pos = '0';
+		}
 	}
+
+	*--pos = 'x';
+	*--pos = '0';
+
+	return QString::fromLatin1(pos, static_cast<int>(end - pos));
 }
 
 QString protocolInterfaceTypeName(la::avdecc::EndStation::ProtocolInterfaceType const& protocolInterfaceType);
 
 QString uniqueIdentifierToString(la::avdecc::UniqueIdentifier const& identifier);
 
+/** Returns the localized string for the current configuration of the entity (cached, see StringCache) */
+QString localizedString(la::avdecc::controller::ControlledEntity const& controlledEntity, la::avdecc::entity::model::LocalizedStringReference const stringReference);
+
 QString configurationName(la::avdecc::controller::ControlledEntity const* const controlledEntity, la::avdecc::controller::model::ConfigurationNode const& node);
 template<class NodeType>
 QString objectName(la::avdecc::controller::ControlledEntity const* const controlledEntity, NodeType const& node)
 {
-	return node.dynamicModel->objectName.empty() ? controlledEntity->getLocalizedString(node.staticModel->localizedDescription).data() : node.dynamicModel->objectName.data();
+	return node.dynamicModel->objectName.empty() ? localizedString(*controlledEntity, node.staticModel->localizedDescription) : node.dynamicModel->objectName.data();
 }
 
 QString smartEntityName(la::avdecc::controller::ControlledEntity const& controlledEntity) noexcept;
@@ -74,6 +91,8 @@ QString acquireStateToString(la::avdecc::controller::model::AcquireState const&
 
 QString samplingRateToString(la::avdecc::entity::model::StreamFormatInfo::SamplingRate const& samplingRate);
 QString streamFormatToString(la::avdecc::entity::model::StreamFormatInfo const& format);
+/** Returns the description of the stream format (cached, see StringCache) */
+QString streamFormatToString(la::avdecc::entity::model::StreamFormat const streamFormat);
 QString clockSourceToString(la::avdecc::controller::model::ClockSourceNode const& node);
 
 QString flagsToString(la::avdecc::entity::AvbInterfaceFlags const flags);
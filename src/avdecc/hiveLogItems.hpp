@@ -21,6 +21,7 @@
 
 #include <la/avdecc/logger.hpp>
 #include "la/avdecc/utils.hpp"
+#include "loggerLevels.hpp"
 #include <QString>
 
 namespace avdecc
@@ -66,7 +67,13 @@ constexpr void log(Ts&&... params)
 } // namespace avdecc
 
 /** Preprocessor defines to remove at compile time some of the most time-consuming log messages (Trace and Debug) - Creation of the arguments */
-#define LOG_HIVE(LogLevel, Message) avdecc::logger::log<la::avdecc::logger::Level::LogLevel, avdecc::logger::LogItemHive>(Message)
+/** The message is only built if the level is enabled for the Hive layer */
+#define LOG_HIVE(LogLevel, Message) \
+	do \
+	{ \
+		if (avdecc::logger::isLevelEnabled(la::avdecc::logger::Layer::FirstUserLayer, la::avdecc::logger::Level::LogLevel)) \
+			avdecc::logger::log<la::avdecc::logger::Level::LogLevel, avdecc::logger::LogItemHive>(Message); \
+	} while (false)
 #ifdef DEBUG
 #define LOG_HIVE_TRACE(Message) LOG_HIVE(Trace, Message)
 #define LOG_HIVE_DEBUG(Message) LOG_HIVE(Debug, Message)
@@ -0,0 +1,100 @@
+/*
+* Copyright 2017-2018, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be usefu_state,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "loggerLevels.hpp"
+#include <algorithm>
+
+namespace avdecc
+{
+namespace logger
+{
+
+LayerLevels::LayerLevels() noexcept
+{
+	// Default to the level currently set on the global logger
+	auto const level = la::avdecc::to_integral(la::avdecc::logger::Logger::getInstance().getLevel());
+	for (auto& l : _levels)
+	{
+		l.store(level, std::memory_order_relaxed);
+	}
+}
+
+LayerLevels& LayerLevels::getInstance() noexcept
+{
+	static LayerLevels s_LayerLevels{};
+
+	return s_LayerLevels;
+}
+
+la::avdecc::logger::Level LayerLevels::getDefaultLevel() noexcept
+{
+#ifndef NDEBUG
+	return la::avdecc::logger::Level::Trace;
+#else
+	// In release, Trace and Debug are not enabled by default
+	return la::avdecc::logger::Level::Info;
+#endif
+}
+
+void LayerLevels::setDefaultLevels() noexcept
+{
+	auto const level = getDefaultLevel();
+	for (auto& l : _levels)
+	{
+		l.store(la::avdecc::to_integral(level), std::memory_order_relaxed);
+	}
+	_configuredLayers.set();
+	la::avdecc::logger::Logger::getInstance().setLevel(level);
+}
+
+void LayerLevels::setLevel(la::avdecc::logger::Layer const layer, la::avdecc::logger::Level const level) noexcept
+{
+	auto const layerIndex = static_cast<std::size_t>(la::avdecc::to_integral(layer));
+	if (!AVDECC_ASSERT_WITH_RET(layerIndex < MaxLayers, "Layer out of range"))
+	{
+		return;
+	}
+
+	_levels[layerIndex].store(la::avdecc::to_integral(level), std::memory_order_relaxed);
+	_configuredLayers.set(layerIndex);
+
+	// Push the most verbose level of all configured layers down to the library logger
+	auto minLevel = la::avdecc::to_integral(level);
+	for (auto i = std::size_t{ 0u }; i < MaxLayers; ++i)
+	{
+		if (_configuredLayers.test(i))
+		{
+			minLevel = std::min(minLevel, _levels[i].load(std::memory_order_relaxed));
+		}
+	}
+	la::avdecc::logger::Logger::getInstance().setLevel(static_cast<la::avdecc::logger::Level>(minLevel));
+}
+
+la::avdecc::logger::Level LayerLevels::getLevel(la::avdecc::logger::Layer const layer) const noexcept
+{
+	auto const layerIndex = static_cast<std::size_t>(la::avdecc::to_integral(layer));
+	if (layerIndex >= MaxLayers)
+	{
+		return la::avdecc::logger::Logger::getInstance().getLevel();
+	}
+	return static_cast<la::avdecc::logger::Level>(_levels[layerIndex].load(std::memory_order_relaxed));
+}
+
+} // namespace logger
+} // namespace avdecc
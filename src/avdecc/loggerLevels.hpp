@@ -0,0 +1,81 @@
+/*
+* Copyright 2017-2018, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be usefu_state,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <la/avdecc/logger.hpp>
+#include <la/avdecc/utils.hpp>
+#include <array>
+#include <atomic>
+#include <bitset>
+#include <cstdint>
+
+namespace avdecc
+{
+namespace logger
+{
+
+/**
+* @brief Per-layer minimum log level.
+* @details The la::avdecc::logger::Logger only supports a global level, so the most verbose of all layer levels is pushed to it
+*          (keeping the library from building messages no layer wants), and items are then gated per layer by isLevelEnabled.
+*/
+class LayerLevels final
+{
+public:
+	static LayerLevels& getInstance() noexcept;
+
+	/** Default level of the build: all levels in debug, Info and above in release */
+	static la::avdecc::logger::Level getDefaultLevel() noexcept;
+	/** Sets all layers to the default level. Called once at startup, before the logger view exists. */
+	void setDefaultLevels() noexcept;
+
+	/** Sets the minimum level for the specified layer (Level::None disables the layer) and updates the global logger level. Must be called from the GUI thread. */
+	void setLevel(la::avdecc::logger::Layer const layer, la::avdecc::logger::Level const level) noexcept;
+	la::avdecc::logger::Level getLevel(la::avdecc::logger::Layer const layer) const noexcept;
+
+	/** Returns true if messages of specified level should be built for the specified layer. Lock-free, callable from any thread. */
+	bool isLevelEnabled(la::avdecc::logger::Layer const layer, la::avdecc::logger::Level const level) const noexcept
+	{
+		auto const layerIndex = static_cast<std::size_t>(la::avdecc::to_integral(layer));
+		if (layerIndex >= MaxLayers)
+		{
+			return true;
+		}
+		return la::avdecc::to_integral(level) >= _levels[layerIndex].load(std::memory_order_relaxed);
+	}
+
+private:
+	using LevelType = std::underlying_type_t<la::avdecc::logger::Level>;
+	static constexpr std::size_t MaxLayers = 256;
+
+	LayerLevels() noexcept;
+
+	std::array<std::atomic<LevelType>, MaxLayers> _levels;
+	std::bitset<MaxLayers> _configuredLayers{};
+};
+
+/** Returns true if messages of specified level should be built for the specified layer */
+inline bool isLevelEnabled(la::avdecc::logger::Layer const layer, la::avdecc::logger::Level const level) noexcept
+{
+	return LayerLevels::getInstance().isLevelEnabled(layer, level);
+}
+
+} // namespace logger
+} // namespace avdecc
@@ -18,13 +18,20 @@
 */
 
 #include "loggerModel.hpp"
+#include "loggerLevels.hpp"
 #include "helper.hpp"
+#include "profiler/profiler.hpp"
+#include "profiler/memoryAccounting.hpp"
 
 #include <la/avdecc/internals/logItems.hpp>
 #include <la/avdecc/controller/internals/logItems.hpp>
 
 #include <unordered_map>
+#include <algorithm>
+#include <chrono>
+#include <mutex>
 #include <QTime>
+#include <QTimer>
 #include <QFile>
 #include <QTextStream>
 
@@ -53,6 +60,9 @@ public:
 		: q_ptr(model)
 	{
 		la::avdecc::logger::Logger::getInstance().registerObserver(this);
+
+		connect(&_suppressedReportTimer, &QTimer::timeout, this, &LoggerModelPrivate::reportSuppressedMessages);
+		_suppressedReportTimer.start(SuppressedReportInterval);
 	}
 
 	~LoggerModelPrivate()
@@ -121,6 +131,8 @@ public:
 		Q_Q(LoggerModel);
 		q->beginResetModel();
 		_entries.clear();
+		_entriesStringBytes = 0;
+		updateMemoryAccount();
 		q->endResetModel();
 	}
 
@@ -145,17 +157,89 @@ public:
 
 	virtual void onLogItem(la::avdecc::logger::Level const level, la::avdecc::logger::LogItem const* const item) noexcept override
 	{
-		QMetaObject::invokeMethod(this, [this, layer = item->getLayer(), level, message = item->getMessage()]()
+		auto const layer = item->getLayer();
+
+		// Drop the item before building its message if the level is not enabled for this layer
+		if (!avdecc::logger::isLevelEnabled(layer, level))
+		{
+			return;
+		}
+
+		// Log storm protection
+		if (!consumeToken(layer))
 		{
-			Q_Q(LoggerModel);
-			auto const count = q->rowCount();
-			q->beginInsertRows({}, count, count);
-			auto const timestamp = QString("%1 - %2").arg(QDate::currentDate().toString(Qt::ISODate), QTime::currentTime().toString(Qt::ISODate));
-			_entries.push_back({ timestamp, layer, level, QString::fromStdString(message) });
-			q->endInsertRows();
+			return;
+		}
+
+		QMetaObject::invokeMethod(this, [this, layer, level, message = item->getMessage()]()
+		{
+			appendEntry(layer, level, QString::fromStdString(message));
 		});
 	}
 
+	void appendEntry(la::avdecc::logger::Layer const layer, la::avdecc::logger::Level const level, QString const& message)
+	{
+		PROFILER_SCOPE("logger", "LoggerModel::appendEntry");
+
+		Q_Q(LoggerModel);
+		auto const count = q->rowCount();
+		q->beginInsertRows({}, count, count);
+		auto const timestamp = QString("%1 - %2").arg(QDate::currentDate().toString(Qt::ISODate), QTime::currentTime().toString(Qt::ISODate));
+		_entries.push_back({ timestamp, layer, level, message });
+		_entriesStringBytes += profiler::stringBytes(timestamp) + profiler::stringBytes(message);
+		updateMemoryAccount();
+		q->endInsertRows();
+	}
+
+	/** Token bucket rate limiter, returns false (and counts the message as suppressed) if the layer exceeded its rate */
+	bool consumeToken(la::avdecc::logger::Layer const layer) noexcept
+	{
+		auto const lg = std::lock_guard{ _rateLimitersLock };
+		auto const now = std::chrono::steady_clock::now();
+
+		auto limiterIt = _rateLimiters.find(layer);
+		if (limiterIt == _rateLimiters.end())
+		{
+			limiterIt = _rateLimiters.emplace(layer, RateLimiter{ RateLimitBurst, now, 0u }).first;
+		}
+
+		auto& limiter = limiterIt->second;
+		auto const elapsed = std::chrono::duration<double>(now - limiter.lastRefill).count();
+		limiter.tokens = std::min(RateLimitBurst, limiter.tokens + elapsed * RateLimitPerSecond);
+		limiter.lastRefill = now;
+
+		if (limiter.tokens < 1.0)
+		{
+			++limiter.suppressed;
+			return false;
+		}
+
+		limiter.tokens -= 1.0;
+		return true;
+	}
+
+	Q_SLOT void reportSuppressedMessages()
+	{
+		std::vector<std::pair<la::avdecc::logger::Layer, std::uint64_t>> suppressed;
+		{
+			auto const lg = std::lock_guard{ _rateLimitersLock };
+			for (auto& limiterKV : _rateLimiters)
+			{
+				auto& limiter = limiterKV.second;
+				if (limiter.suppressed != 0u)
+				{
+					suppressed.emplace_back(limiterKV.first, limiter.suppressed);
+					limiter.suppressed = 0u;
+				}
+			}
+		}
+
+		for (auto const& s : suppressed)
+		{
+			appendEntry(s.first, la::avdecc::logger::Level::Warn, QString("%1 similar messages suppressed").arg(s.second));
+		}
+	}
+
 private:
 	LoggerModel * const q_ptr{ nullptr };
 	Q_DECLARE_PUBLIC(LoggerModel);
@@ -170,7 +254,30 @@ private:
 		QString message{};
 	};
 
+	void updateMemoryAccount() noexcept
+	{
+		_memoryAccount.set(static_cast<std::int64_t>(_entries.capacity() * sizeof(LogInfo)) + _entriesStringBytes);
+	}
+
 	std::vector<LogInfo> _entries;
+	std::int64_t _entriesStringBytes{ 0 };
+	profiler::MemoryAccount _memoryAccount{ profiler::MemorySubsystem::Logger };
+
+	// Per-layer log storm protection
+	static constexpr double RateLimitBurst = 200.0;
+	static constexpr double RateLimitPerSecond = 100.0;
+	static constexpr int SuppressedReportInterval = 1000;
+
+	struct RateLimiter
+	{
+		double tokens{ 0.0 };
+		std::chrono::steady_clock::time_point lastRefill{};
+		std::uint64_t suppressed{ 0u };
+	};
+
+	std::mutex _rateLimitersLock{};
+	std::unordered_map<la::avdecc::logger::Layer, RateLimiter> _rateLimiters{};
+	QTimer _suppressedReportTimer{ this };
 };
 
 LoggerModel::LoggerModel(QObject* parent)
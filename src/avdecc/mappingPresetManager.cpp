@@ -0,0 +1,337 @@
+/*
+* Copyright 2017-2018, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be usefu_state,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "mappingPresetManager.hpp"
+#include "controllerManager.hpp"
+#include "settingsManager/settings.hpp"
+
+#include <QByteArray>
+#include <QDataStream>
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <map>
+#include <optional>
+
+namespace avdecc
+{
+class MappingPresetManagerImpl final : public MappingPresetManager
+{
+public:
+	MappingPresetManagerImpl() noexcept
+	{
+		loadPresets();
+	}
+
+private:
+	// Serialization format version of the presets saved in the settings
+	static constexpr std::uint32_t PresetsVersion = 1u;
+
+	using PackedMapping = std::uint64_t;
+	using PackedMappings = std::vector<PackedMapping>; // Sorted, without duplicates
+
+	struct EntityChanges
+	{
+		la::avdecc::UniqueIdentifier entityID{};
+		la::avdecc::entity::model::AudioMappings toRemove{};
+		la::avdecc::entity::model::AudioMappings toAdd{};
+	};
+
+	static PackedMapping packMapping(la::avdecc::entity::model::AudioMapping const& mapping) noexcept
+	{
+		return (static_cast<PackedMapping>(mapping.streamIndex) << 48) | (static_cast<PackedMapping>(mapping.streamChannel) << 32) | (static_cast<PackedMapping>(mapping.clusterOffset) << 16) | static_cast<PackedMapping>(mapping.clusterChannel);
+	}
+
+	static la::avdecc::entity::model::AudioMapping unpackMapping(PackedMapping const packed) noexcept
+	{
+		auto mapping = la::avdecc::entity::model::AudioMapping{};
+		mapping.streamIndex = static_cast<la::avdecc::entity::model::StreamIndex>(packed >> 48);
+		mapping.streamChannel = static_cast<std::uint16_t>(packed >> 32);
+		mapping.clusterOffset = static_cast<la::avdecc::entity::model::ClusterIndex>(packed >> 16);
+		mapping.clusterChannel = static_cast<std::uint16_t>(packed);
+		return mapping;
+	}
+
+	static PackedMappings packMappings(la::avdecc::entity::model::AudioMappings const& mappings) noexcept
+	{
+		auto packed = PackedMappings{};
+		packed.reserve(mappings.size());
+		for (auto const& mapping : mappings)
+		{
+			packed.push_back(packMapping(mapping));
+		}
+		std::sort(packed.begin(), packed.end());
+		packed.erase(std::unique(packed.begin(), packed.end()), packed.end());
+		return packed;
+	}
+
+	/** Returns the mappings in lhs that are not in rhs */
+	static la::avdecc::entity::model::AudioMappings substract(PackedMappings const& lhs, PackedMappings const& rhs) noexcept
+	{
+		auto difference = PackedMappings{};
+		std::set_difference(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), std::back_inserter(difference));
+
+		auto mappings = la::avdecc::entity::model::AudioMappings{};
+		mappings.reserve(difference.size());
+		for (auto const packed : difference)
+		{
+			mappings.push_back(unpackMapping(packed));
+		}
+		return mappings;
+	}
+
+	/** Returns the current dynamic mappings of the stream port, or std::nullopt if it does not exist */
+	static std::optional<la::avdecc::entity::model::AudioMappings> getDynamicMappings(la::avdecc::controller::ControlledEntity const& controlledEntity, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::DescriptorType const streamPortType, la::avdecc::entity::model::StreamPortIndex const streamPortIndex) noexcept
+	{
+		try
+		{
+			if (streamPortType == la::avdecc::entity::model::DescriptorType::StreamPortInput)
+			{
+				return controlledEntity.getStreamPortInputNode(configurationIndex, streamPortIndex).dynamicModel->dynamicAudioMap;
+			}
+			if (streamPortType == la::avdecc::entity::model::DescriptorType::StreamPortOutput)
+			{
+				return controlledEntity.getStreamPortOutputNode(configurationIndex, streamPortIndex).dynamicModel->dynamicAudioMap;
+			}
+		}
+		catch (la::avdecc::controller::ControlledEntity::Exception const&)
+		{
+		}
+		return std::nullopt;
+	}
+
+	// MappingPresetManager overrides
+	virtual bool capturePreset(QString const& name, la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::DescriptorType const streamPortType, la::avdecc::entity::model::StreamPortIndex const streamPortIndex) noexcept override
+	{
+		auto& manager = ControllerManager::getInstance();
+		auto controlledEntity = manager.getControlledEntity(entityID);
+		if (!controlledEntity || name.isEmpty())
+		{
+			return false;
+		}
+
+		auto const configurationIndex = controlledEntity->getEntityNode().dynamicModel->currentConfiguration;
+		auto mappings = getDynamicMappings(*controlledEntity, configurationIndex, streamPortType, streamPortIndex);
+		if (!mappings)
+		{
+			return false;
+		}
+
+		auto preset = Preset{};
+		preset.name = name;
+		preset.entityModelID = controlledEntity->getEntity().getEntityModelID();
+		preset.configurationIndex = configurationIndex;
+		preset.streamPortType = streamPortType;
+		preset.streamPortIndex = streamPortIndex;
+		preset.mappings = std::move(*mappings);
+
+		_presets[name] = std::move(preset);
+		savePresets();
+		emit presetsChanged();
+
+		return true;
+	}
+
+	virtual void removePreset(QString const& name) noexcept override
+	{
+		if (_presets.erase(name) != 0)
+		{
+			savePresets();
+			emit presetsChanged();
+		}
+	}
+
+	virtual Presets getPresets() const noexcept override
+	{
+		auto presets = Presets{};
+		presets.reserve(_presets.size());
+		for (auto const& presetKV : _presets)
+		{
+			presets.push_back(presetKV.second);
+		}
+		return presets;
+	}
+
+	virtual Presets getPresets(la::avdecc::UniqueIdentifier const entityModelID) const noexcept override
+	{
+		auto presets = Presets{};
+		for (auto const& presetKV : _presets)
+		{
+			if (presetKV.second.entityModelID == entityModelID)
+			{
+				presets.push_back(presetKV.second);
+			}
+		}
+		return presets;
+	}
+
+	virtual ApplyResult applyPreset(QString const& name, std::vector<la::avdecc::UniqueIdentifier> const& entityIDs) noexcept override
+	{
+		auto result = ApplyResult{};
+
+		auto const presetIt = _presets.find(name);
+		if (presetIt == _presets.end())
+		{
+			result.skippedEntities = entityIDs.size();
+			return result;
+		}
+		auto const& preset = presetIt->second;
+		auto const presetMappings = packMappings(preset.mappings);
+
+		auto& manager = ControllerManager::getInstance();
+
+		// Compute the changes of all entities first, so no entity is locked while commands are being sent
+		auto changes = std::vector<EntityChanges>{};
+		changes.reserve(entityIDs.size());
+		for (auto const& entityID : entityIDs)
+		{
+			auto controlledEntity = manager.getControlledEntity(entityID);
+			if (!controlledEntity || controlledEntity->getEntity().getEntityModelID() != preset.entityModelID || controlledEntity->getEntityNode().dynamicModel->currentConfiguration != preset.configurationIndex)
+			{
+				++result.skippedEntities;
+				continue;
+			}
+
+			auto const mappings = getDynamicMappings(*controlledEntity, preset.configurationIndex, preset.streamPortType, preset.streamPortIndex);
+			if (!mappings)
+			{
+				++result.skippedEntities;
+				continue;
+			}
+
+			auto const currentMappings = packMappings(*mappings);
+			auto entityChanges = EntityChanges{ entityID, substract(currentMappings, presetMappings), substract(presetMappings, currentMappings) };
+			if (entityChanges.toRemove.empty() && entityChanges.toAdd.empty())
+			{
+				++result.upToDateEntities;
+				continue;
+			}
+
+			++result.updatedEntities;
+			result.removedMappings += entityChanges.toRemove.size();
+			result.addedMappings += entityChanges.toAdd.size();
+			changes.push_back(std::move(entityChanges));
+		}
+
+		// Commands are asynchronous and queued per entity: all entities are processed in parallel, and removals are sent before additions on each entity
+		auto const isInput = preset.streamPortType == la::avdecc::entity::model::DescriptorType::StreamPortInput;
+		for (auto const& entityChanges : changes)
+		{
+			if (!entityChanges.toRemove.empty())
+			{
+				if (isInput)
+				{
+					manager.removeStreamPortInputAudioMappings(entityChanges.entityID, preset.streamPortIndex, entityChanges.toRemove);
+				}
+				else
+				{
+					manager.removeStreamPortOutputAudioMappings(entityChanges.entityID, preset.streamPortIndex, entityChanges.toRemove);
+				}
+			}
+			if (!entityChanges.toAdd.empty())
+			{
+				if (isInput)
+				{
+					manager.addStreamPortInputAudioMappings(entityChanges.entityID, preset.streamPortIndex, entityChanges.toAdd);
+				}
+				else
+				{
+					manager.addStreamPortOutputAudioMappings(entityChanges.entityID, preset.streamPortIndex, entityChanges.toAdd);
+				}
+			}
+		}
+
+		return result;
+	}
+
+	// Private methods
+	void loadPresets() noexcept
+	{
+		auto& settings = settings::SettingsManager::getInstance();
+		auto data = settings.getValue(settings::MappingPresets).toByteArray();
+		if (data.isEmpty())
+		{
+			return;
+		}
+
+		QDataStream stream(&data, QIODevice::ReadOnly);
+		auto version = std::uint32_t{ 0u };
+		auto count = std::uint32_t{ 0u };
+		stream >> version >> count;
+		if (version != PresetsVersion)
+		{
+			return;
+		}
+
+		for (auto i = std::uint32_t{ 0u }; i < count && stream.status() == QDataStream::Ok; ++i)
+		{
+			auto preset = Preset{};
+			auto entityModelID = quint64{ 0u };
+			auto streamPortType = quint16{ 0u };
+			auto mappingsCount = std::uint32_t{ 0u };
+			stream >> preset.name >> entityModelID >> preset.configurationIndex >> streamPortType >> preset.streamPortIndex >> mappingsCount;
+
+			preset.entityModelID = la::avdecc::UniqueIdentifier{ entityModelID };
+			preset.streamPortType = static_cast<la::avdecc::entity::model::DescriptorType>(streamPortType);
+			for (auto m = std::uint32_t{ 0u }; m < mappingsCount && stream.status() == QDataStream::Ok; ++m)
+			{
+				auto packed = quint64{ 0u };
+				stream >> packed;
+				preset.mappings.push_back(unpackMapping(packed));
+			}
+
+			if (stream.status() == QDataStream::Ok)
+			{
+				_presets[preset.name] = std::move(preset);
+			}
+		}
+	}
+
+	void savePresets() const noexcept
+	{
+		QByteArray data;
+		QDataStream stream(&data, QIODevice::WriteOnly);
+		stream << PresetsVersion << static_cast<std::uint32_t>(_presets.size());
+
+		for (auto const& [name, preset] : _presets)
+		{
+			stream << name << static_cast<quint64>(preset.entityModelID.getValue()) << preset.configurationIndex << static_cast<quint16>(la::avdecc::to_integral(preset.streamPortType)) << preset.streamPortIndex << static_cast<std::uint32_t>(preset.mappings.size());
+			for (auto const& mapping : preset.mappings)
+			{
+				stream << static_cast<quint64>(packMapping(mapping));
+			}
+		}
+
+		auto& settings = settings::SettingsManager::getInstance();
+		settings.setValue(settings::MappingPresets, data);
+	}
+
+	// Private members
+	std::map<QString, Preset> _presets{}; // Sorted by name
+};
+
+MappingPresetManager& MappingPresetManager::getInstance() noexcept
+{
+	static MappingPresetManagerImpl s_MappingPresetManager{};
+
+	return s_MappingPresetManager;
+}
+
+} // namespace avdecc
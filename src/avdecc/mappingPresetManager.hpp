@@ -0,0 +1,80 @@
+/*
+* Copyright 2017-2018, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be usefu_state,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <la/avdecc/controller/avdeccController.hpp>
+#include <QObject>
+#include <QString>
+#include <cstddef>
+#include <vector>
+
+namespace avdecc
+{
+
+/**
+* @brief Reusable dynamic audio mappings of a stream port, applicable to many entities of the same model at once.
+* @details Presets are saved in the settings. Applying a preset only sends the mappings that differ on each entity
+*          (entities already matching the preset send nothing), and the commands for all entities are in flight at the same time.
+*          Must be used from the GUI thread.
+*/
+class MappingPresetManager : public QObject
+{
+	Q_OBJECT
+public:
+	struct Preset
+	{
+		QString name{};
+		la::avdecc::UniqueIdentifier entityModelID{};
+		la::avdecc::entity::model::ConfigurationIndex configurationIndex{ 0u };
+		la::avdecc::entity::model::DescriptorType streamPortType{ la::avdecc::entity::model::DescriptorType::Entity };
+		la::avdecc::entity::model::StreamPortIndex streamPortIndex{ 0u };
+		la::avdecc::entity::model::AudioMappings mappings{};
+	};
+	using Presets = std::vector<Preset>;
+
+	struct ApplyResult
+	{
+		std::size_t updatedEntities{ 0u }; // Entities commands were sent to
+		std::size_t upToDateEntities{ 0u }; // Entities already matching the preset
+		std::size_t skippedEntities{ 0u }; // Offline entities, or entities of another model or in another configuration
+		std::size_t addedMappings{ 0u };
+		std::size_t removedMappings{ 0u };
+	};
+
+	static MappingPresetManager& getInstance() noexcept;
+
+	/** Saves the current dynamic mappings of the specified stream port as a preset, replacing any preset with the same name. Returns false if the stream port cannot be found. */
+	virtual bool capturePreset(QString const& name, la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::DescriptorType const streamPortType, la::avdecc::entity::model::StreamPortIndex const streamPortIndex) noexcept = 0;
+	virtual void removePreset(QString const& name) noexcept = 0;
+	/** Returns all presets, sorted by name */
+	virtual Presets getPresets() const noexcept = 0;
+	/** Returns the presets captured on entities of the specified model, sorted by name */
+	virtual Presets getPresets(la::avdecc::UniqueIdentifier const entityModelID) const noexcept = 0;
+
+	/** Sends the mappings needed for each of the specified entities to match the preset (removals before additions) */
+	virtual ApplyResult applyPreset(QString const& name, std::vector<la::avdecc::UniqueIdentifier> const& entityIDs) noexcept = 0;
+
+	Q_SIGNAL void presetsChanged();
+
+protected:
+	MappingPresetManager() = default;
+};
+
+} // namespace avdecc
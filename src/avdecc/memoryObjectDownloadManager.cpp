@@ -0,0 +1,376 @@
+/*
+* Copyright 2017-2018, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be usefu_state,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "memoryObjectDownloadManager.hpp"
+#include "controllerManager.hpp"
+#include <algorithm>
+#include <list>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace avdecc
+{
+
+class MemoryObjectDownloadManagerImpl final : public MemoryObjectDownloadManager
+{
+public:
+	MemoryObjectDownloadManagerImpl() noexcept
+	{
+		auto& manager = ControllerManager::getInstance();
+
+		// Interrupted downloads are kept to be resumed if the entity comes back
+		connect(&manager, &ControllerManager::entityOffline, this, [this](la::avdecc::UniqueIdentifier const entityID)
+		{
+			removeJobs(entityID, true);
+		});
+		connect(&manager, &ControllerManager::controllerOffline, this, [this]()
+		{
+			removeJobs({}, false);
+			_partials.clear();
+		});
+	}
+
+	virtual void download(la::avdecc::UniqueIdentifier const entityID, std::uint64_t const address, std::uint64_t const length, bool const stopAtPngEnd, CompletionHandler const& handler) noexcept override
+	{
+		// Merge with a download of the same area
+		for (auto& job : _jobs)
+		{
+			if (job->entityID == entityID && job->address == address && job->length == length && job->stopAtPngEnd == stopAtPngEnd)
+			{
+				job->handlers.push_back(handler);
+				return;
+			}
+		}
+
+		auto job = std::make_unique<Job>();
+		job->id = _nextJobID++;
+		job->entityID = entityID;
+		job->address = address;
+		job->length = length;
+		job->stopAtPngEnd = stopAtPngEnd;
+		job->handlers.push_back(handler);
+
+		// Resume a previously interrupted download
+		auto const partialIt = std::find_if(_partials.begin(), _partials.end(), [entityID, address, length](Partial const& partial)
+		{
+			return partial.entityID == entityID && partial.address == address && partial.length == length;
+		});
+		if (partialIt != _partials.end())
+		{
+			job->data = std::move(partialIt->data);
+			_partials.erase(partialIt);
+			if (stopAtPngEnd)
+			{
+				parsePng(*job);
+			}
+		}
+
+		_jobs.push_back(std::move(job));
+		schedule();
+	}
+
+	virtual void cancel(la::avdecc::UniqueIdentifier const entityID) noexcept override
+	{
+		removeJobs(entityID, false);
+		_partials.remove_if([entityID](Partial const& partial)
+		{
+			return partial.entityID == entityID;
+		});
+	}
+
+private:
+	static constexpr std::uint64_t ChunkSize = 1024; // Bytes per read command
+	static constexpr std::size_t MaxReadsInFlight = 8; // For all entities
+	static constexpr std::size_t MaxReadsInFlightPerEntity = 1;
+	static constexpr std::size_t MaxPartials = 64;
+
+	struct Job
+	{
+		std::uint64_t id{ 0u };
+		la::avdecc::UniqueIdentifier entityID{};
+		std::uint64_t address{ 0u };
+		std::uint64_t length{ 0u };
+		bool stopAtPngEnd{ false };
+		QByteArray data{};
+		std::uint64_t pngEnd{ 0u }; // Offset just after the IEND chunk, 0 if not found yet
+		std::uint64_t pngChunkOffset{ 8u }; // Offset of the next PNG chunk header to parse (right after the signature)
+		bool readInFlight{ false };
+		std::vector<CompletionHandler> handlers{};
+	};
+	using Jobs = std::list<std::unique_ptr<Job>>;
+
+	struct Partial
+	{
+		la::avdecc::UniqueIdentifier entityID{};
+		std::uint64_t address{ 0u };
+		std::uint64_t length{ 0u };
+		QByteArray data{};
+	};
+
+	/** Offset at which the download is complete */
+	static std::uint64_t endOffset(Job const& job) noexcept
+	{
+		if (job.pngEnd != 0u)
+		{
+			return std::min(job.pngEnd, job.length);
+		}
+		return job.length;
+	}
+
+	static std::uint32_t readBigEndian32(char const* const ptr) noexcept
+	{
+		auto const* const p = reinterpret_cast<std::uint8_t const*>(ptr);
+		return (static_cast<std::uint32_t>(p[0]) << 24) | (static_cast<std::uint32_t>(p[1]) << 16) | (static_cast<std::uint32_t>(p[2]) << 8) | static_cast<std::uint32_t>(p[3]);
+	}
+
+	/** Walks the PNG chunks read so far, looking for IEND. Returns false if the data is not a PNG */
+	static bool parsePng(Job& job) noexcept
+	{
+		static auto const s_Signature = QByteArray{ "\x89PNG\r\n\x1a\n", 8 };
+
+		auto const size = static_cast<std::uint64_t>(job.data.size());
+		if (size < 8u)
+		{
+			return true;
+		}
+		if (!job.data.startsWith(s_Signature))
+		{
+			return false;
+		}
+
+		// Chunk layout: Length (4) | Type (4) | Data (Length) | CRC (4)
+		while (job.pngEnd == 0u && job.pngChunkOffset + 8u <= size)
+		{
+			auto const* const header = job.data.constData() + job.pngChunkOffset;
+			auto const chunkEnd = job.pngChunkOffset + 12u + readBigEndian32(header);
+			if (std::equal(header + 4, header + 8, "IEND"))
+			{
+				job.pngEnd = chunkEnd;
+			}
+			job.pngChunkOffset = chunkEnd;
+		}
+
+		return true;
+	}
+
+	Jobs::iterator findJob(std::uint64_t const jobID) noexcept
+	{
+		return std::find_if(_jobs.begin(), _jobs.end(), [jobID](std::unique_ptr<Job> const& job)
+		{
+			return job->id == jobID;
+		});
+	}
+
+	void releaseRead(Job& job) noexcept
+	{
+		if (job.readInFlight)
+		{
+			job.readInFlight = false;
+			--_readsInFlight;
+			auto& entityReads = _readsInFlightPerEntity[job.entityID];
+			if (--entityReads == 0u)
+			{
+				_readsInFlightPerEntity.erase(job.entityID);
+			}
+		}
+	}
+
+	void keepPartial(Job& job) noexcept
+	{
+		if (job.data.isEmpty())
+		{
+			return;
+		}
+
+		_partials.push_back(Partial{ job.entityID, job.address, job.length, std::move(job.data) });
+		if (_partials.size() > MaxPartials)
+		{
+			_partials.pop_front();
+		}
+	}
+
+	/** Removes the job and calls its handlers */
+	void complete(Jobs::iterator const jobIt, Status const status) noexcept
+	{
+		auto job = std::move(*jobIt);
+		_jobs.erase(jobIt);
+		releaseRead(*job);
+
+		if (status == Status::Success)
+		{
+			job->data.truncate(static_cast<int>(endOffset(*job)));
+		}
+		else
+		{
+			keepPartial(*job);
+		}
+
+		// The job has been removed, handlers can safely start new downloads
+		for (auto const& handler : job->handlers)
+		{
+			la::avdecc::invokeProtectedHandler(handler, status, job->data);
+		}
+	}
+
+	/** Removes all the jobs of the specified entity (all entities if not valid) */
+	void removeJobs(la::avdecc::UniqueIdentifier const entityID, bool const keepPartials) noexcept
+	{
+		auto removed = Jobs{};
+		for (auto it = _jobs.begin(); it != _jobs.end();)
+		{
+			if (!entityID || (*it)->entityID == entityID)
+			{
+				releaseRead(**it);
+				removed.push_back(std::move(*it));
+				it = _jobs.erase(it);
+			}
+			else
+			{
+				++it;
+			}
+		}
+
+		for (auto& job : removed)
+		{
+			if (keepPartials)
+			{
+				keepPartial(*job);
+			}
+			for (auto const& handler : job->handlers)
+			{
+				la::avdecc::invokeProtectedHandler(handler, Status::Cancelled, QByteArray{});
+			}
+		}
+
+		schedule();
+	}
+
+	/** Starts reads for queued jobs, in queue order, while the limits allow it */
+	void schedule() noexcept
+	{
+		auto completedJobs = std::vector<std::uint64_t>{};
+
+		for (auto const& jobPtr : _jobs)
+		{
+			if (_readsInFlight >= MaxReadsInFlight)
+			{
+				break;
+			}
+
+			auto& job = *jobPtr;
+			if (job.readInFlight)
+			{
+				continue;
+			}
+
+			auto const entityReadsIt = _readsInFlightPerEntity.find(job.entityID);
+			if (entityReadsIt != _readsInFlightPerEntity.end() && entityReadsIt->second >= MaxReadsInFlightPerEntity)
+			{
+				continue;
+			}
+
+			auto const offset = static_cast<std::uint64_t>(job.data.size());
+			auto const end = endOffset(job);
+			if (offset >= end)
+			{
+				completedJobs.push_back(job.id);
+				continue;
+			}
+
+			readChunk(job, offset, std::min(ChunkSize, end - offset));
+		}
+
+		// Complete outside of the loop, handlers might queue or cancel downloads
+		for (auto const jobID : completedJobs)
+		{
+			auto const jobIt = findJob(jobID);
+			if (jobIt != _jobs.end())
+			{
+				complete(jobIt, Status::Success);
+			}
+		}
+	}
+
+	void readChunk(Job& job, std::uint64_t const offset, std::uint64_t const size) noexcept
+	{
+		job.readInFlight = true;
+		++_readsInFlight;
+		++_readsInFlightPerEntity[job.entityID];
+
+		auto& manager = ControllerManager::getInstance();
+		manager.readDeviceMemory(job.entityID, job.address + offset, size, [this, jobID = job.id](la::avdecc::controller::ControlledEntity const* const /*entity*/, la::avdecc::entity::ControllerEntity::AaCommandStatus const status, la::avdecc::controller::Controller::DeviceMemoryBuffer const& memoryBuffer)
+		{
+			auto data = QByteArray{ reinterpret_cast<char const*>(memoryBuffer.data()), static_cast<int>(memoryBuffer.size()) };
+
+			// Be sure to run this code in the UI thread so we don't have to lock the jobs
+			QMetaObject::invokeMethod(this, [this, jobID, status, data = std::move(data)]()
+			{
+				onChunkRead(jobID, status, data);
+			});
+		});
+	}
+
+	void onChunkRead(std::uint64_t const jobID, la::avdecc::entity::ControllerEntity::AaCommandStatus const status, QByteArray const& data) noexcept
+	{
+		auto const jobIt = findJob(jobID);
+		if (jobIt == _jobs.end())
+		{
+			// Job has been cancelled in the meantime
+			return;
+		}
+
+		auto& job = **jobIt;
+		releaseRead(job);
+
+		if (!status || data.isEmpty())
+		{
+			complete(jobIt, Status::Failed);
+		}
+		else
+		{
+			job.data.append(data);
+			if (job.stopAtPngEnd && !parsePng(job))
+			{
+				// Not a PNG, there is no point in reading further
+				job.data.clear();
+				complete(jobIt, Status::Failed);
+			}
+		}
+
+		// Will also complete the job if all the data have been read
+		schedule();
+	}
+
+	Jobs _jobs{}; // In request order
+	std::list<Partial> _partials{}; // Oldest first
+	std::uint64_t _nextJobID{ 0u };
+	std::size_t _readsInFlight{ 0u };
+	std::unordered_map<la::avdecc::UniqueIdentifier, std::size_t, la::avdecc::UniqueIdentifier::hash> _readsInFlightPerEntity{};
+};
+
+MemoryObjectDownloadManager& MemoryObjectDownloadManager::getInstance() noexcept
+{
+	static MemoryObjectDownloadManagerImpl s_MemoryObjectDownloadManager{};
+
+	return s_MemoryObjectDownloadManager;
+}
+
+} // namespace avdecc
@@ -0,0 +1,63 @@
+/*
+* Copyright 2017-2018, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be usefu_state,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#pragma once
+
+#include <la/avdecc/controller/avdeccController.hpp>
+#include <QObject>
+#include <QByteArray>
+#include <cstdint>
+#include <functional>
+
+namespace avdecc
+{
+
+/**
+* @brief Scheduler for memory object reads.
+* @details Reads are split into small chunks and the number of reads in flight is limited globally and per entity, so many downloads
+*          at once do not flood slow devices or the network. Downloads are cancelled when their entity goes offline, and the data already
+*          read is kept so the download resumes where it stopped when the same memory area is requested again.
+*          Must be used from the GUI thread, completion handlers are called from the GUI thread too.
+*/
+class MemoryObjectDownloadManager : public QObject
+{
+	Q_OBJECT
+public:
+	enum class Status
+	{
+		Success,
+		Failed,
+		Cancelled,
+	};
+
+	using CompletionHandler = std::function<void(Status const status, QByteArray const& data)>;
+
+	static MemoryObjectDownloadManager& getInstance() noexcept;
+
+	/** Queues a read of the specified memory area. If stopAtPngEnd is set, the read stops after the PNG IEND chunk instead of the full length. Requests for an area already being downloaded are merged. */
+	virtual void download(la::avdecc::UniqueIdentifier const entityID, std::uint64_t const address, std::uint64_t const length, bool const stopAtPngEnd, CompletionHandler const& handler) noexcept = 0;
+	/** Cancels all downloads for the specified entity (handlers are called with Status::Cancelled) */
+	virtual void cancel(la::avdecc::UniqueIdentifier const entityID) noexcept = 0;
+
+protected:
+	MemoryObjectDownloadManager() = default;
+};
+
+} // namespace avdecc
@@ -0,0 +1,533 @@
+/*
+* Copyright 2017-2018, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be usefu_state,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "memoryObjectTransferEngine.hpp"
+#include "controllerManager.hpp"
+#include <QCryptographicHash>
+#include <QElapsedTimer>
+#include <algorithm>
+#include <deque>
+#include <list>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace avdecc
+{
+
+class MemoryObjectTransferEngineImpl final : public MemoryObjectTransferEngine
+{
+public:
+	MemoryObjectTransferEngineImpl() noexcept
+	{
+		_clock.start();
+
+		auto& manager = ControllerManager::getInstance();
+		connect(&manager, &ControllerManager::entityOffline, this, [this](la::avdecc::UniqueIdentifier const entityID)
+		{
+			cancelTransfers(entityID);
+		});
+		connect(&manager, &ControllerManager::controllerOffline, this, [this]()
+		{
+			cancelTransfers({});
+		});
+	}
+
+	virtual TransferID read(la::avdecc::UniqueIdentifier const entityID, std::uint64_t const address, std::uint64_t const length, Options const& options, CompletionHandler const& handler) noexcept override
+	{
+		auto transfer = createTransfer(entityID, address, length, options, handler);
+		transfer->direction = Direction::Read;
+		transfer->data = QByteArray(static_cast<int>(length), '\0');
+		transfer->totalBytes = length;
+		return queueTransfer(std::move(transfer));
+	}
+
+	virtual TransferID write(la::avdecc::UniqueIdentifier const entityID, std::uint64_t const address, QByteArray const& data, Options const& options, CompletionHandler const& handler) noexcept override
+	{
+		return queueTransfer(createWriteTransfer(entityID, address, data, options, handler));
+	}
+
+	virtual TransferID writeMemoryObject(la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::MemoryObjectIndex const memoryObjectIndex, std::uint64_t const startAddress, QByteArray const& data, Options const& options, CompletionHandler const& handler) noexcept override
+	{
+		auto transfer = createWriteTransfer(entityID, startAddress, data, options, handler);
+		transfer->setMemoryObjectLength = true;
+		transfer->configurationIndex = configurationIndex;
+		transfer->memoryObjectIndex = memoryObjectIndex;
+		return queueTransfer(std::move(transfer));
+	}
+
+	virtual void cancel(TransferID const transferID) noexcept override
+	{
+		auto const transferIt = findTransfer(transferID);
+		if (transferIt != _transfers.end())
+		{
+			finish(transferIt, Status::Cancelled);
+		}
+	}
+
+private:
+	static constexpr std::size_t MaxActiveTransfers = 64;
+	static constexpr std::int64_t ProgressIntervalMs = 100;
+
+	enum class Direction
+	{
+		Read,
+		Write,
+	};
+
+	enum class Phase
+	{
+		Queued,
+		Transferring,
+		Verifying,
+		SettingLength,
+	};
+
+	struct Chunk
+	{
+		std::uint64_t offset{ 0u };
+		std::uint64_t size{ 0u };
+		std::uint32_t retries{ 0u };
+	};
+
+	struct Transfer
+	{
+		TransferID id{ 0u };
+		la::avdecc::UniqueIdentifier entityID{};
+		std::uint64_t address{ 0u };
+		std::uint64_t length{ 0u };
+		Options options{};
+		CompletionHandler handler{};
+		Direction direction{ Direction::Read };
+		Phase phase{ Phase::Queued };
+		QByteArray data{}; // Destination of reads, source of writes
+		QByteArray readBack{}; // Destination of verification reads
+
+		// Memory object upload
+		bool setMemoryObjectLength{ false };
+		la::avdecc::entity::model::ConfigurationIndex configurationIndex{ 0u };
+		la::avdecc::entity::model::MemoryObjectIndex memoryObjectIndex{ 0u };
+
+		std::deque<Chunk> pendingChunks{};
+		std::unordered_map<std::uint64_t, std::int64_t> inFlightChunks{}; // Chunk offset, time it was sent (ns)
+
+		// Congestion control
+		double window{ 1.0 };
+		double minRttNs{ 0.0 };
+		double smoothedRttNs{ 0.0 };
+
+		// Progress
+		std::uint64_t transferredBytes{ 0u };
+		std::uint64_t totalBytes{ 0u };
+		std::int64_t startedNs{ 0 };
+		std::int64_t lastProgressNs{ 0 };
+	};
+	using Transfers = std::list<std::unique_ptr<Transfer>>;
+
+	std::unique_ptr<Transfer> createTransfer(la::avdecc::UniqueIdentifier const entityID, std::uint64_t const address, std::uint64_t const length, Options const& options, CompletionHandler const& handler) noexcept
+	{
+		auto transfer = std::make_unique<Transfer>();
+		transfer->id = _nextTransferID++;
+		transfer->entityID = entityID;
+		transfer->address = address;
+		transfer->length = length;
+		transfer->options = options;
+		transfer->options.chunkSize = std::max<std::uint64_t>(1u, options.chunkSize);
+		transfer->options.maxWindow = std::max(1u, options.maxWindow);
+		transfer->handler = handler;
+		transfer->window = std::min<double>(std::max(1u, options.initialWindow), transfer->options.maxWindow);
+		return transfer;
+	}
+
+	std::unique_ptr<Transfer> createWriteTransfer(la::avdecc::UniqueIdentifier const entityID, std::uint64_t const address, QByteArray const& data, Options const& options, CompletionHandler const& handler) noexcept
+	{
+		auto const length = static_cast<std::uint64_t>(data.size());
+		auto transfer = createTransfer(entityID, address, length, options, handler);
+		transfer->direction = Direction::Write;
+		transfer->data = data;
+		// Verification reads everything back
+		transfer->totalBytes = options.verify ? 2u * length : length;
+		return transfer;
+	}
+
+	TransferID queueTransfer(std::unique_ptr<Transfer>&& transfer) noexcept
+	{
+		auto const transferID = transfer->id;
+		_transfers.push_back(std::move(transfer));
+		// Do not start it right away, the caller has to know the ID first (a transfer can complete synchronously)
+		QMetaObject::invokeMethod(this, [this]()
+		{
+			startQueuedTransfers();
+		}, Qt::QueuedConnection);
+		return transferID;
+	}
+
+	Transfers::iterator findTransfer(TransferID const transferID) noexcept
+	{
+		return std::find_if(_transfers.begin(), _transfers.end(), [transferID](std::unique_ptr<Transfer> const& transfer)
+		{
+			return transfer->id == transferID;
+		});
+	}
+
+	/** Starts queued transfers, one per entity at a time */
+	void startQueuedTransfers() noexcept
+	{
+		auto busyEntities = std::unordered_map<la::avdecc::UniqueIdentifier, bool, la::avdecc::UniqueIdentifier::hash>{};
+		auto activeTransfers = std::size_t{ 0u };
+		for (auto const& transfer : _transfers)
+		{
+			if (transfer->phase != Phase::Queued)
+			{
+				busyEntities[transfer->entityID] = true;
+				++activeTransfers;
+			}
+		}
+
+		auto toStart = std::vector<TransferID>{};
+		for (auto const& transfer : _transfers)
+		{
+			if (activeTransfers >= MaxActiveTransfers)
+			{
+				break;
+			}
+			if (transfer->phase == Phase::Queued && !busyEntities[transfer->entityID])
+			{
+				busyEntities[transfer->entityID] = true;
+				++activeTransfers;
+				toStart.push_back(transfer->id);
+			}
+		}
+
+		for (auto const transferID : toStart)
+		{
+			auto const transferIt = findTransfer(transferID);
+			if (transferIt != _transfers.end())
+			{
+				auto& transfer = **transferIt;
+				transfer.startedNs = _clock.nsecsElapsed();
+				startPhase(transfer, Phase::Transferring);
+				pump(transferID);
+			}
+		}
+	}
+
+	void startPhase(Transfer& transfer, Phase const phase) noexcept
+	{
+		transfer.phase = phase;
+		transfer.pendingChunks.clear();
+		transfer.inFlightChunks.clear();
+
+		if (phase == Phase::Verifying)
+		{
+			transfer.readBack = QByteArray(static_cast<int>(transfer.length), '\0');
+		}
+
+		for (auto offset = std::uint64_t{ 0u }; offset < transfer.length; offset += transfer.options.chunkSize)
+		{
+			transfer.pendingChunks.push_back(Chunk{ offset, std::min(transfer.options.chunkSize, transfer.length - offset), 0u });
+		}
+	}
+
+	/** Fills the window with pending chunks, or ends the current phase */
+	void pump(TransferID const transferID) noexcept
+	{
+		auto const transferIt = findTransfer(transferID);
+		if (transferIt == _transfers.end())
+		{
+			return;
+		}
+		auto& transfer = **transferIt;
+
+		while (!transfer.pendingChunks.empty() && transfer.inFlightChunks.size() < static_cast<std::size_t>(transfer.window))
+		{
+			auto const chunk = transfer.pendingChunks.front();
+			transfer.pendingChunks.pop_front();
+			sendChunk(transfer, chunk);
+		}
+
+		if (transfer.pendingChunks.empty() && transfer.inFlightChunks.empty())
+		{
+			phaseCompleted(transferIt);
+		}
+	}
+
+	void sendChunk(Transfer& transfer, Chunk const& chunk) noexcept
+	{
+		auto& manager = ControllerManager::getInstance();
+		auto const phase = transfer.phase;
+		auto const sentNs = _clock.nsecsElapsed();
+		transfer.inFlightChunks[chunk.offset] = sentNs;
+
+		if (transfer.direction == Direction::Write && phase == Phase::Transferring)
+		{
+			auto buffer = la::avdecc::controller::Controller::DeviceMemoryBuffer{ transfer.data.constData() + chunk.offset, static_cast<std::size_t>(chunk.size) };
+			manager.writeDeviceMemory(transfer.entityID, transfer.address + chunk.offset, std::move(buffer), [this, transferID = transfer.id, phase, chunk](la::avdecc::controller::ControlledEntity const* const /*entity*/, la::avdecc::entity::ControllerEntity::AaCommandStatus const status)
+			{
+				// Be sure to run this code in the UI thread so we don't have to lock the transfers
+				QMetaObject::invokeMethod(this, [this, transferID, phase, chunk, status]()
+				{
+					onChunkCompleted(transferID, phase, chunk, status, {});
+				});
+			});
+		}
+		else
+		{
+			manager.readDeviceMemory(transfer.entityID, transfer.address + chunk.offset, chunk.size, [this, transferID = transfer.id, phase, chunk](la::avdecc::controller::ControlledEntity const* const /*entity*/, la::avdecc::entity::ControllerEntity::AaCommandStatus const status, la::avdecc::controller::Controller::DeviceMemoryBuffer const& memoryBuffer)
+			{
+				auto data = QByteArray{ reinterpret_cast<char const*>(memoryBuffer.data()), static_cast<int>(memoryBuffer.size()) };
+
+				// Be sure to run this code in the UI thread so we don't have to lock the transfers
+				QMetaObject::invokeMethod(this, [this, transferID, phase, chunk, status, data = std::move(data)]()
+				{
+					onChunkCompleted(transferID, phase, chunk, status, data);
+				});
+			});
+		}
+	}
+
+	void onChunkCompleted(TransferID const transferID, Phase const phase, Chunk chunk, la::avdecc::entity::ControllerEntity::AaCommandStatus const status, QByteArray const& data) noexcept
+	{
+		auto const transferIt = findTransfer(transferID);
+		if (transferIt == _transfers.end() || (*transferIt)->phase != phase)
+		{
+			// Transfer has been cancelled in the meantime
+			return;
+		}
+		auto& transfer = **transferIt;
+
+		auto const inFlightIt = transfer.inFlightChunks.find(chunk.offset);
+		if (inFlightIt == transfer.inFlightChunks.end())
+		{
+			return;
+		}
+		auto const rttNs = static_cast<double>(_clock.nsecsElapsed() - inFlightIt->second);
+		transfer.inFlightChunks.erase(inFlightIt);
+
+		auto const isRead = transfer.direction == Direction::Read || phase == Phase::Verifying;
+		auto const success = !!status && (!isRead || !data.isEmpty());
+		updateWindow(transfer, success, rttNs);
+
+		if (!success)
+		{
+			if (chunk.retries >= transfer.options.maxRetries)
+			{
+				finish(transferIt, Status::Failed);
+				return;
+			}
+			++chunk.retries;
+			transfer.pendingChunks.push_front(chunk);
+		}
+		else
+		{
+			auto doneBytes = chunk.size;
+			if (isRead)
+			{
+				auto& destination = phase == Phase::Verifying ? transfer.readBack : transfer.data;
+				doneBytes = std::min(chunk.size, static_cast<std::uint64_t>(data.size()));
+				std::copy(data.constBegin(), data.constBegin() + doneBytes, destination.begin() + chunk.offset);
+
+				// Short read, request the remaining bytes
+				if (doneBytes < chunk.size)
+				{
+					transfer.pendingChunks.push_front(Chunk{ chunk.offset + doneBytes, chunk.size - doneBytes, 0u });
+				}
+			}
+			transfer.transferredBytes += doneBytes;
+			reportProgress(transfer, false);
+		}
+
+		pump(transferID);
+	}
+
+	/** Additive increase while the round-trip time stays close to the best one, multiplicative decrease on latency build-up or failure */
+	static void updateWindow(Transfer& transfer, bool const success, double const rttNs) noexcept
+	{
+		auto const maxWindow = static_cast<double>(transfer.options.maxWindow);
+
+		if (!success)
+		{
+			transfer.window = std::max(1.0, transfer.window / 2.0);
+			return;
+		}
+
+		if (transfer.minRttNs == 0.0 || rttNs < transfer.minRttNs)
+		{
+			transfer.minRttNs = rttNs;
+		}
+		transfer.smoothedRttNs = transfer.smoothedRttNs == 0.0 ? rttNs : (transfer.smoothedRttNs * 7.0 + rttNs) / 8.0;
+
+		if (transfer.smoothedRttNs > 2.0 * transfer.minRttNs)
+		{
+			// Device (or network) is queuing our commands, back off
+			transfer.window = std::max(1.0, transfer.window * 0.75);
+		}
+		else
+		{
+			// Grows by about one command per round trip
+			transfer.window = std::min(maxWindow, transfer.window + 1.0 / transfer.window);
+		}
+	}
+
+	void reportProgress(Transfer& transfer, bool const force) noexcept
+	{
+		auto const nowNs = _clock.nsecsElapsed();
+		if (!force && (nowNs - transfer.lastProgressNs) < ProgressIntervalMs * 1000000)
+		{
+			return;
+		}
+		transfer.lastProgressNs = nowNs;
+
+		auto progress = Progress{};
+		progress.transferredBytes = transfer.transferredBytes;
+		progress.totalBytes = transfer.totalBytes;
+		progress.window = static_cast<std::uint32_t>(transfer.window);
+		progress.verifying = transfer.phase == Phase::Verifying;
+
+		auto const elapsedSeconds = static_cast<double>(nowNs - transfer.startedNs) / 1e9;
+		if (elapsedSeconds > 0.0 && transfer.transferredBytes > 0u)
+		{
+			progress.bytesPerSecond = static_cast<double>(transfer.transferredBytes) / elapsedSeconds;
+			progress.remainingMs = static_cast<std::int64_t>(static_cast<double>(transfer.totalBytes - transfer.transferredBytes) * 1000.0 / progress.bytesPerSecond);
+		}
+
+		emit transferProgress(transfer.id, transfer.entityID, progress);
+	}
+
+	void phaseCompleted(Transfers::iterator const transferIt) noexcept
+	{
+		auto& transfer = **transferIt;
+
+		if (transfer.direction == Direction::Write)
+		{
+			if (transfer.phase == Phase::Transferring && transfer.options.verify && transfer.length != 0u)
+			{
+				startPhase(transfer, Phase::Verifying);
+				pump(transfer.id);
+				return;
+			}
+			if (transfer.phase == Phase::Verifying && computeChecksum(transfer.readBack) != computeChecksum(transfer.data))
+			{
+				finish(transferIt, Status::VerifyFailed);
+				return;
+			}
+			if (transfer.setMemoryObjectLength)
+			{
+				sendMemoryObjectLength(transfer);
+				return;
+			}
+		}
+		else if (transfer.options.verify && !transfer.options.expectedChecksum.isEmpty() && computeChecksum(transfer.data) != transfer.options.expectedChecksum)
+		{
+			finish(transferIt, Status::VerifyFailed);
+			return;
+		}
+
+		finish(transferIt, Status::Success);
+	}
+
+	/** Last step of a memory object upload, so the device reports the length of the data written */
+	void sendMemoryObjectLength(Transfer& transfer) noexcept
+	{
+		transfer.phase = Phase::SettingLength;
+		ControllerManager::getInstance().setMemoryObjectLength(transfer.entityID, transfer.configurationIndex, transfer.memoryObjectIndex, transfer.length, [this, transferID = transfer.id](la::avdecc::controller::ControlledEntity const* const /*entity*/, la::avdecc::entity::ControllerEntity::AemCommandStatus const status)
+		{
+			// Be sure to run this code in the UI thread so we don't have to lock the transfers
+			QMetaObject::invokeMethod(this, [this, transferID, status]()
+			{
+				auto const transferIt = findTransfer(transferID);
+				if (transferIt == _transfers.end() || (*transferIt)->phase != Phase::SettingLength)
+				{
+					// Transfer has been cancelled in the meantime
+					return;
+				}
+				finish(transferIt, !!status ? Status::Success : Status::Failed);
+			});
+		});
+	}
+
+	/** Removes the transfer, notifies and starts the next queued transfers */
+	void finish(Transfers::iterator const transferIt, Status const status) noexcept
+	{
+		auto transfer = std::move(*transferIt);
+		_transfers.erase(transferIt);
+
+		// Late answers for in-flight chunks are ignored as the transfer cannot be found anymore
+		reportProgress(*transfer, true);
+		emit transferCompleted(transfer->id, transfer->entityID, status);
+		la::avdecc::invokeProtectedHandler(transfer->handler, transfer->id, status, transfer->data);
+
+		startQueuedTransfers();
+	}
+
+	/** Cancels all transfers of the specified entity (all entities if not valid) */
+	void cancelTransfers(la::avdecc::UniqueIdentifier const entityID) noexcept
+	{
+		auto toCancel = std::vector<TransferID>{};
+		for (auto const& transfer : _transfers)
+		{
+			if (!entityID || transfer->entityID == entityID)
+			{
+				toCancel.push_back(transfer->id);
+			}
+		}
+
+		for (auto const transferID : toCancel)
+		{
+			cancel(transferID);
+		}
+	}
+
+	Transfers _transfers{}; // In request order
+	TransferID _nextTransferID{ InvalidTransferID + 1u };
+	QElapsedTimer _clock{};
+};
+
+QByteArray MemoryObjectTransferEngine::computeChecksum(QByteArray const& data) noexcept
+{
+	return QCryptographicHash::hash(data, QCryptographicHash::Sha256);
+}
+
+QString MemoryObjectTransferEngine::statusToString(Status const status) noexcept
+{
+	switch (status)
+	{
+		case Status::Success:
+			return "Success";
+		case Status::Failed:
+			return "Failed";
+		case Status::Cancelled:
+			return "Cancelled";
+		case Status::VerifyFailed:
+			return "Verification failed";
+		default:
+			AVDECC_ASSERT(false, "Not handled!");
+			return "Unknown";
+	}
+}
+
+MemoryObjectTransferEngine& MemoryObjectTransferEngine::getInstance() noexcept
+{
+	static MemoryObjectTransferEngineImpl s_MemoryObjectTransferEngine{};
+
+	return s_MemoryObjectTransferEngine;
+}
+
+} // namespace avdecc
@@ -0,0 +1,97 @@
+/*
+* Copyright 2017-2018, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be usefu_state,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#pragma once
+
+#include <la/avdecc/controller/avdeccController.hpp>
+#include <QObject>
+#include <QByteArray>
+#include <cstdint>
+#include <functional>
+
+namespace avdecc
+{
+
+/**
+* @brief Pipelined memory object reads and writes, for firmware images and other large blobs.
+* @details Each transfer keeps a sliding window of AA commands in flight. The window grows while the measured round-trip time stays close
+*          to the best one seen, and shrinks when it degrades or a command fails. Failed chunks are retried, and written data can be read back
+*          and verified. Transfers to different entities run in parallel, transfers to the same entity are queued.
+*          Must be used from the GUI thread, handlers are called and signals are emitted from the GUI thread too.
+*/
+class MemoryObjectTransferEngine : public QObject
+{
+	Q_OBJECT
+public:
+	using TransferID = std::uint64_t;
+	static constexpr TransferID InvalidTransferID = 0u; /**< Never returned by read or write */
+
+	enum class Status
+	{
+		Success,
+		Failed,
+		Cancelled,
+		VerifyFailed,
+	};
+
+	struct Options
+	{
+		std::uint64_t chunkSize{ 512u }; /**< Bytes per AA command */
+		std::uint32_t initialWindow{ 2u }; /**< Commands in flight when the transfer starts */
+		std::uint32_t maxWindow{ 16u }; /**< Maximum commands in flight */
+		std::uint32_t maxRetries{ 3u }; /**< Retries per chunk before the transfer fails */
+		bool verify{ true }; /**< For writes, read back and compare the data. For reads, compare with expectedChecksum (if not empty) */
+		QByteArray expectedChecksum{}; /**< Expected computeChecksum() of the data read */
+	};
+
+	struct Progress
+	{
+		std::uint64_t transferredBytes{ 0u }; /**< Including verification */
+		std::uint64_t totalBytes{ 0u }; /**< Including verification */
+		double bytesPerSecond{ 0.0 };
+		std::int64_t remainingMs{ -1 }; /**< -1 if unknown */
+		std::uint32_t window{ 0u };
+		bool verifying{ false };
+	};
+
+	/** Data is the memory read for read transfers, the data written for write transfers */
+	using CompletionHandler = std::function<void(TransferID const transferID, Status const status, QByteArray const& data)>;
+
+	static MemoryObjectTransferEngine& getInstance() noexcept;
+
+	/** Checksum used for verification (SHA-256) */
+	static QByteArray computeChecksum(QByteArray const& data) noexcept;
+	static QString statusToString(Status const status) noexcept;
+
+	/** Queues a transfer and returns its ID. Transfers are started from the event loop, so no handler is called nor signal emitted for the transfer before its ID is returned */
+	virtual TransferID read(la::avdecc::UniqueIdentifier const entityID, std::uint64_t const address, std::uint64_t const length, Options const& options, CompletionHandler const& handler) noexcept = 0;
+	virtual TransferID write(la::avdecc::UniqueIdentifier const entityID, std::uint64_t const address, QByteArray const& data, Options const& options, CompletionHandler const& handler) noexcept = 0;
+	/** Uploads the data to a memory object (at its startAddress), then sets the length of the memory object to the size of the data. The transfer fails if the length cannot be set */
+	virtual TransferID writeMemoryObject(la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::MemoryObjectIndex const memoryObjectIndex, std::uint64_t const startAddress, QByteArray const& data, Options const& options, CompletionHandler const& handler) noexcept = 0;
+	virtual void cancel(TransferID const transferID) noexcept = 0;
+
+	Q_SIGNAL void transferProgress(avdecc::MemoryObjectTransferEngine::TransferID const transferID, la::avdecc::UniqueIdentifier const entityID, avdecc::MemoryObjectTransferEngine::Progress const& progress);
+	Q_SIGNAL void transferCompleted(avdecc::MemoryObjectTransferEngine::TransferID const transferID, la::avdecc::UniqueIdentifier const entityID, avdecc::MemoryObjectTransferEngine::Status const status);
+
+protected:
+	MemoryObjectTransferEngine() = default;
+};
+
+} // namespace avdecc
@@ -0,0 +1,1204 @@
+/*
+* Copyright 2017-2018, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be usefu_state,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "networkSnapshotManager.hpp"
+#include "controllerManager.hpp"
+#include "helper.hpp"
+#include "hiveLogItems.hpp"
+
+#include <QByteArray>
+#include <QDataStream>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+#include <QTimer>
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <iterator>
+#include <map>
+#include <set>
+#include <tuple>
+
+namespace avdecc
+{
+namespace
+{
+// Header of the snapshot files
+constexpr std::uint32_t SnapshotMagic = 0x48534E50; // "HSNP"
+constexpr std::uint32_t SnapshotVersion = 1u;
+
+// Maximum time to wait for the commands of a restore phase, commands are considered lost after that
+constexpr auto RestorePhaseTimeout = std::chrono::seconds{ 30 };
+
+using Section = NetworkSnapshot::Section;
+
+bool isMappingLess(la::avdecc::entity::model::AudioMapping const& lhs, la::avdecc::entity::model::AudioMapping const& rhs) noexcept
+{
+	return std::tie(lhs.streamIndex, lhs.streamChannel, lhs.clusterOffset, lhs.clusterChannel) < std::tie(rhs.streamIndex, rhs.streamChannel, rhs.clusterOffset, rhs.clusterChannel);
+}
+
+/** Returns the mappings in lhs that are not in rhs (both sorted) */
+la::avdecc::entity::model::AudioMappings substractMappings(la::avdecc::entity::model::AudioMappings const& lhs, la::avdecc::entity::model::AudioMappings const& rhs) noexcept
+{
+	auto difference = la::avdecc::entity::model::AudioMappings{};
+	std::set_difference(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), std::back_inserter(difference), &isMappingLess);
+	return difference;
+}
+
+/* Serialization */
+void writeStreams(QDataStream& stream, std::vector<NetworkSnapshot::StreamState> const& streams, bool const writeNames, bool const writeFormats)
+{
+	stream << static_cast<quint32>(streams.size());
+	for (auto const& s : streams)
+	{
+		stream << static_cast<quint16>(s.streamIndex);
+		if (writeNames)
+		{
+			stream << s.name;
+		}
+		if (writeFormats)
+		{
+			stream << static_cast<quint64>(s.format);
+		}
+	}
+}
+
+void readStreams(QDataStream& stream, std::vector<NetworkSnapshot::StreamState>& streams)
+{
+	auto count = quint32{ 0u };
+	stream >> count;
+	for (auto i = quint32{ 0u }; i < count && stream.status() == QDataStream::Ok; ++i)
+	{
+		auto s = NetworkSnapshot::StreamState{};
+		auto streamIndex = quint16{ 0u };
+		auto format = quint64{ 0u };
+		stream >> streamIndex >> s.name >> format;
+		s.streamIndex = static_cast<la::avdecc::entity::model::StreamIndex>(streamIndex);
+		s.format = static_cast<la::avdecc::entity::model::StreamFormat>(format);
+		streams.push_back(std::move(s));
+	}
+}
+
+/** Writes a section of the entity. Used both for the files and to compute the section hashes */
+void writeSection(QDataStream& stream, NetworkSnapshot::Entity const& entity, Section const section)
+{
+	switch (section)
+	{
+		case Section::Names:
+			stream << entity.entityName << entity.groupName;
+			writeStreams(stream, entity.streamInputs, true, false);
+			writeStreams(stream, entity.streamOutputs, true, false);
+			break;
+		case Section::Clocks:
+			stream << static_cast<quint32>(entity.samplingRates.size());
+			for (auto const& samplingRate : entity.samplingRates)
+			{
+				stream << static_cast<quint16>(samplingRate.audioUnitIndex) << static_cast<quint32>(samplingRate.samplingRate);
+			}
+			stream << static_cast<quint32>(entity.clockSources.size());
+			for (auto const& clockSource : entity.clockSources)
+			{
+				stream << static_cast<quint16>(clockSource.clockDomainIndex) << static_cast<quint16>(clockSource.clockSourceIndex);
+			}
+			break;
+		case Section::StreamFormats:
+			writeStreams(stream, entity.streamInputs, false, true);
+			writeStreams(stream, entity.streamOutputs, false, true);
+			break;
+		case Section::AudioMappings:
+			stream << static_cast<quint32>(entity.streamPortMappings.size());
+			for (auto const& streamPort : entity.streamPortMappings)
+			{
+				stream << static_cast<quint16>(la::avdecc::to_integral(streamPort.streamPortType)) << static_cast<quint16>(streamPort.streamPortIndex) << static_cast<quint32>(streamPort.mappings.size());
+				for (auto const& mapping : streamPort.mappings)
+				{
+					stream << static_cast<quint16>(mapping.streamIndex) << static_cast<quint16>(mapping.streamChannel) << static_cast<quint16>(mapping.clusterOffset) << static_cast<quint16>(mapping.clusterChannel);
+				}
+			}
+			break;
+		case Section::Connections:
+			stream << static_cast<quint32>(entity.connections.size());
+			for (auto const& connection : entity.connections)
+			{
+				stream << static_cast<quint16>(connection.listenerStreamIndex) << static_cast<quint64>(connection.talkerEntityID.getValue()) << static_cast<quint16>(connection.talkerStreamIndex);
+			}
+			break;
+		default:
+			AVDECC_ASSERT(false, "Not handled!");
+			break;
+	}
+}
+
+void writeEntity(QDataStream& stream, NetworkSnapshot::Entity const& entity)
+{
+	stream << static_cast<quint64>(entity.entityID.getValue()) << static_cast<quint64>(entity.entityModelID.getValue()) << static_cast<quint16>(entity.configurationIndex);
+	stream << entity.entityName << entity.groupName;
+	writeStreams(stream, entity.streamInputs, true, true);
+	writeStreams(stream, entity.streamOutputs, true, true);
+	for (auto const section : { Section::Clocks, Section::AudioMappings, Section::Connections })
+	{
+		writeSection(stream, entity, section);
+	}
+}
+
+void readEntity(QDataStream& stream, NetworkSnapshot::Entity& entity)
+{
+	auto entityID = quint64{ 0u };
+	auto entityModelID = quint64{ 0u };
+	auto configurationIndex = quint16{ 0u };
+	stream >> entityID >> entityModelID >> configurationIndex >> entity.entityName >> entity.groupName;
+	entity.entityID = la::avdecc::UniqueIdentifier{ entityID };
+	entity.entityModelID = la::avdecc::UniqueIdentifier{ entityModelID };
+	entity.configurationIndex = static_cast<la::avdecc::entity::model::ConfigurationIndex>(configurationIndex);
+	readStreams(stream, entity.streamInputs);
+	readStreams(stream, entity.streamOutputs);
+
+	// Clocks
+	auto count = quint32{ 0u };
+	stream >> count;
+	for (auto i = quint32{ 0u }; i < count && stream.status() == QDataStream::Ok; ++i)
+	{
+		auto audioUnitIndex = quint16{ 0u };
+		auto samplingRate = quint32{ 0u };
+		stream >> audioUnitIndex >> samplingRate;
+		entity.samplingRates.push_back({ static_cast<la::avdecc::entity::model::AudioUnitIndex>(audioUnitIndex), static_cast<la::avdecc::entity::model::SamplingRate>(samplingRate) });
+	}
+	stream >> count;
+	for (auto i = quint32{ 0u }; i < count && stream.status() == QDataStream::Ok; ++i)
+	{
+		auto clockDomainIndex = quint16{ 0u };
+		auto clockSourceIndex = quint16{ 0u };
+		stream >> clockDomainIndex >> clockSourceIndex;
+		entity.clockSources.push_back({ static_cast<la::avdecc::entity::model::ClockDomainIndex>(clockDomainIndex), static_cast<la::avdecc::entity::model::ClockSourceIndex>(clockSourceIndex) });
+	}
+
+	// Audio mappings
+	stream >> count;
+	for (auto i = quint32{ 0u }; i < count && stream.status() == QDataStream::Ok; ++i)
+	{
+		auto streamPort = NetworkSnapshot::StreamPortMappings{};
+		auto streamPortType = quint16{ 0u };
+		auto streamPortIndex = quint16{ 0u };
+		auto mappingsCount = quint32{ 0u };
+		stream >> streamPortType >> streamPortIndex >> mappingsCount;
+		streamPort.streamPortType = static_cast<la::avdecc::entity::model::DescriptorType>(streamPortType);
+		streamPort.streamPortIndex = static_cast<la::avdecc::entity::model::StreamPortIndex>(streamPortIndex);
+		for (auto m = quint32{ 0u }; m < mappingsCount && stream.status() == QDataStream::Ok; ++m)
+		{
+			auto mapping = la::avdecc::entity::model::AudioMapping{};
+			stream >> mapping.streamIndex >> mapping.streamChannel >> mapping.clusterOffset >> mapping.clusterChannel;
+			streamPort.mappings.push_back(mapping);
+		}
+		std::sort(streamPort.mappings.begin(), streamPort.mappings.end(), &isMappingLess);
+		entity.streamPortMappings.push_back(std::move(streamPort));
+	}
+
+	// Connections
+	stream >> count;
+	for (auto i = quint32{ 0u }; i < count && stream.status() == QDataStream::Ok; ++i)
+	{
+		auto listenerStreamIndex = quint16{ 0u };
+		auto talkerEntityID = quint64{ 0u };
+		auto talkerStreamIndex = quint16{ 0u };
+		stream >> listenerStreamIndex >> talkerEntityID >> talkerStreamIndex;
+		entity.connections.push_back({ static_cast<la::avdecc::entity::model::StreamIndex>(listenerStreamIndex), la::avdecc::UniqueIdentifier{ talkerEntityID }, static_cast<la::avdecc::entity::model::StreamIndex>(talkerStreamIndex) });
+	}
+}
+
+/** FNV-1a hash of the serialized section */
+std::uint64_t hashSection(NetworkSnapshot::Entity const& entity, Section const section) noexcept
+{
+	auto bytes = QByteArray{};
+	{
+		QDataStream stream(&bytes, QIODevice::WriteOnly);
+		writeSection(stream, entity, section);
+	}
+
+	auto hash = std::uint64_t{ 0xcbf29ce484222325ull };
+	for (auto const byte : bytes)
+	{
+		hash ^= static_cast<std::uint8_t>(byte);
+		hash *= 0x100000001b3ull;
+	}
+	return hash;
+}
+
+void computeSectionHashes(NetworkSnapshot::Entity& entity, NetworkSnapshot::Sections const sections) noexcept
+{
+	for (auto index = std::size_t{ 0u }; index < NetworkSnapshot::SectionsCount; ++index)
+	{
+		if (sections.test(index))
+		{
+			entity.sectionHashes[index] = hashSection(entity, static_cast<Section>(index));
+		}
+	}
+}
+
+/* Capture */
+template<class StreamNodes>
+std::vector<NetworkSnapshot::StreamState> captureStreams(StreamNodes const& streamNodes)
+{
+	auto streams = std::vector<NetworkSnapshot::StreamState>{};
+	streams.reserve(streamNodes.size());
+	for (auto const& [streamIndex, streamNode] : streamNodes)
+	{
+		streams.push_back({ streamIndex, streamNode.dynamicModel->objectName.data(), streamNode.dynamicModel->currentFormat });
+	}
+	return streams;
+}
+
+template<class StreamPortNodes>
+void captureStreamPorts(StreamPortNodes const& streamPortNodes, la::avdecc::entity::model::DescriptorType const streamPortType, std::vector<NetworkSnapshot::StreamPortMappings>& streamPortMappings)
+{
+	for (auto const& [streamPortIndex, streamPortNode] : streamPortNodes)
+	{
+		// Only dynamic mappings can be changed
+		if (!streamPortNode.staticModel->hasDynamicAudioMap)
+		{
+			continue;
+		}
+		auto mappings = streamPortNode.dynamicModel->dynamicAudioMap;
+		std::sort(mappings.begin(), mappings.end(), &isMappingLess);
+		streamPortMappings.push_back({ streamPortType, streamPortIndex, std::move(mappings) });
+	}
+}
+
+/** Listener streams connected (or fast connecting) to a talker */
+template<class StreamInputNodes>
+std::vector<NetworkSnapshot::ListenerConnection> captureConnections(StreamInputNodes const& streamInputNodes)
+{
+	auto connections = std::vector<NetworkSnapshot::ListenerConnection>{};
+	for (auto const& [streamIndex, streamNode] : streamInputNodes)
+	{
+		auto const& connectionState = streamNode.dynamicModel->connectionState;
+		// A fast connecting listener will connect by itself as soon as its talker is back
+		if (connectionState.state == la::avdecc::controller::model::StreamConnectionState::State::Connected || connectionState.state == la::avdecc::controller::model::StreamConnectionState::State::FastConnecting)
+		{
+			connections.push_back({ streamIndex, connectionState.talkerStream.entityID, connectionState.talkerStream.streamIndex });
+		}
+	}
+	return connections;
+}
+
+/** Captures the identity of the entity and the specified sections, other sections are left empty */
+std::optional<NetworkSnapshot::Entity> captureEntity(la::avdecc::controller::ControlledEntity const& controlledEntity, NetworkSnapshot::Sections const sections) noexcept
+{
+	auto const hasSection = [&sections](Section const section)
+	{
+		return sections.test(static_cast<std::size_t>(section));
+	};
+
+	try
+	{
+		auto const& entityNode = controlledEntity.getEntityNode();
+		auto const& configurationNode = controlledEntity.getConfigurationNode(entityNode.dynamicModel->currentConfiguration);
+
+		auto entity = NetworkSnapshot::Entity{};
+		entity.entityID = controlledEntity.getEntity().getEntityID();
+		entity.entityModelID = controlledEntity.getEntity().getEntityModelID();
+		entity.configurationIndex = entityNode.dynamicModel->currentConfiguration;
+		if (hasSection(Section::Names))
+		{
+			entity.entityName = entityNode.dynamicModel->entityName.data();
+			entity.groupName = entityNode.dynamicModel->groupName.data();
+		}
+		// Streams hold both their name and their format
+		if (hasSection(Section::Names) || hasSection(Section::StreamFormats))
+		{
+			entity.streamInputs = captureStreams(configurationNode.streamInputs);
+			entity.streamOutputs = captureStreams(configurationNode.streamOutputs);
+		}
+
+		if (hasSection(Section::Clocks) || hasSection(Section::AudioMappings))
+		{
+			for (auto const& [audioUnitIndex, audioUnitNode] : configurationNode.audioUnits)
+			{
+				if (hasSection(Section::Clocks))
+				{
+					entity.samplingRates.push_back({ audioUnitIndex, audioUnitNode.dynamicModel->currentSamplingRate });
+				}
+				if (hasSection(Section::AudioMappings))
+				{
+					captureStreamPorts(audioUnitNode.streamPortInputs, la::avdecc::entity::model::DescriptorType::StreamPortInput, entity.streamPortMappings);
+					captureStreamPorts(audioUnitNode.streamPortOutputs, la::avdecc::entity::model::DescriptorType::StreamPortOutput, entity.streamPortMappings);
+				}
+			}
+		}
+		if (hasSection(Section::Clocks))
+		{
+			for (auto const& [clockDomainIndex, clockDomainNode] : configurationNode.clockDomains)
+			{
+				entity.clockSources.push_back({ clockDomainIndex, clockDomainNode.dynamicModel->clockSourceIndex });
+			}
+		}
+
+		if (hasSection(Section::Connections))
+		{
+			entity.connections = captureConnections(configurationNode.streamInputs);
+		}
+
+		computeSectionHashes(entity, sections);
+		return entity;
+	}
+	catch (...)
+	{
+		return std::nullopt;
+	}
+}
+
+/* JSON export */
+QJsonArray streamsToJson(std::vector<NetworkSnapshot::StreamState> const& streams)
+{
+	auto array = QJsonArray{};
+	for (auto const& s : streams)
+	{
+		array.append(QJsonObject{ { "index", s.streamIndex }, { "name", s.name }, { "format", helper::toHexQString(s.format, true, true) } });
+	}
+	return array;
+}
+
+QJsonObject entityToJson(NetworkSnapshot::Entity const& entity)
+{
+	auto samplingRates = QJsonArray{};
+	for (auto const& samplingRate : entity.samplingRates)
+	{
+		samplingRates.append(QJsonObject{ { "audioUnitIndex", samplingRate.audioUnitIndex }, { "samplingRate", static_cast<qint64>(samplingRate.samplingRate) } });
+	}
+
+	auto clockSources = QJsonArray{};
+	for (auto const& clockSource : entity.clockSources)
+	{
+		clockSources.append(QJsonObject{ { "clockDomainIndex", clockSource.clockDomainIndex }, { "clockSourceIndex", clockSource.clockSourceIndex } });
+	}
+
+	auto streamPorts = QJsonArray{};
+	for (auto const& streamPort : entity.streamPortMappings)
+	{
+		auto mappings = QJsonArray{};
+		for (auto const& mapping : streamPort.mappings)
+		{
+			mappings.append(QJsonArray{ mapping.streamIndex, mapping.streamChannel, mapping.clusterOffset, mapping.clusterChannel });
+		}
+		auto const isInput = streamPort.streamPortType == la::avdecc::entity::model::DescriptorType::StreamPortInput;
+		streamPorts.append(QJsonObject{ { "type", isInput ? "input" : "output" }, { "index", streamPort.streamPortIndex }, { "mappings", mappings } });
+	}
+
+	auto connections = QJsonArray{};
+	for (auto const& connection : entity.connections)
+	{
+		connections.append(QJsonObject{ { "listenerStreamIndex", connection.listenerStreamIndex }, { "talkerEntityID", helper::uniqueIdentifierToString(connection.talkerEntityID) }, { "talkerStreamIndex", connection.talkerStreamIndex } });
+	}
+
+	return QJsonObject{
+		{ "entityID", helper::uniqueIdentifierToString(entity.entityID) },
+		{ "entityModelID", helper::uniqueIdentifierToString(entity.entityModelID) },
+		{ "configurationIndex", entity.configurationIndex },
+		{ "entityName", entity.entityName },
+		{ "groupName", entity.groupName },
+		{ "streamInputs", streamsToJson(entity.streamInputs) },
+		{ "streamOutputs", streamsToJson(entity.streamOutputs) },
+		{ "samplingRates", samplingRates },
+		{ "clockSources", clockSources },
+		{ "streamPortMappings", streamPorts },
+		{ "connections", connections },
+	};
+}
+
+} // namespace
+
+class NetworkSnapshotManagerImpl final : public NetworkSnapshotManager
+{
+public:
+	NetworkSnapshotManagerImpl() noexcept
+	{
+		auto& manager = ControllerManager::getInstance();
+
+		connect(&manager, &ControllerManager::controllerOffline, this, [this]()
+		{
+			finishRestore();
+		});
+		connect(&manager, &ControllerManager::endAecpCommand, this, &NetworkSnapshotManagerImpl::aecpCommandCompleted);
+		connect(&manager, &ControllerManager::endAcmpCommand, this, &NetworkSnapshotManagerImpl::acmpCommandCompleted);
+
+		_phaseTimer.setSingleShot(true);
+		connect(&_phaseTimer, &QTimer::timeout, this, [this]()
+		{
+			// Some responses were lost, consider the pending commands as failed and move on
+			for (auto const& [command, count] : _pendingCommands)
+			{
+				_failedCommands += count;
+			}
+			_pendingCommands.clear();
+			nextPhase();
+		});
+	}
+
+private:
+	enum class RestorePhase
+	{
+		Idle = 0,
+		AcmpDisconnect,
+		Aecp,
+		AcmpConnect,
+	};
+
+	struct ConnectionChange
+	{
+		la::avdecc::UniqueIdentifier listenerEntityID{};
+		la::avdecc::entity::model::StreamIndex listenerStreamIndex{ 0u };
+		la::avdecc::UniqueIdentifier disconnectTalkerEntityID{}; // Invalid if the listener stream is not connected
+		la::avdecc::entity::model::StreamIndex disconnectTalkerStreamIndex{ 0u };
+		la::avdecc::UniqueIdentifier connectTalkerEntityID{}; // Invalid if the listener stream must stay disconnected
+		la::avdecc::entity::model::StreamIndex connectTalkerStreamIndex{ 0u };
+	};
+
+	struct AecpCommand
+	{
+		la::avdecc::UniqueIdentifier entityID{};
+		ControllerManager::AecpCommandType commandType{ ControllerManager::AecpCommandType::None };
+		std::function<void()> send{};
+	};
+
+	using OnlineEntities = std::set<la::avdecc::UniqueIdentifier>;
+	using TalkerStreams = std::set<std::pair<la::avdecc::UniqueIdentifier, la::avdecc::entity::model::StreamIndex>>;
+
+	/** A command sent by the restore: the entity it is sent to (the listener for ACMP commands), its type and the listener stream index (ACMP only) */
+	using PendingCommand = std::tuple<la::avdecc::UniqueIdentifier, int, la::avdecc::entity::model::StreamIndex>;
+	using PendingCommands = std::map<PendingCommand, std::size_t>;
+
+	static PendingCommand makePendingCommand(la::avdecc::UniqueIdentifier const entityID, ControllerManager::AecpCommandType const commandType) noexcept
+	{
+		return { entityID, static_cast<int>(commandType), la::avdecc::entity::model::StreamIndex{ 0u } };
+	}
+
+	static PendingCommand makePendingCommand(la::avdecc::UniqueIdentifier const listenerEntityID, la::avdecc::entity::model::StreamIndex const listenerStreamIndex, ControllerManager::AcmpCommandType const commandType) noexcept
+	{
+		return { listenerEntityID, static_cast<int>(commandType), listenerStreamIndex };
+	}
+
+	static OnlineEntities getOnlineEntities() noexcept
+	{
+		auto const entities = ControllerManager::getInstance().getOnlineEntities();
+		return { entities.begin(), entities.end() };
+	}
+
+	// NetworkSnapshotManager overrides
+	virtual NetworkSnapshot capture() const noexcept override
+	{
+		auto& manager = ControllerManager::getInstance();
+
+		auto const onlineEntities = manager.getOnlineEntities();
+
+		auto snapshot = NetworkSnapshot{};
+		snapshot.captureTime = QDateTime::currentDateTime();
+		snapshot.entities.reserve(onlineEntities.size());
+		for (auto const& entityID : onlineEntities) // Sorted, so entities are sorted
+		{
+			auto controlledEntity = manager.getControlledEntity(entityID);
+			if (controlledEntity)
+			{
+				if (auto entity = captureEntity(*controlledEntity, NetworkSnapshot::AllSections))
+				{
+					snapshot.entities.push_back(std::move(*entity));
+				}
+			}
+		}
+		return snapshot;
+	}
+
+	virtual Diff diff(NetworkSnapshot const& snapshot, NetworkSnapshot::Sections const sections) const noexcept override
+	{
+		auto const onlineEntities = getOnlineEntities();
+
+		auto result = Diff{};
+		for (auto const& entity : snapshot.entities)
+		{
+			auto const liveEntity = captureLiveEntity(onlineEntities, entity.entityID, sections);
+			if (!liveEntity)
+			{
+				result.offlineEntities.push_back(entity.entityID);
+				continue;
+			}
+			if (liveEntity->entityModelID != entity.entityModelID || liveEntity->configurationIndex != entity.configurationIndex)
+			{
+				result.incompatibleEntities.push_back(entity.entityID);
+				continue;
+			}
+
+			auto entityDiff = EntityDiff{ entity.entityID };
+			auto isChanged = false;
+			for (auto index = std::size_t{ 0u }; index < NetworkSnapshot::SectionsCount; ++index)
+			{
+				entityDiff.changedSections[index] = sections.test(index) && liveEntity->sectionHashes[index] != entity.sectionHashes[index];
+				isChanged |= entityDiff.changedSections[index];
+			}
+
+			if (isChanged)
+			{
+				result.changedEntities.push_back(entityDiff);
+			}
+			else
+			{
+				++result.upToDateEntities;
+			}
+		}
+		return result;
+	}
+
+	virtual RestoreResult restore(NetworkSnapshot const& snapshot) noexcept override
+	{
+		auto result = RestoreResult{};
+
+		if (_phase != RestorePhase::Idle)
+		{
+			LOG_HIVE_WARN("A network snapshot is already being restored");
+			return result;
+		}
+
+		auto const onlineEntities = getOnlineEntities();
+
+		// Compute all the changes first, so no entity is locked while commands are being sent
+		auto& aecpCommands = _aecpCommands;
+		aecpCommands.clear();
+		_connectionChanges.clear();
+		auto formatChangingTalkerStreams = TalkerStreams{};
+		for (auto const& entity : snapshot.entities)
+		{
+			auto const liveEntity = captureLiveEntity(onlineEntities, entity.entityID, NetworkSnapshot::AllSections);
+			if (!liveEntity || liveEntity->entityModelID != entity.entityModelID || liveEntity->configurationIndex != entity.configurationIndex)
+			{
+				continue;
+			}
+
+			auto const commandsCount = aecpCommands.size();
+			auto const connectionsCount = _connectionChanges.size();
+			auto const isChanged = [&entity, &liveEntity](Section const section)
+			{
+				auto const index = static_cast<std::size_t>(section);
+				return liveEntity->sectionHashes[index] != entity.sectionHashes[index];
+			};
+
+			// Clocks first, changing them can reset the stream formats on some devices
+			if (isChanged(Section::Clocks))
+			{
+				addClockCommands(entity, *liveEntity, aecpCommands);
+			}
+			if (isChanged(Section::StreamFormats))
+			{
+				addStreamFormatCommands(entity, *liveEntity, aecpCommands);
+				forEachStream(entity.streamOutputs, liveEntity->streamOutputs, [&formatChangingTalkerStreams, entityID = entity.entityID](auto const& s, auto const& liveStream)
+				{
+					if (s.format != liveStream.format)
+					{
+						formatChangingTalkerStreams.insert({ entityID, s.streamIndex });
+					}
+				});
+			}
+			if (isChanged(Section::Names))
+			{
+				addNameCommands(entity, *liveEntity, aecpCommands);
+			}
+			if (isChanged(Section::AudioMappings))
+			{
+				addAudioMappingsCommands(entity, *liveEntity, aecpCommands);
+			}
+			// A listener stream cannot change its format while connected, it is reconnected around the AECP phase
+			if (isChanged(Section::Connections) || isChanged(Section::StreamFormats))
+			{
+				addConnectionChanges(entity, *liveEntity, onlineEntities);
+			}
+
+			if (aecpCommands.size() != commandsCount || _connectionChanges.size() != connectionsCount)
+			{
+				++result.restoredEntities;
+			}
+		}
+		if (!formatChangingTalkerStreams.empty())
+		{
+			addTalkerFormatConnectionChanges(formatChangingTalkerStreams, onlineEntities);
+		}
+
+		result.aecpCommands = aecpCommands.size();
+		for (auto const& change : _connectionChanges)
+		{
+			result.acmpCommands += static_cast<std::size_t>(change.disconnectTalkerEntityID.isValid()) + static_cast<std::size_t>(change.connectTalkerEntityID.isValid());
+		}
+
+		if (aecpCommands.empty() && _connectionChanges.empty())
+		{
+			emit restoreCompleted(0u);
+			return result;
+		}
+
+		LOG_HIVE_INFO(QString("Restoring network snapshot: %1 entities, %2 AECP and %3 ACMP commands").arg(result.restoredEntities).arg(result.aecpCommands).arg(result.acmpCommands));
+
+		// Commands are asynchronous and queued per entity: all entities are processed in parallel during each phase
+		_failedCommands = 0u;
+		startPhase(RestorePhase::AcmpDisconnect);
+
+		return result;
+	}
+
+	virtual bool isRestoring() const noexcept override
+	{
+		return _phase != RestorePhase::Idle;
+	}
+
+	// Private methods
+	static std::optional<NetworkSnapshot::Entity> captureLiveEntity(OnlineEntities const& onlineEntities, la::avdecc::UniqueIdentifier const entityID, NetworkSnapshot::Sections const sections) noexcept
+	{
+		if (onlineEntities.count(entityID) == 0)
+		{
+			return std::nullopt;
+		}
+		auto controlledEntity = ControllerManager::getInstance().getControlledEntity(entityID);
+		if (!controlledEntity)
+		{
+			return std::nullopt;
+		}
+		return captureEntity(*controlledEntity, sections);
+	}
+
+	static void addClockCommands(NetworkSnapshot::Entity const& entity, NetworkSnapshot::Entity const& liveEntity, std::vector<AecpCommand>& commands) noexcept
+	{
+		auto& manager = ControllerManager::getInstance();
+		auto const entityID = entity.entityID;
+
+		for (auto const& samplingRate : entity.samplingRates)
+		{
+			auto const it = std::find_if(liveEntity.samplingRates.begin(), liveEntity.samplingRates.end(), [&samplingRate](auto const& s)
+			{
+				return s.audioUnitIndex == samplingRate.audioUnitIndex;
+			});
+			if (it != liveEntity.samplingRates.end() && it->samplingRate != samplingRate.samplingRate)
+			{
+				commands.push_back({ entityID, ControllerManager::AecpCommandType::SetSamplingRate, [&manager, entityID, samplingRate]()
+				{
+					manager.setAudioUnitSamplingRate(entityID, samplingRate.audioUnitIndex, samplingRate.samplingRate);
+				} });
+			}
+		}
+
+		for (auto const& clockSource : entity.clockSources)
+		{
+			auto const it = std::find_if(liveEntity.clockSources.begin(), liveEntity.clockSources.end(), [&clockSource](auto const& c)
+			{
+				return c.clockDomainIndex == clockSource.clockDomainIndex;
+			});
+			if (it != liveEntity.clockSources.end() && it->clockSourceIndex != clockSource.clockSourceIndex)
+			{
+				commands.push_back({ entityID, ControllerManager::AecpCommandType::SetClockSource, [&manager, entityID, clockSource]()
+				{
+					manager.setClockSource(entityID, clockSource.clockDomainIndex, clockSource.clockSourceIndex);
+				} });
+			}
+		}
+	}
+
+	/** Calls the handler for each stream of the snapshot that also exists on the live entity */
+	template<class Handler>
+	static void forEachStream(std::vector<NetworkSnapshot::StreamState> const& streams, std::vector<NetworkSnapshot::StreamState> const& liveStreams, Handler&& handler) noexcept
+	{
+		// Both lists are sorted by stream index
+		auto liveIt = liveStreams.begin();
+		for (auto const& s : streams)
+		{
+			while (liveIt != liveStreams.end() && liveIt->streamIndex < s.streamIndex)
+			{
+				++liveIt;
+			}
+			if (liveIt != liveStreams.end() && liveIt->streamIndex == s.streamIndex)
+			{
+				handler(s, *liveIt);
+			}
+		}
+	}
+
+	static void addStreamFormatCommands(NetworkSnapshot::Entity const& entity, NetworkSnapshot::Entity const& liveEntity, std::vector<AecpCommand>& commands) noexcept
+	{
+		auto& manager = ControllerManager::getInstance();
+		auto const entityID = entity.entityID;
+
+		forEachStream(entity.streamInputs, liveEntity.streamInputs, [&manager, &commands, entityID](auto const& s, auto const& liveStream)
+		{
+			if (s.format != liveStream.format)
+			{
+				commands.push_back({ entityID, ControllerManager::AecpCommandType::SetStreamFormat, [&manager, entityID, streamIndex = s.streamIndex, format = s.format]()
+				{
+					manager.setStreamInputFormat(entityID, streamIndex, format);
+				} });
+			}
+		});
+		forEachStream(entity.streamOutputs, liveEntity.streamOutputs, [&manager, &commands, entityID](auto const& s, auto const& liveStream)
+		{
+			if (s.format != liveStream.format)
+			{
+				commands.push_back({ entityID, ControllerManager::AecpCommandType::SetStreamFormat, [&manager, entityID, streamIndex = s.streamIndex, format = s.format]()
+				{
+					manager.setStreamOutputFormat(entityID, streamIndex, format);
+				} });
+			}
+		});
+	}
+
+	static void addNameCommands(NetworkSnapshot::Entity const& entity, NetworkSnapshot::Entity const& liveEntity, std::vector<AecpCommand>& commands) noexcept
+	{
+		auto& manager = ControllerManager::getInstance();
+		auto const entityID = entity.entityID;
+		auto const configurationIndex = entity.configurationIndex;
+
+		if (entity.entityName != liveEntity.entityName)
+		{
+			commands.push_back({ entityID, ControllerManager::AecpCommandType::SetEntityName, [&manager, entityID, name = entity.entityName]()
+			{
+				manager.setEntityName(entityID, name);
+			} });
+		}
+		if (entity.groupName != liveEntity.groupName)
+		{
+			commands.push_back({ entityID, ControllerManager::AecpCommandType::SetEntityGroupName, [&manager, entityID, name = entity.groupName]()
+			{
+				manager.setEntityGroupName(entityID, name);
+			} });
+		}
+		forEachStream(entity.streamInputs, liveEntity.streamInputs, [&manager, &commands, entityID, configurationIndex](auto const& s, auto const& liveStream)
+		{
+			if (s.name != liveStream.name)
+			{
+				commands.push_back({ entityID, ControllerManager::AecpCommandType::SetStreamName, [&manager, entityID, configurationIndex, streamIndex = s.streamIndex, name = s.name]()
+				{
+					manager.setStreamInputName(entityID, configurationIndex, streamIndex, name);
+				} });
+			}
+		});
+		forEachStream(entity.streamOutputs, liveEntity.streamOutputs, [&manager, &commands, entityID, configurationIndex](auto const& s, auto const& liveStream)
+		{
+			if (s.name != liveStream.name)
+			{
+				commands.push_back({ entityID, ControllerManager::AecpCommandType::SetStreamName, [&manager, entityID, configurationIndex, streamIndex = s.streamIndex, name = s.name]()
+				{
+					manager.setStreamOutputName(entityID, configurationIndex, streamIndex, name);
+				} });
+			}
+		});
+	}
+
+	static void addAudioMappingsCommands(NetworkSnapshot::Entity const& entity, NetworkSnapshot::Entity const& liveEntity, std::vector<AecpCommand>& commands) noexcept
+	{
+		auto& manager = ControllerManager::getInstance();
+		auto const entityID = entity.entityID;
+
+		for (auto const& streamPort : entity.streamPortMappings)
+		{
+			auto const it = std::find_if(liveEntity.streamPortMappings.begin(), liveEntity.streamPortMappings.end(), [&streamPort](auto const& s)
+			{
+				return s.streamPortType == streamPort.streamPortType && s.streamPortIndex == streamPort.streamPortIndex;
+			});
+			if (it == liveEntity.streamPortMappings.end())
+			{
+				continue;
+			}
+
+			// Removals before additions, a stream channel can only be mapped once
+			auto const isInput = streamPort.streamPortType == la::avdecc::entity::model::DescriptorType::StreamPortInput;
+			auto const streamPortIndex = streamPort.streamPortIndex;
+			if (auto toRemove = substractMappings(it->mappings, streamPort.mappings); !toRemove.empty())
+			{
+				commands.push_back({ entityID, ControllerManager::AecpCommandType::RemoveStreamPortAudioMappings, [&manager, entityID, isInput, streamPortIndex, mappings = std::move(toRemove)]()
+				{
+					if (isInput)
+					{
+						manager.removeStreamPortInputAudioMappings(entityID, streamPortIndex, mappings);
+					}
+					else
+					{
+						manager.removeStreamPortOutputAudioMappings(entityID, streamPortIndex, mappings);
+					}
+				} });
+			}
+			if (auto toAdd = substractMappings(streamPort.mappings, it->mappings); !toAdd.empty())
+			{
+				commands.push_back({ entityID, ControllerManager::AecpCommandType::AddStreamPortAudioMappings, [&manager, entityID, isInput, streamPortIndex, mappings = std::move(toAdd)]()
+				{
+					if (isInput)
+					{
+						manager.addStreamPortInputAudioMappings(entityID, streamPortIndex, mappings);
+					}
+					else
+					{
+						manager.addStreamPortOutputAudioMappings(entityID, streamPortIndex, mappings);
+					}
+				} });
+			}
+		}
+	}
+
+	void addConnectionChanges(NetworkSnapshot::Entity const& entity, NetworkSnapshot::Entity const& liveEntity, OnlineEntities const& onlineEntities) noexcept
+	{
+		auto const findConnection = [](std::vector<NetworkSnapshot::ListenerConnection> const& connections, la::avdecc::entity::model::StreamIndex const listenerStreamIndex) -> NetworkSnapshot::ListenerConnection const*
+		{
+			auto const it = std::find_if(connections.begin(), connections.end(), [listenerStreamIndex](auto const& c)
+			{
+				return c.listenerStreamIndex == listenerStreamIndex;
+			});
+			return it != connections.end() ? &*it : nullptr;
+		};
+
+		auto const isFormatChanged = [&entity](NetworkSnapshot::StreamState const& liveStream)
+		{
+			auto const it = std::find_if(entity.streamInputs.begin(), entity.streamInputs.end(), [&liveStream](auto const& s)
+			{
+				return s.streamIndex == liveStream.streamIndex;
+			});
+			return it != entity.streamInputs.end() && it->format != liveStream.format;
+		};
+
+		for (auto const& liveStream : liveEntity.streamInputs)
+		{
+			auto const* const connection = findConnection(entity.connections, liveStream.streamIndex);
+			auto const* const liveConnection = findConnection(liveEntity.connections, liveStream.streamIndex);
+
+			auto change = ConnectionChange{ entity.entityID, liveStream.streamIndex };
+			// An unchanged connection is still disconnected then reconnected if the format of the listener changes
+			if (connection && liveConnection && connection->talkerEntityID == liveConnection->talkerEntityID && connection->talkerStreamIndex == liveConnection->talkerStreamIndex && !isFormatChanged(liveStream))
+			{
+				continue;
+			}
+			if (liveConnection)
+			{
+				change.disconnectTalkerEntityID = liveConnection->talkerEntityID;
+				change.disconnectTalkerStreamIndex = liveConnection->talkerStreamIndex;
+			}
+			// The listener cannot connect to an offline talker
+			if (connection && onlineEntities.count(connection->talkerEntityID) != 0)
+			{
+				change.connectTalkerEntityID = connection->talkerEntityID;
+				change.connectTalkerStreamIndex = connection->talkerStreamIndex;
+			}
+			if (change.disconnectTalkerEntityID.isValid() || change.connectTalkerEntityID.isValid())
+			{
+				_connectionChanges.push_back(change);
+			}
+		}
+	}
+
+	/** Listeners connected to a talker stream that changes its format are disconnected around the AECP phase, then connected back to it */
+	void addTalkerFormatConnectionChanges(TalkerStreams const& talkerStreams, OnlineEntities const& onlineEntities) noexcept
+	{
+		auto& manager = ControllerManager::getInstance();
+
+		// Listeners can be any online entity, not only the ones of the snapshot
+		for (auto const& listenerEntityID : onlineEntities)
+		{
+			auto controlledEntity = manager.getControlledEntity(listenerEntityID);
+			if (!controlledEntity)
+			{
+				continue;
+			}
+
+			try
+			{
+				auto const& entityNode = controlledEntity->getEntityNode();
+				auto const& configurationNode = controlledEntity->getConfigurationNode(entityNode.dynamicModel->currentConfiguration);
+				for (auto const& connection : captureConnections(configurationNode.streamInputs))
+				{
+					if (talkerStreams.count({ connection.talkerEntityID, connection.talkerStreamIndex }) == 0)
+					{
+						continue;
+					}
+
+					// Already disconnected by the changes of the listener itself
+					auto const changeIt = std::find_if(_connectionChanges.begin(), _connectionChanges.end(), [listenerEntityID, &connection](auto const& c)
+					{
+						return c.listenerEntityID == listenerEntityID && c.listenerStreamIndex == connection.listenerStreamIndex;
+					});
+					if (changeIt != _connectionChanges.end())
+					{
+						continue;
+					}
+
+					_connectionChanges.push_back({ listenerEntityID, connection.listenerStreamIndex, connection.talkerEntityID, connection.talkerStreamIndex, connection.talkerEntityID, connection.talkerStreamIndex });
+				}
+			}
+			catch (...)
+			{
+				// Entity without valid configuration, it has no connection to restore
+			}
+		}
+	}
+
+	/** Sends the commands of the phase, all of them are counted as pending before the first one is sent */
+	void startPhase(RestorePhase const phase) noexcept
+	{
+		auto& manager = ControllerManager::getInstance();
+
+		_phase = phase;
+		_pendingCommands.clear();
+
+		switch (phase)
+		{
+			case RestorePhase::AcmpDisconnect:
+				// Listeners are disconnected before their format changes, and before they are connected to another talker stream
+				for (auto const& change : _connectionChanges)
+				{
+					if (change.disconnectTalkerEntityID.isValid())
+					{
+						++_pendingCommands[makePendingCommand(change.listenerEntityID, change.listenerStreamIndex, ControllerManager::AcmpCommandType::DisconnectStream)];
+					}
+				}
+				for (auto const& change : _connectionChanges)
+				{
+					if (change.disconnectTalkerEntityID.isValid())
+					{
+						manager.disconnectStream(change.disconnectTalkerEntityID, change.disconnectTalkerStreamIndex, change.listenerEntityID, change.listenerStreamIndex);
+					}
+				}
+				break;
+			case RestorePhase::Aecp:
+				for (auto const& command : _aecpCommands)
+				{
+					++_pendingCommands[makePendingCommand(command.entityID, command.commandType)];
+				}
+				for (auto const& command : _aecpCommands)
+				{
+					command.send();
+				}
+				_aecpCommands.clear();
+				break;
+			case RestorePhase::AcmpConnect:
+				for (auto const& change : _connectionChanges)
+				{
+					if (change.connectTalkerEntityID.isValid())
+					{
+						++_pendingCommands[makePendingCommand(change.listenerEntityID, change.listenerStreamIndex, ControllerManager::AcmpCommandType::ConnectStream)];
+					}
+				}
+				for (auto const& change : _connectionChanges)
+				{
+					if (change.connectTalkerEntityID.isValid())
+					{
+						manager.connectStream(change.connectTalkerEntityID, change.connectTalkerStreamIndex, change.listenerEntityID, change.listenerStreamIndex);
+					}
+				}
+				_connectionChanges.clear();
+				break;
+			default:
+				break;
+		}
+
+		if (_pendingCommands.empty())
+		{
+			nextPhase();
+		}
+		else if (_phase == phase)
+		{
+			_phaseTimer.start(RestorePhaseTimeout);
+		}
+	}
+
+	void nextPhase() noexcept
+	{
+		switch (_phase)
+		{
+			case RestorePhase::AcmpDisconnect:
+				startPhase(RestorePhase::Aecp);
+				break;
+			case RestorePhase::Aecp:
+				startPhase(RestorePhase::AcmpConnect);
+				break;
+			default:
+				finishRestore();
+				break;
+		}
+	}
+
+	void finishRestore() noexcept
+	{
+		if (_phase == RestorePhase::Idle)
+		{
+			return;
+		}
+
+		_phase = RestorePhase::Idle;
+		_phaseTimer.stop();
+		_pendingCommands.clear();
+		_aecpCommands.clear();
+		_connectionChanges.clear();
+
+		LOG_HIVE_INFO(QString("Network snapshot restored, %1 commands failed").arg(_failedCommands));
+		emit restoreCompleted(_failedCommands);
+	}
+
+	/** Counts a completed command of the current phase, moving to the next phase when all commands completed */
+	void commandCompleted(PendingCommand const& command, bool const succeeded) noexcept
+	{
+		// Commands not sent by the restore (from other views, or from another controller) are ignored
+		auto const it = _pendingCommands.find(command);
+		if (it == _pendingCommands.end())
+		{
+			return;
+		}
+
+		if (!succeeded)
+		{
+			++_failedCommands;
+		}
+		if (--it->second == 0u)
+		{
+			_pendingCommands.erase(it);
+			if (_pendingCommands.empty())
+			{
+				nextPhase();
+			}
+		}
+	}
+
+	void aecpCommandCompleted(la::avdecc::UniqueIdentifier const entityID, ControllerManager::AecpCommandType const commandType, la::avdecc::entity::ControllerEntity::AemCommandStatus const status) noexcept
+	{
+		if (_phase == RestorePhase::Aecp)
+		{
+			commandCompleted(makePendingCommand(entityID, commandType), status == la::avdecc::entity::ControllerEntity::AemCommandStatus::Success);
+		}
+	}
+
+	void acmpCommandCompleted(la::avdecc::UniqueIdentifier const /*talkerEntityID*/, la::avdecc::entity::model::StreamIndex const /*talkerStreamIndex*/, la::avdecc::UniqueIdentifier const listenerEntityID, la::avdecc::entity::model::StreamIndex const listenerStreamIndex, ControllerManager::AcmpCommandType const commandType, la::avdecc::entity::ControllerEntity::ControlStatus const status) noexcept
+	{
+		if (_phase == RestorePhase::AcmpDisconnect || _phase == RestorePhase::AcmpConnect)
+		{
+			commandCompleted(makePendingCommand(listenerEntityID, listenerStreamIndex, commandType), status == la::avdecc::entity::ControllerEntity::ControlStatus::Success);
+		}
+	}
+
+	// Private members
+	RestorePhase _phase{ RestorePhase::Idle };
+	PendingCommands _pendingCommands{}; // Commands of the current phase not completed yet
+	std::vector<AecpCommand> _aecpCommands{}; // Sent once all disconnections completed
+	std::vector<ConnectionChange> _connectionChanges{}; // Disconnections sent first, connections sent once all AECP commands completed
+	std::size_t _failedCommands{ 0u };
+	QTimer _phaseTimer{};
+};
+
+NetworkSnapshotManager& NetworkSnapshotManager::getInstance() noexcept
+{
+	static NetworkSnapshotManagerImpl s_NetworkSnapshotManager{};
+
+	return s_NetworkSnapshotManager;
+}
+
+bool NetworkSnapshotManager::save(NetworkSnapshot const& snapshot, QString const& filePath) noexcept
+{
+	QSaveFile file(filePath);
+	if (!file.open(QIODevice::WriteOnly))
+	{
+		return false;
+	}
+
+	QDataStream stream(&file);
+	stream << SnapshotMagic << SnapshotVersion << snapshot.captureTime << static_cast<quint32>(snapshot.entities.size());
+	for (auto const& entity : snapshot.entities)
+	{
+		writeEntity(stream, entity);
+	}
+
+	return stream.status() == QDataStream::Ok && file.commit();
+}
+
+std::optional<NetworkSnapshot> NetworkSnapshotManager::load(QString const& filePath) noexcept
+{
+	QFile file(filePath);
+	if (!file.open(QIODevice::ReadOnly))
+	{
+		return std::nullopt;
+	}
+
+	QDataStream stream(&file);
+	auto magic = std::uint32_t{ 0u };
+	auto version = std::uint32_t{ 0u };
+	stream >> magic >> version;
+	if (magic != SnapshotMagic || version != SnapshotVersion)
+	{
+		return std::nullopt;
+	}
+
+	auto snapshot = NetworkSnapshot{};
+	auto count = quint32{ 0u };
+	stream >> snapshot.captureTime >> count;
+	for (auto i = quint32{ 0u }; i < count && stream.status() == QDataStream::Ok; ++i)
+	{
+		auto entity = NetworkSnapshot::Entity{};
+		readEntity(stream, entity);
+		computeSectionHashes(entity, NetworkSnapshot::AllSections);
+		snapshot.entities.push_back(std::move(entity));
+	}
+
+	if (stream.status() != QDataStream::Ok)
+	{
+		return std::nullopt;
+	}
+
+	std::sort(snapshot.entities.begin(), snapshot.entities.end(), [](auto const& lhs, auto const& rhs)
+	{
+		return lhs.entityID.getValue() < rhs.entityID.getValue();
+	});
+	return snapshot;
+}
+
+bool NetworkSnapshotManager::exportJson(NetworkSnapshot const& snapshot, QString const& filePath) noexcept
+{
+	auto entities = QJsonArray{};
+	for (auto const& entity : snapshot.entities)
+	{
+		entities.append(entityToJson(entity));
+	}
+	auto const root = QJsonObject{ { "version", static_cast<int>(SnapshotVersion) }, { "captureTime", snapshot.captureTime.toString(Qt::ISODate) }, { "entities", entities } };
+
+	QSaveFile file(filePath);
+	if (!file.open(QIODevice::WriteOnly))
+	{
+		return false;
+	}
+	file.write(QJsonDocument{ root }.toJson());
+	return file.commit();
+}
+
+QString NetworkSnapshotManager::sectionName(NetworkSnapshot::Section const section) noexcept
+{
+	switch (section)
+	{
+		case Section::Names:
+			return "Names";
+		case Section::Clocks:
+			return "Clocks";
+		case Section::StreamFormats:
+			return "Stream Formats";
+		case Section::AudioMappings:
+			return "Audio Mappings";
+		case Section::Connections:
+			return "Connections";
+		default:
+			AVDECC_ASSERT(false, "Not handled!");
+			return "Unknown";
+	}
+}
+
+} // namespace avdecc
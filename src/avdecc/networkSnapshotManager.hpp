@@ -0,0 +1,167 @@
+/*
+* Copyright 2017-2018, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be usefu_state,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <la/avdecc/controller/avdeccController.hpp>
+#include <QDateTime>
+#include <QObject>
+#include <QString>
+#include <array>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace avdecc
+{
+
+/** State of the entities of the network, captured from the controlled entities so it can be restored later (a "show file") */
+struct NetworkSnapshot
+{
+	/** Parts of an entity state, each one hashed separately so unchanged parts are skipped when diffing */
+	enum class Section
+	{
+		Names = 0,
+		Clocks,
+		StreamFormats,
+		AudioMappings,
+		Connections,
+
+		Count
+	};
+	static constexpr auto SectionsCount = static_cast<std::size_t>(Section::Count);
+	using Sections = std::bitset<SectionsCount>; // Indexed by Section
+	static constexpr auto AllSections = Sections{ (1ull << SectionsCount) - 1u };
+
+	struct StreamState
+	{
+		la::avdecc::entity::model::StreamIndex streamIndex{ 0u };
+		QString name{};
+		la::avdecc::entity::model::StreamFormat format{};
+	};
+
+	struct SamplingRateState
+	{
+		la::avdecc::entity::model::AudioUnitIndex audioUnitIndex{ 0u };
+		la::avdecc::entity::model::SamplingRate samplingRate{};
+	};
+
+	struct ClockSourceState
+	{
+		la::avdecc::entity::model::ClockDomainIndex clockDomainIndex{ 0u };
+		la::avdecc::entity::model::ClockSourceIndex clockSourceIndex{ 0u };
+	};
+
+	struct StreamPortMappings
+	{
+		la::avdecc::entity::model::DescriptorType streamPortType{ la::avdecc::entity::model::DescriptorType::Entity };
+		la::avdecc::entity::model::StreamPortIndex streamPortIndex{ 0u };
+		la::avdecc::entity::model::AudioMappings mappings{}; // Sorted
+	};
+
+	/** A listener stream connected (or fast connecting) to a talker stream. Listener streams without connection are not connected */
+	struct ListenerConnection
+	{
+		la::avdecc::entity::model::StreamIndex listenerStreamIndex{ 0u };
+		la::avdecc::UniqueIdentifier talkerEntityID{};
+		la::avdecc::entity::model::StreamIndex talkerStreamIndex{ 0u };
+	};
+
+	struct Entity
+	{
+		la::avdecc::UniqueIdentifier entityID{};
+		la::avdecc::UniqueIdentifier entityModelID{};
+		la::avdecc::entity::model::ConfigurationIndex configurationIndex{ 0u };
+		QString entityName{};
+		QString groupName{};
+		std::vector<StreamState> streamInputs{};
+		std::vector<StreamState> streamOutputs{};
+		std::vector<SamplingRateState> samplingRates{};
+		std::vector<ClockSourceState> clockSources{};
+		std::vector<StreamPortMappings> streamPortMappings{};
+		std::vector<ListenerConnection> connections{};
+		std::array<std::uint64_t, SectionsCount> sectionHashes{}; // Computed from the fields above, never serialized
+	};
+
+	QDateTime captureTime{};
+	std::vector<Entity> entities{}; // Sorted by entityID
+};
+
+/**
+* @brief Captures, saves, compares and restores network snapshots.
+* @details Snapshots are saved in a compact binary format (and can be exported as JSON for reading).
+*          Restoring only sends the commands for the differences with the live network, in three phases where the commands of all entities are in flight at the same time:
+*          the ACMP disconnections, then the AECP commands, then the ACMP connections (so listeners are not connected while their stream format, or the format of their talker stream, changes).
+*          Must be used from the GUI thread.
+*/
+class NetworkSnapshotManager : public QObject
+{
+	Q_OBJECT
+public:
+	struct EntityDiff
+	{
+		la::avdecc::UniqueIdentifier entityID{};
+		std::array<bool, NetworkSnapshot::SectionsCount> changedSections{};
+	};
+
+	struct Diff
+	{
+		std::vector<EntityDiff> changedEntities{};
+		std::size_t upToDateEntities{ 0u };
+		std::vector<la::avdecc::UniqueIdentifier> offlineEntities{}; // In the snapshot, but not on the network
+		std::vector<la::avdecc::UniqueIdentifier> incompatibleEntities{}; // Another model or another configuration than in the snapshot
+	};
+
+	struct RestoreResult
+	{
+		std::size_t restoredEntities{ 0u };
+		std::size_t aecpCommands{ 0u };
+		std::size_t acmpCommands{ 0u };
+	};
+
+	static NetworkSnapshotManager& getInstance() noexcept;
+
+	/** Captures the state of all online entities */
+	virtual NetworkSnapshot capture() const noexcept = 0;
+
+	/** Compares the specified sections of the snapshot with the live network, only capturing those sections of the live entities */
+	virtual Diff diff(NetworkSnapshot const& snapshot, NetworkSnapshot::Sections const sections) const noexcept = 0;
+
+	/** Sends the commands needed for the live network to match the snapshot. Offline and incompatible entities are skipped (see diff) */
+	virtual RestoreResult restore(NetworkSnapshot const& snapshot) noexcept = 0;
+
+	/** Returns true while the commands of a restore are in flight */
+	virtual bool isRestoring() const noexcept = 0;
+
+	static bool save(NetworkSnapshot const& snapshot, QString const& filePath) noexcept;
+	static std::optional<NetworkSnapshot> load(QString const& filePath) noexcept;
+	static bool exportJson(NetworkSnapshot const& snapshot, QString const& filePath) noexcept;
+
+	static QString sectionName(NetworkSnapshot::Section const section) noexcept;
+
+	/** Emitted when all the commands of a restore completed, with the number of commands that failed */
+	Q_SIGNAL void restoreCompleted(std::size_t const failedCommands);
+
+protected:
+	NetworkSnapshotManager() = default;
+};
+
+} // namespace avdecc
@@ -0,0 +1,167 @@
+/*
+* Copyright 2017-2018, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be usefu_state,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "stringCache.hpp"
+#include "controllerManager.hpp"
+#include "helper.hpp"
+
+#include <mutex>
+#include <unordered_map>
+
+namespace avdecc
+{
+class StringCacheImpl final : public StringCache
+{
+public:
+	StringCacheImpl() noexcept
+	{
+		auto& manager = ControllerManager::getInstance();
+
+		// Direct connections, the cache is protected by its own lock
+		QObject::connect(&manager, &ControllerManager::controllerOffline, [this]()
+		{
+			clear();
+		});
+		QObject::connect(&manager, &ControllerManager::entityOnline, [this](la::avdecc::UniqueIdentifier const entityID)
+		{
+			invalidateEntity(entityID);
+		});
+		QObject::connect(&manager, &ControllerManager::entityOffline, [this](la::avdecc::UniqueIdentifier const entityID)
+		{
+			invalidateEntity(entityID);
+		});
+	}
+
+private:
+	// Caches are simply emptied when they grow bigger than this, which only happens with lots of transient values
+	static constexpr std::size_t MaxEntries = 4096;
+
+	using LocalizedStringKey = std::uint32_t;
+	using LocalizedStrings = std::unordered_map<LocalizedStringKey, QString>;
+
+	template<typename Map, typename Key, typename Builder>
+	QString findOrInsert(Map& map, Key const& key, Builder&& builder) noexcept
+	{
+		{
+			auto const lg = std::lock_guard{ _lock };
+			auto const it = map.find(key);
+			if (it != map.end())
+			{
+				return it->second;
+			}
+		}
+
+		// Build outside the lock, another thread might do the same but the result is identical
+		auto str = builder();
+
+		auto const lg = std::lock_guard{ _lock };
+		if (map.size() >= MaxEntries)
+		{
+			map.clear();
+		}
+		map.insert({ key, str });
+		return str;
+	}
+
+	// StringCache overrides
+	virtual QString uniqueIdentifierToString(la::avdecc::UniqueIdentifier const& identifier) noexcept override
+	{
+		return findOrInsert(_uniqueIdentifiers, identifier.getValue(), [&identifier]()
+		{
+			return helper::toHexQString(identifier.getValue(), true, true);
+		});
+	}
+
+	virtual QString streamFormatToString(la::avdecc::entity::model::StreamFormat const streamFormat) noexcept override
+	{
+		return findOrInsert(_streamFormats, streamFormat, [streamFormat]()
+		{
+			auto const streamFormatInfo = la::avdecc::entity::model::StreamFormatInfo::create(streamFormat);
+			return helper::streamFormatToString(*streamFormatInfo);
+		});
+	}
+
+	virtual QString localizedString(la::avdecc::controller::ControlledEntity const& controlledEntity, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::LocalizedStringReference const stringReference) noexcept override
+	{
+		auto const entityID = controlledEntity.getEntity().getEntityID();
+		auto const key = (static_cast<LocalizedStringKey>(configurationIndex) << 16) | static_cast<LocalizedStringKey>(stringReference);
+
+		{
+			auto const lg = std::lock_guard{ _lock };
+			auto const entityIt = _localizedStrings.find(entityID);
+			if (entityIt != _localizedStrings.end())
+			{
+				auto const it = entityIt->second.find(key);
+				if (it != entityIt->second.end())
+				{
+					return it->second;
+				}
+			}
+		}
+
+		// Build outside the lock, the entity map is looked up again as it might have been removed in the meantime
+		auto str = QString{};
+		try
+		{
+			str = QString{ controlledEntity.getLocalizedString(configurationIndex, stringReference).data() };
+		}
+		catch (...)
+		{
+		}
+
+		auto const lg = std::lock_guard{ _lock };
+		auto& strings = _localizedStrings[entityID];
+		if (strings.size() >= MaxEntries)
+		{
+			strings.clear();
+		}
+		strings.insert({ key, str });
+		return str;
+	}
+
+	virtual void invalidateEntity(la::avdecc::UniqueIdentifier const entityID) noexcept override
+	{
+		auto const lg = std::lock_guard{ _lock };
+		_localizedStrings.erase(entityID);
+	}
+
+	virtual void clear() noexcept override
+	{
+		auto const lg = std::lock_guard{ _lock };
+		_uniqueIdentifiers.clear();
+		_streamFormats.clear();
+		_localizedStrings.clear();
+	}
+
+	// Private members
+	std::mutex _lock{};
+	std::unordered_map<std::uint64_t, QString> _uniqueIdentifiers{};
+	std::unordered_map<la::avdecc::entity::model::StreamFormat, QString> _streamFormats{};
+	std::unordered_map<la::avdecc::UniqueIdentifier, LocalizedStrings, la::avdecc::UniqueIdentifier::hash> _localizedStrings{}; // Removed when their entity goes online or offline
+};
+
+StringCache& StringCache::getInstance() noexcept
+{
+	static StringCacheImpl s_StringCache{};
+
+	return s_StringCache;
+}
+
+} // namespace avdecc
@@ -0,0 +1,60 @@
+/*
+* Copyright 2017-2018, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be usefu_state,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#pragma once
+
+#include <QString>
+#include <la/avdecc/internals/uniqueIdentifier.hpp>
+#include <la/avdecc/controller/internals/avdeccControlledEntity.hpp>
+
+namespace avdecc
+{
+/**
+* @brief Process-wide cache of the strings built by the helper conversions.
+* @details Each string is only formatted once, then shared (QString is implicitly shared, returning a cached string does not allocate).
+*          Localized strings of an entity are dropped when it goes online or offline (which is when its locales and strings can change), everything is dropped when the controller goes offline.
+*          Thread-safe.
+*/
+class StringCache
+{
+public:
+	static StringCache& getInstance() noexcept;
+
+	/** Returns the formatted identifier (see helper::uniqueIdentifierToString) */
+	virtual QString uniqueIdentifierToString(la::avdecc::UniqueIdentifier const& identifier) noexcept = 0;
+
+	/** Returns the description of the stream format (see helper::streamFormatToString), only creating a StreamFormatInfo the first time the format is seen */
+	virtual QString streamFormatToString(la::avdecc::entity::model::StreamFormat const streamFormat) noexcept = 0;
+
+	/** Returns the localized string for the specified configuration of the entity */
+	virtual QString localizedString(la::avdecc::controller::ControlledEntity const& controlledEntity, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::LocalizedStringReference const stringReference) noexcept = 0;
+
+	/** Drops the cached strings of the specified entity */
+	virtual void invalidateEntity(la::avdecc::UniqueIdentifier const entityID) noexcept = 0;
+
+	/** Drops all cached strings */
+	virtual void clear() noexcept = 0;
+
+protected:
+	StringCache() = default;
+	virtual ~StringCache() = default;
+};
+
+} // namespace avdecc
@@ -19,8 +19,11 @@
 
 #include "connectionMatrix.hpp"
 #include "avdecc/controllerManager.hpp"
+#include "avdecc/clockDomainIndex.hpp"
 #include "avdecc/helper.hpp"
 #include "internals/config.hpp"
+#include "profiler/profiler.hpp"
+#include "profiler/memoryAccounting.hpp"
 #include <la/avdecc/utils.hpp>
 
 #include <QApplication>
@@ -35,6 +38,58 @@
 
 namespace connectionMatrix
 {
+/* ************************************************************ */
+/* Capabilities computation                                     */
+/* ************************************************************ */
+enum class ConnectState
+{
+	NotConnected = 0,
+	FastConnecting,
+	Connected,
+};
+
+static bool isStreamConnectionState(la::avdecc::controller::model::StreamConnectionState::State const state, la::avdecc::UniqueIdentifier const talkerID, la::avdecc::controller::model::StreamOutputNode const& talkerNode, la::avdecc::controller::model::StreamInputNode const& listenerNode) noexcept
+{
+	return (listenerNode.dynamicModel->connectionState.state == state) && (listenerNode.dynamicModel->connectionState.talkerStream.entityID == talkerID) && (listenerNode.dynamicModel->connectionState.talkerStream.streamIndex == talkerNode.descriptorIndex);
+}
+
+static bool isFormatCompatible(la::avdecc::controller::model::StreamOutputNode const& talkerNode, la::avdecc::controller::model::StreamInputNode const& listenerNode) noexcept
+{
+	return la::avdecc::entity::model::StreamFormatInfo::isListenerFormatCompatibleWithTalkerFormat(listenerNode.dynamicModel->currentFormat, talkerNode.dynamicModel->currentFormat);
+}
+
+static ConnectionCapabilities computeCapabilities(ConnectState const connectState, bool const areAllConnected, bool const isFormatCompatible, bool const isDomainCompatible) noexcept
+{
+	auto caps{ ConnectionCapabilities::Connectable };
+
+	if (!isDomainCompatible)
+		caps |= ConnectionCapabilities::WrongDomain;
+
+	if (!isFormatCompatible)
+		caps |= ConnectionCapabilities::WrongFormat;
+
+	if (connectState != ConnectState::NotConnected)
+	{
+		if (areAllConnected)
+			caps |= ConnectionCapabilities::Connected;
+		else if (connectState == ConnectState::FastConnecting)
+			caps |= ConnectionCapabilities::FastConnecting;
+		else
+			caps |= ConnectionCapabilities::PartiallyConnected;
+	}
+
+	return caps;
+}
+
+ConnectionCapabilities computeStreamCapabilities(la::avdecc::UniqueIdentifier const talkerID, la::avdecc::controller::model::StreamOutputNode const& talkerNode, la::avdecc::controller::model::StreamInputNode const& listenerNode, bool const isDomainCompatible) noexcept
+{
+	auto const areConnected = isStreamConnectionState(la::avdecc::controller::model::StreamConnectionState::State::Connected, talkerID, talkerNode, listenerNode);
+	auto const fastConnecting = isStreamConnectionState(la::avdecc::controller::model::StreamConnectionState::State::FastConnecting, talkerID, talkerNode, listenerNode);
+	auto const connectState = areConnected ? ConnectState::Connected : (fastConnecting ? ConnectState::FastConnecting : ConnectState::NotConnected);
+
+	return computeCapabilities(connectState, areConnected, isFormatCompatible(talkerNode, listenerNode), isDomainCompatible);
+}
+
 /* ************************************************************ */
 /* ConnectionMatrixModel                                        */
 /* ************************************************************ */
@@ -60,13 +115,17 @@ private:
 	Q_SLOT void streamConnectionChanged(la::avdecc::controller::model::StreamConnectionState const& state);
 	Q_SLOT void streamFormatChanged(la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::DescriptorType const descriptorType, la::avdecc::entity::model::StreamIndex const streamIndex, la::avdecc::entity::model::StreamFormat const streamFormat);
 	Q_SLOT void gptpChanged(la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::AvbInterfaceIndex const avbInterfaceIndex, la::avdecc::UniqueIdentifier const grandMasterID, std::uint8_t const grandMasterDomain);
+	Q_SLOT void avbInfoChanged(la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::AvbInterfaceIndex const avbInterfaceIndex, la::avdecc::entity::model::AvbInfo const& info);
 	Q_SLOT void entityNameChanged();
 	Q_SLOT void streamNameChanged();
 
 	// Private methods
 	void addEntity(bool const orientationIsRow, la::avdecc::UniqueIdentifier const entityID);
 	void removeEntity(bool const orientationIsRow, la::avdecc::UniqueIdentifier const entityID);
+	void setInterfaceDomain(la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::AvbInterfaceIndex const avbInterfaceIndex, la::avdecc::UniqueIdentifier const grandMasterID, std::uint8_t const grandMasterDomain);
+	void refreshStream(bool const orientationIsRow, la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::StreamIndex const streamIndex);
 	void refreshHeader() const noexcept;
+	void updateMemoryAccount() noexcept;
 	static inline bool areUserDataEqual(QVariant const& lhs, QVariant const& rhs)
 	{
 		auto const& lhsData = lhs.value<UserData>();
@@ -77,9 +136,12 @@ private:
 	// Private members
 	Entities _talkers{};
 	Entities _listeners{};
+	avdecc::ClockDomainIndex _clockDomainIndex{};
 	
 	QMap<QPair<int, int>, QColor> _backgroundColor{};
 
+	profiler::MemoryAccount _memoryAccount{ profiler::MemorySubsystem::ConnectionMatrix };
+
 	ConnectionMatrixModel * const q_ptr{ nullptr };
 	Q_DECLARE_PUBLIC(ConnectionMatrixModel);
 };
@@ -94,12 +156,14 @@ ConnectionMatrixModel::ConnectionMatrixModelPrivate::ConnectionMatrixModelPrivat
 	connect(&controllerManager, &avdecc::ControllerManager::streamConnectionChanged, this, &ConnectionMatrixModel::ConnectionMatrixModelPrivate::streamConnectionChanged);
 	connect(&controllerManager, &avdecc::ControllerManager::streamFormatChanged, this, &ConnectionMatrixModel::ConnectionMatrixModelPrivate::streamFormatChanged);
 	connect(&controllerManager, &avdecc::ControllerManager::gptpChanged, this, &ConnectionMatrixModel::ConnectionMatrixModelPrivate::gptpChanged);
+	connect(&controllerManager, &avdecc::ControllerManager::avbInfoChanged, this, &ConnectionMatrixModel::ConnectionMatrixModelPrivate::avbInfoChanged);
 	connect(&controllerManager, &avdecc::ControllerManager::entityNameChanged, this, &ConnectionMatrixModel::ConnectionMatrixModelPrivate::entityNameChanged);
 	connect(&controllerManager, &avdecc::ControllerManager::streamNameChanged, this, &ConnectionMatrixModel::ConnectionMatrixModelPrivate::streamNameChanged);
 }
 
 void ConnectionMatrixModel::ConnectionMatrixModelPrivate::controllerOffline()
 {
+	_clockDomainIndex.clear();
 	if (q_ptr)
 		q_ptr->clearModel();
 }
@@ -110,6 +174,7 @@ void ConnectionMatrixModel::ConnectionMatrixModelPrivate::entityOnline(la::avdec
 	auto controlledEntity = manager.getControlledEntity(entityID);
 	if (controlledEntity && AVDECC_ASSERT_WITH_RET(!controlledEntity->gotFatalEnumerationError(), "An entity should not be set online if it had an enumeration error"))
 	{
+		_clockDomainIndex.addEntity(*controlledEntity);
 		if (la::avdecc::hasFlag(controlledEntity->getEntity().getTalkerCapabilities(), la::avdecc::entity::TalkerCapabilities::Implemented))
 		{
 			_talkers.insert(entityID);
@@ -120,6 +185,7 @@ void ConnectionMatrixModel::ConnectionMatrixModelPrivate::entityOnline(la::avdec
 			_listeners.insert(entityID);
 			addEntity(false, entityID);
 		}
+		updateMemoryAccount();
 	}
 }
 
@@ -129,6 +195,16 @@ void ConnectionMatrixModel::ConnectionMatrixModelPrivate::entityOffline(la::avde
 		removeEntity(true, entityID);
 	if (_listeners.erase(entityID) != 0)
 		removeEntity(false, entityID);
+	_clockDomainIndex.removeEntity(entityID);
+	updateMemoryAccount();
+}
+
+void ConnectionMatrixModel::ConnectionMatrixModelPrivate::updateMemoryAccount() noexcept
+{
+	// Estimated node sizes of the red-black trees (3 pointers and the color) and of the QMap (3 pointers)
+	constexpr auto EntityNodeSize = sizeof(void*) * 4 + sizeof(Entities::value_type);
+	constexpr auto BackgroundColorNodeSize = sizeof(void*) * 3 + sizeof(QPair<int, int>) + sizeof(QColor);
+	_memoryAccount.set(static_cast<std::int64_t>((_talkers.size() + _listeners.size()) * EntityNodeSize + static_cast<std::size_t>(_backgroundColor.size()) * BackgroundColorNodeSize));
 }
 
 void ConnectionMatrixModel::ConnectionMatrixModelPrivate::streamRunningChanged(la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::DescriptorType const descriptorType, la::avdecc::entity::model::StreamIndex const streamIndex, bool const isRunning)
@@ -236,35 +312,76 @@ void ConnectionMatrixModel::ConnectionMatrixModelPrivate::streamFormatChanged(la
 
 void ConnectionMatrixModel::ConnectionMatrixModelPrivate::gptpChanged(la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::AvbInterfaceIndex const avbInterfaceIndex, la::avdecc::UniqueIdentifier const grandMasterID, std::uint8_t const grandMasterDomain)
 {
-	auto const toCompare = QVariant::fromValue(UserData{ UserData::Type::EntityNode, entityID });
+	setInterfaceDomain(entityID, avbInterfaceIndex, grandMasterID, grandMasterDomain);
+}
+
+void ConnectionMatrixModel::ConnectionMatrixModelPrivate::avbInfoChanged(la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::AvbInterfaceIndex const avbInterfaceIndex, la::avdecc::entity::model::AvbInfo const& info)
+{
+	setInterfaceDomain(entityID, avbInterfaceIndex, info.gptpGrandmasterID, info.gptpDomainNumber);
+}
 
-	// Refresh whole columns for specified listener (all UserData::Type for that entity)
+void ConnectionMatrixModel::ConnectionMatrixModelPrivate::setInterfaceDomain(la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::AvbInterfaceIndex const avbInterfaceIndex, la::avdecc::UniqueIdentifier const grandMasterID, std::uint8_t const grandMasterDomain)
+{
+	if (!_clockDomainIndex.setInterfaceDomain(entityID, avbInterfaceIndex, grandMasterID, grandMasterDomain))
 	{
-		auto const result = q_ptr->columnAndNodeForUserData(toCompare, &ConnectionMatrixModel::ConnectionMatrixModelPrivate::areUserDataEqual);
-		auto const columnIndex = result.first;
-		if (columnIndex != -1)
-		{
-			auto const topLeftIndex = q_ptr->createIndex(0, columnIndex, q_ptr);
-			auto const bottomRightIndex = q_ptr->createIndex(q_ptr->rowCount({}), columnIndex + q_ptr->countChildren(result.second), q_ptr);
+		return;
+	}
 
-			emit q_ptr->dataChanged(topLeftIndex, bottomRightIndex, { Qt::DisplayRole });
+	// Only refresh the rows and columns of the streams using that AVB interface
+	if (_talkers.count(entityID) != 0)
+	{
+		for (auto const streamIndex : _clockDomainIndex.getBoundStreamOutputs(entityID, avbInterfaceIndex))
+		{
+			refreshStream(true, entityID, streamIndex);
 		}
 	}
-
-	// Refresh whole rows for specified talker (all UserData::Type for that entity)
+	if (_listeners.count(entityID) != 0)
 	{
-		auto const result = q_ptr->rowAndNodeForUserData(toCompare, &ConnectionMatrixModel::ConnectionMatrixModelPrivate::areUserDataEqual);
-		auto const rowIndex = result.first;
-		if (rowIndex != -1)
+		for (auto const streamIndex : _clockDomainIndex.getBoundStreamInputs(entityID, avbInterfaceIndex))
 		{
-			auto const topLeftIndex = q_ptr->createIndex(rowIndex, 0, q_ptr);
-			auto const bottomRightIndex = q_ptr->createIndex(rowIndex + q_ptr->countChildren(result.second), q_ptr->columnCount({}), q_ptr);
-
-			emit q_ptr->dataChanged(topLeftIndex, bottomRightIndex, { Qt::DisplayRole });
+			refreshStream(false, entityID, streamIndex);
 		}
 	}
 }
 
+void ConnectionMatrixModel::ConnectionMatrixModelPrivate::refreshStream(bool const orientationIsRow, la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::StreamIndex const streamIndex)
+{
+	auto const singleStreamType = orientationIsRow ? UserData::Type::OutputStreamNode : UserData::Type::InputStreamNode;
+	auto const redundantStreamType = orientationIsRow ? UserData::Type::RedundantOutputStreamNode : UserData::Type::RedundantInputStreamNode;
+	auto const findIndex = [this, orientationIsRow, entityID, streamIndex](UserData::Type const type)
+	{
+		auto const toCompare = QVariant::fromValue(UserData{ type, entityID, streamIndex });
+		return orientationIsRow ? q_ptr->rowAndNodeForUserData(toCompare, &ConnectionMatrixModel::ConnectionMatrixModelPrivate::areUserDataEqual) : q_ptr->columnAndNodeForUserData(toCompare, &ConnectionMatrixModel::ConnectionMatrixModelPrivate::areUserDataEqual);
+	};
+
+	auto first = -1;
+	auto last = -1;
+	if (auto const result = findIndex(singleStreamType); result.first != -1)
+	{
+		first = last = result.first;
+	}
+	else if (auto const redundantResult = findIndex(redundantStreamType); redundantResult.first != -1)
+	{
+		// Also refresh the redundant node, which is just before its streams
+		auto const userData = redundantResult.second->userData.value<UserData>();
+		first = redundantResult.first - userData.redundantStreamOrder - 1;
+		last = redundantResult.first;
+	}
+	else
+	{
+		return;
+	}
+
+	if (orientationIsRow)
+	{
+		emit q_ptr->dataChanged(q_ptr->createIndex(first, 0, q_ptr), q_ptr->createIndex(last, q_ptr->columnCount({}), q_ptr), { Qt::DisplayRole });
+	}
+	else
+	{
+		emit q_ptr->dataChanged(q_ptr->createIndex(0, first, q_ptr), q_ptr->createIndex(q_ptr->rowCount({}), last, q_ptr), { Qt::DisplayRole });
+	}
+}
+
 void ConnectionMatrixModel::ConnectionMatrixModelPrivate::entityNameChanged()
 {
 	refreshHeader();
@@ -277,16 +394,18 @@ void ConnectionMatrixModel::ConnectionMatrixModelPrivate::streamNameChanged()
 
 bool ConnectionMatrixModel::ConnectionMatrixModelPrivate::isStreamConnected(la::avdecc::UniqueIdentifier const talkerID, la::avdecc::controller::model::StreamOutputNode const* const talkerNode, la::avdecc::controller::model::StreamInputNode const* const listenerNode) const noexcept
 {
-	return (listenerNode->dynamicModel->connectionState.state == la::avdecc::controller::model::StreamConnectionState::State::Connected) && (listenerNode->dynamicModel->connectionState.talkerStream.entityID == talkerID) && (listenerNode->dynamicModel->connectionState.talkerStream.streamIndex == talkerNode->descriptorIndex);
+	return isStreamConnectionState(la::avdecc::controller::model::StreamConnectionState::State::Connected, talkerID, *talkerNode, *listenerNode);
 }
 
 bool ConnectionMatrixModel::ConnectionMatrixModelPrivate::isStreamFastConnecting(la::avdecc::UniqueIdentifier const talkerID, la::avdecc::controller::model::StreamOutputNode const* const talkerNode, la::avdecc::controller::model::StreamInputNode const* const listenerNode) const noexcept
 {
-	return (listenerNode->dynamicModel->connectionState.state == la::avdecc::controller::model::StreamConnectionState::State::FastConnecting) && (listenerNode->dynamicModel->connectionState.talkerStream.entityID == talkerID) && (listenerNode->dynamicModel->connectionState.talkerStream.streamIndex == talkerNode->descriptorIndex);
+	return isStreamConnectionState(la::avdecc::controller::model::StreamConnectionState::State::FastConnecting, talkerID, *talkerNode, *listenerNode);
 }
 
 ConnectionCapabilities ConnectionMatrixModel::ConnectionMatrixModelPrivate::connectionCapabilities(UserData const& talkerStream, UserData const& listenerStream) const noexcept
 {
+	PROFILER_SCOPE("connectionMatrix", "ConnectionMatrixModel::connectionCapabilities");
+
 	if (talkerStream.entityID == listenerStream.entityID)
 		return ConnectionCapabilities::None;
 
@@ -298,46 +417,12 @@ ConnectionCapabilities ConnectionMatrixModel::ConnectionMatrixModelPrivate::conn
 		if (talkerEntity && listenerEntity)
 		{
 			auto const& talkerEntityNode = talkerEntity->getEntityNode();
-			auto const& talkerEntityInfo = talkerEntity->getEntity();
 			auto const& listenerEntityNode = listenerEntity->getEntityNode();
-			auto const& listenerEntityInfo = listenerEntity->getEntity();
 
-			auto const computeFormatCompatible = [](la::avdecc::controller::model::StreamOutputNode const& talkerNode, la::avdecc::controller::model::StreamInputNode const& listenerNode)
+			// Domains of the AVB interfaces the streams are bound to
+			auto const computeDomainCompatible = [this, &talkerStream, &listenerStream](la::avdecc::entity::model::StreamIndex const talkerStreamIndex, la::avdecc::entity::model::StreamIndex const listenerStreamIndex)
 			{
-				return la::avdecc::entity::model::StreamFormatInfo::isListenerFormatCompatibleWithTalkerFormat(listenerNode.dynamicModel->currentFormat, talkerNode.dynamicModel->currentFormat);
-			};
-			auto const computeDomainCompatible = [&talkerEntityInfo, &listenerEntityInfo]()
-			{
-				// TODO: Incorrect computation, must be based on the AVBInterface for the stream
-				return listenerEntityInfo.getGptpGrandmasterID() == talkerEntityInfo.getGptpGrandmasterID();
-			};
-			enum class ConnectState
-			{
-				NotConnected = 0,
-				FastConnecting,
-				Connected,
-			};
-			auto const computeCapabilities = [](ConnectState const connectState, bool const areAllConnected, bool const isFormatCompatible, bool const isDomainCompatible)
-			{
-				auto caps{ ConnectionCapabilities::Connectable };
-
-				if (!isDomainCompatible)
-					caps |= ConnectionCapabilities::WrongDomain;
-
-				if (!isFormatCompatible)
-					caps |= ConnectionCapabilities::WrongFormat;
-
-				if (connectState != ConnectState::NotConnected)
-				{
-					if (areAllConnected)
-						caps |= ConnectionCapabilities::Connected;
-					else if (connectState == ConnectState::FastConnecting)
-						caps |= ConnectionCapabilities::FastConnecting;
-					else
-						caps |= ConnectionCapabilities::PartiallyConnected;
-				}
-
-				return caps;
+				return avdecc::ClockDomainIndex::areDomainsCompatible(_clockDomainIndex.getStreamOutputDomain(talkerStream.entityID, talkerStreamIndex), _clockDomainIndex.getStreamInputDomain(listenerStream.entityID, listenerStreamIndex));
 			};
 
 			// Special case for both redundant nodes
@@ -363,8 +448,8 @@ ConnectionCapabilities ConnectionMatrixModel::ConnectionMatrixModelPrivate::conn
 					auto const connected = isStreamConnected(talkerStream.entityID, redundantTalkerStreamNode, redundantListenerStreamNode);
 					atLeastOneConnected |= connected;
 					allConnected &= connected;
-					allCompatibleFormat &= computeFormatCompatible(*redundantTalkerStreamNode, *redundantListenerStreamNode);
-					allDomainCompatible &= computeDomainCompatible();
+					allCompatibleFormat &= isFormatCompatible(*redundantTalkerStreamNode, *redundantListenerStreamNode);
+					allDomainCompatible &= computeDomainCompatible(redundantTalkerStreamNode->descriptorIndex, redundantListenerStreamNode->descriptorIndex);
 					++talkerIt;
 					++listenerIt;
 				}
@@ -420,18 +505,7 @@ ConnectionCapabilities ConnectionMatrixModel::ConnectionMatrixModelPrivate::conn
 					listenerNode = &listenerEntity->getStreamInputNode(listenerEntityNode.dynamicModel->currentConfiguration, listenerStream.streamIndex);
 				}
 
-				// Get connected state
-				auto const areConnected = isStreamConnected(talkerStream.entityID, talkerNode, listenerNode);
-				auto const fastConnecting = isStreamFastConnecting(talkerStream.entityID, talkerNode, listenerNode);
-				auto const connectState = areConnected ? ConnectState::Connected : (fastConnecting ? ConnectState::FastConnecting : ConnectState::NotConnected);
-
-				// Get stream format compatibility
-				auto const isFormatCompatible = computeFormatCompatible(*talkerNode, *listenerNode);
-
-				// Get domain compatibility
-				auto const isDomainCompatible = computeDomainCompatible();
-
-				return computeCapabilities(connectState, areConnected, isFormatCompatible, isDomainCompatible);
+				return computeStreamCapabilities(talkerStream.entityID, *talkerNode, *listenerNode, computeDomainCompatible(talkerNode->descriptorIndex, listenerNode->descriptorIndex));
 			}
 		}
 	}
@@ -444,6 +518,8 @@ ConnectionCapabilities ConnectionMatrixModel::ConnectionMatrixModelPrivate::conn
 
 void ConnectionMatrixModel::ConnectionMatrixModelPrivate::addEntity(bool const orientationIsRow, la::avdecc::UniqueIdentifier const entityID)
 {
+	PROFILER_SCOPE("connectionMatrix", "ConnectionMatrixModel::addEntity");
+
 	auto& manager = avdecc::ControllerManager::getInstance();
 	auto controlledEntity = manager.getControlledEntity(entityID);
 	if (controlledEntity)
@@ -657,6 +733,7 @@ bool ConnectionMatrixModel::setData(QModelIndex const& index, QVariant const& va
 		{
 			auto const key = qMakePair(index.row(), index.column());
 			d_ptr->_backgroundColor.insert(key, value.value<QColor>());
+			d_ptr->updateMemoryAccount();
 			emit dataChanged(index, index, {Qt::BackgroundRole});
 			return true;
 		}
@@ -751,6 +828,8 @@ QVariant ConnectionMatrixModel::headerData(int section, Qt::Orientation orientat
 /* ************************************************************ */
 void ConnectionMatrixItemDelegate::paint(QPainter* painter, QStyleOptionViewItem const& option, QModelIndex const& index) const
 {
+	PROFILER_SCOPE("connectionMatrix", "ConnectionMatrixItemDelegate::paint");
+
 	auto const* const model = static_cast<ConnectionMatrixModel const*>(index.model());
 	auto const& talkerNode = model->nodeAtRow(index.row());
 	auto const& listenerNode = model->nodeAtColumn(index.column());
@@ -782,55 +861,59 @@ void ConnectionMatrixItemDelegate::paint(QPainter* painter, QStyleOptionViewItem
 
 		auto const isRedundant = !((talkerData.type == UserData::Type::RedundantOutputNode && listenerData.type == UserData::Type::RedundantInputNode)
 															 || (talkerData.type == UserData::Type::OutputStreamNode && listenerData.type == UserData::Type::InputStreamNode));
+		drawCapabilities(painter, option.rect, caps, isRedundant);
+	}
+}
 
-		if (la::avdecc::hasFlag(caps, ConnectionCapabilities::Connected))
+void ConnectionMatrixItemDelegate::drawCapabilities(QPainter* painter, QRect const& rect, ConnectionCapabilities const caps, bool const isRedundant)
+{
+	if (la::avdecc::hasFlag(caps, ConnectionCapabilities::Connected))
+	{
+		if (la::avdecc::hasFlag(caps, ConnectionCapabilities::WrongDomain))
 		{
-			if (la::avdecc::hasFlag(caps, ConnectionCapabilities::WrongDomain))
-			{
-				drawWrongDomainConnectedStream(painter, option.rect, isRedundant);
-			}
-			else if (la::avdecc::hasFlag(caps, ConnectionCapabilities::WrongFormat))
-			{
-				drawWrongFormatConnectedStream(painter, option.rect, isRedundant);
-			}
-			else
-			{
-				drawConnectedStream(painter, option.rect, isRedundant);
-			}
+			drawWrongDomainConnectedStream(painter, rect, isRedundant);
 		}
-		else if (la::avdecc::hasFlag(caps, ConnectionCapabilities::FastConnecting))
+		else if (la::avdecc::hasFlag(caps, ConnectionCapabilities::WrongFormat))
 		{
-			if (la::avdecc::hasFlag(caps, ConnectionCapabilities::WrongDomain))
-			{
-				drawWrongDomainFastConnectingStream(painter, option.rect, isRedundant);
-			}
-			else if (la::avdecc::hasFlag(caps, ConnectionCapabilities::WrongFormat))
-			{
-				drawWrongFormatFastConnectingStream(painter, option.rect, isRedundant);
-			}
-			else
-			{
-				drawFastConnectingStream(painter, option.rect, isRedundant);
-			}
+			drawWrongFormatConnectedStream(painter, rect, isRedundant);
 		}
-		else if (la::avdecc::hasFlag(caps, ConnectionCapabilities::PartiallyConnected))
+		else
 		{
-			drawPartiallyConnectedRedundantNode(painter, option.rect);
+			drawConnectedStream(painter, rect, isRedundant);
+		}
+	}
+	else if (la::avdecc::hasFlag(caps, ConnectionCapabilities::FastConnecting))
+	{
+		if (la::avdecc::hasFlag(caps, ConnectionCapabilities::WrongDomain))
+		{
+			drawWrongDomainFastConnectingStream(painter, rect, isRedundant);
+		}
+		else if (la::avdecc::hasFlag(caps, ConnectionCapabilities::WrongFormat))
+		{
+			drawWrongFormatFastConnectingStream(painter, rect, isRedundant);
 		}
 		else
 		{
-			if (la::avdecc::hasFlag(caps, ConnectionCapabilities::WrongDomain))
-			{
-				drawWrongDomainNotConnectedStream(painter, option.rect, isRedundant);
-			}
-			else if (la::avdecc::hasFlag(caps, ConnectionCapabilities::WrongFormat))
-			{
-				drawWrongFormatNotConnectedStream(painter, option.rect, isRedundant);
-			}
-			else
-			{
-				drawNotConnectedStream(painter, option.rect, isRedundant);
-			}
+			drawFastConnectingStream(painter, rect, isRedundant);
+		}
+	}
+	else if (la::avdecc::hasFlag(caps, ConnectionCapabilities::PartiallyConnected))
+	{
+		drawPartiallyConnectedRedundantNode(painter, rect);
+	}
+	else
+	{
+		if (la::avdecc::hasFlag(caps, ConnectionCapabilities::WrongDomain))
+		{
+			drawWrongDomainNotConnectedStream(painter, rect, isRedundant);
+		}
+		else if (la::avdecc::hasFlag(caps, ConnectionCapabilities::WrongFormat))
+		{
+			drawWrongFormatNotConnectedStream(painter, rect, isRedundant);
+		}
+		else
+		{
+			drawNotConnectedStream(painter, rect, isRedundant);
 		}
 	}
 }
@@ -68,6 +68,9 @@ constexpr bool operator==(UserData const& lhs, UserData const& rhs)
 	return lhs.type == rhs.type && lhs.entityID == rhs.entityID && lhs.streamIndex == rhs.streamIndex;
 }
 
+/** Computes the capabilities of a single talker/listener stream pair, from the stream nodes of both entities */
+ConnectionCapabilities computeStreamCapabilities(la::avdecc::UniqueIdentifier const talkerID, la::avdecc::controller::model::StreamOutputNode const& talkerNode, la::avdecc::controller::model::StreamInputNode const& listenerNode, bool const isDomainCompatible) noexcept;
+
 class ConnectionMatrixModel final : public qt::toolkit::MatrixModel
 {
 public:
@@ -97,6 +100,9 @@ private:
 class ConnectionMatrixItemDelegate final : public QAbstractItemDelegate
 {
 public:
+	/** Draws the cell representing a talker/listener pair with the specified capabilities */
+	static void drawCapabilities(QPainter* painter, QRect const& rect, ConnectionCapabilities const caps, bool const isRedundant);
+
 private:
 	// QAbstractItemDelegate overrides
 	virtual void paint(QPainter *painter, QStyleOptionViewItem const& option, QModelIndex const& index) const override;
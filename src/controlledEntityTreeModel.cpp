@@ -0,0 +1,684 @@
+/*
+* Copyright 2017-2018, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be usefu_state,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "controlledEntityTreeModel.hpp"
+
+#include "avdecc/controllerManager.hpp"
+#include "avdecc/helper.hpp"
+#include "nodeVisitor.hpp"
+#include "profiler/memoryAccounting.hpp"
+
+#include <QFont>
+#include <QStringList>
+#include <algorithm>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+using NameGenerator = QString (*)(la::avdecc::controller::ControlledEntity const* const controlledEntity, la::avdecc::controller::model::Node const* const node);
+
+QString entityNodeName(la::avdecc::controller::ControlledEntity const* const /*controlledEntity*/, la::avdecc::controller::model::Node const* const node)
+{
+	auto const& entityNode = *static_cast<la::avdecc::controller::model::EntityNode const*>(node);
+	return QString("%1: %2").arg(avdecc::helper::descriptorTypeToString(entityNode.descriptorType), entityNode.dynamicModel->entityName.data());
+}
+
+QString configurationNodeName(la::avdecc::controller::ControlledEntity const* const controlledEntity, la::avdecc::controller::model::Node const* const node)
+{
+	auto const& configurationNode = *static_cast<la::avdecc::controller::model::ConfigurationNode const*>(node);
+	return QString("%1.%2: %3").arg(avdecc::helper::descriptorTypeToString(configurationNode.descriptorType), QString::number(configurationNode.descriptorIndex), avdecc::helper::configurationName(controlledEntity, configurationNode));
+}
+
+template<class NodeType>
+QString objectNodeName(la::avdecc::controller::ControlledEntity const* const controlledEntity, la::avdecc::controller::model::Node const* const node)
+{
+	auto const& typedNode = *static_cast<NodeType const*>(node);
+	return QString("%1.%2: %3").arg(avdecc::helper::descriptorTypeToString(typedNode.descriptorType), QString::number(typedNode.descriptorIndex), avdecc::helper::objectName(controlledEntity, typedNode));
+}
+
+QString localeNodeName(la::avdecc::controller::ControlledEntity const* const /*controlledEntity*/, la::avdecc::controller::model::Node const* const node)
+{
+	auto const& localeNode = *static_cast<la::avdecc::controller::model::LocaleNode const*>(node);
+	return QString("%1.%2: %3").arg(avdecc::helper::descriptorTypeToString(localeNode.descriptorType), QString::number(localeNode.descriptorIndex), localeNode.staticModel->localeID.data());
+}
+
+template<class NodeType>
+QString indexedNodeName(la::avdecc::controller::ControlledEntity const* const /*controlledEntity*/, la::avdecc::controller::model::Node const* const node)
+{
+	auto const& typedNode = *static_cast<NodeType const*>(node);
+	return QString("%1.%2").arg(avdecc::helper::descriptorTypeToString(typedNode.descriptorType), QString::number(typedNode.descriptorIndex));
+}
+
+QString redundantStreamNodeName(la::avdecc::controller::ControlledEntity const* const /*controlledEntity*/, la::avdecc::controller::model::Node const* const node)
+{
+	auto const& redundantNode = *static_cast<la::avdecc::controller::model::RedundantStreamNode const*>(node);
+	return QString("REDUNDANT_%1.%2").arg(avdecc::helper::descriptorTypeToString(redundantNode.descriptorType), QString::number(redundantNode.virtualIndex));
+}
+} // namespace
+
+class ControlledEntityTreeModelPrivate : public QObject, public la::avdecc::controller::model::EntityModelVisitor
+{
+public:
+	/** A node of the AEM, as found by the visitor. Only pointers are collected so walking the whole model is cheap, names and rows are built on demand */
+	struct NodeInfo
+	{
+		la::avdecc::controller::model::Node const* node{ nullptr };
+		AnyNode anyNode{};
+		NameGenerator nameGenerator{ nullptr };
+		la::avdecc::entity::model::DescriptorIndex keyIndex{ 0u };
+		bool isDescriptorIndex{ true }; // keyIndex is the descriptor index of the node
+		bool defaultExpanded{ false };
+		bool isActiveConfiguration{ false };
+		std::vector<std::size_t> children{};
+	};
+
+	/** A row of the model, only created when its parent is fetched */
+	struct TreeItem
+	{
+		std::size_t nodeInfoIndex{ 0u };
+		TreeItem* parent{ nullptr };
+		int row{ 0 };
+		QString key{};
+		mutable QString name{}; // Built when first displayed
+		bool fetched{ false };
+		std::vector<std::unique_ptr<TreeItem>> children{};
+	};
+
+	ControlledEntityTreeModelPrivate(ControlledEntityTreeModel* q)
+		: q_ptr(q)
+	{
+		auto& controllerManager = avdecc::ControllerManager::getInstance();
+
+		connect(&controllerManager, &avdecc::ControllerManager::controllerOffline, this, &ControlledEntityTreeModelPrivate::controllerOffline);
+		connect(&controllerManager, &avdecc::ControllerManager::entityOnline, this, &ControlledEntityTreeModelPrivate::entityOnline);
+		connect(&controllerManager, &avdecc::ControllerManager::entityOffline, this, &ControlledEntityTreeModelPrivate::entityOffline);
+		connect(&controllerManager, &avdecc::ControllerManager::entityNameChanged, this, &ControlledEntityTreeModelPrivate::entityNameChanged);
+		connect(&controllerManager, &avdecc::ControllerManager::configurationNameChanged, this, &ControlledEntityTreeModelPrivate::configurationNameChanged);
+		connect(&controllerManager, &avdecc::ControllerManager::streamNameChanged, this, &ControlledEntityTreeModelPrivate::streamNameChanged);
+	}
+
+	void controllerOffline()
+	{
+		setControlledEntityID(la::avdecc::UniqueIdentifier{});
+	}
+
+	void entityOnline(la::avdecc::UniqueIdentifier const entityID)
+	{
+		// Only the displayed entity is of interest (it is back online with a new model)
+		if (entityID == _controlledEntityID)
+		{
+			load();
+		}
+	}
+
+	void entityOffline(la::avdecc::UniqueIdentifier const entityID)
+	{
+		// The model is about to be destroyed, don't keep any pointer to it
+		if (entityID == _controlledEntityID)
+		{
+			Q_Q(ControlledEntityTreeModel);
+
+			q->beginResetModel();
+			clear();
+			q->endResetModel();
+		}
+	}
+
+	void entityNameChanged(la::avdecc::UniqueIdentifier const entityID, QString const& /*entityName*/)
+	{
+		if (entityID == _controlledEntityID)
+		{
+			invalidateNames(la::avdecc::entity::model::DescriptorType::Entity, 0u);
+		}
+	}
+
+	void configurationNameChanged(la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, QString const& /*configurationName*/)
+	{
+		if (entityID == _controlledEntityID)
+		{
+			invalidateNames(la::avdecc::entity::model::DescriptorType::Configuration, configurationIndex);
+		}
+	}
+
+	void streamNameChanged(la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::DescriptorType const descriptorType, la::avdecc::entity::model::StreamIndex const streamIndex, QString const& /*streamName*/)
+	{
+		if (entityID != _controlledEntityID)
+		{
+			return;
+		}
+
+		auto& manager = avdecc::ControllerManager::getInstance();
+		auto controlledEntity = manager.getControlledEntity(entityID);
+
+		// Filter configuration, we currently expand nodes only for current configuration
+		if (controlledEntity && configurationIndex == controlledEntity->getEntityNode().dynamicModel->currentConfiguration)
+		{
+			invalidateNames(descriptorType, streamIndex);
+		}
+	}
+
+	void setControlledEntityID(la::avdecc::UniqueIdentifier const entityID)
+	{
+		if (_controlledEntityID == entityID)
+		{
+			return;
+		}
+
+		_controlledEntityID = entityID;
+
+		load();
+	}
+
+	la::avdecc::UniqueIdentifier controlledEntityID() const
+	{
+		return _controlledEntityID;
+	}
+
+	la::avdecc::controller::model::Node const* node(QModelIndex const& index) const
+	{
+		if (auto const* const item = itemFromIndex(index))
+		{
+			return _nodes[item->nodeInfoIndex].node;
+		}
+		return nullptr;
+	}
+
+	QModelIndex indexFromKey(QString const& key)
+	{
+		Q_Q(ControlledEntityTreeModel);
+
+		auto parentIndex = QModelIndex{};
+		auto* parentItem = &_root;
+		auto path = QString{};
+
+		for (auto const& segment : key.split('/', QString::SkipEmptyParts))
+		{
+			if (q->canFetchMore(parentIndex))
+			{
+				q->fetchMore(parentIndex);
+			}
+
+			path = path.isEmpty() ? segment : path + '/' + segment;
+
+			auto const it = std::find_if(parentItem->children.begin(), parentItem->children.end(), [&path](auto const& child)
+			{
+				return child->key == path;
+			});
+			if (it == parentItem->children.end())
+			{
+				return {};
+			}
+
+			parentItem = it->get();
+			parentIndex = q->createIndex(parentItem->row, 0, parentItem);
+		}
+
+		return parentIndex;
+	}
+
+	QModelIndex index(int row, int column, QModelIndex const& parent) const
+	{
+		Q_Q(const ControlledEntityTreeModel);
+
+		auto const* const parentItem = parent.isValid() ? itemFromIndex(parent) : &_root;
+		if (!parentItem || column != 0 || row < 0 || static_cast<std::size_t>(row) >= parentItem->children.size())
+		{
+			return {};
+		}
+
+		return q->createIndex(row, column, parentItem->children[row].get());
+	}
+
+	QModelIndex parent(QModelIndex const& child) const
+	{
+		Q_Q(const ControlledEntityTreeModel);
+
+		auto const* const item = itemFromIndex(child);
+		if (!item || item->parent == &_root)
+		{
+			return {};
+		}
+
+		return q->createIndex(item->parent->row, 0, item->parent);
+	}
+
+	int rowCount(QModelIndex const& parent) const
+	{
+		if (parent.column() > 0)
+		{
+			return 0;
+		}
+
+		auto const* const parentItem = parent.isValid() ? itemFromIndex(parent) : &_root;
+		return parentItem ? static_cast<int>(parentItem->children.size()) : 0;
+	}
+
+	bool hasChildren(QModelIndex const& parent) const
+	{
+		if (parent.column() > 0)
+		{
+			return false;
+		}
+
+		auto const* const parentItem = parent.isValid() ? itemFromIndex(parent) : &_root;
+		return parentItem && !childNodes(parentItem).empty();
+	}
+
+	bool canFetchMore(QModelIndex const& parent) const
+	{
+		auto const* const parentItem = parent.isValid() ? itemFromIndex(parent) : &_root;
+		return parentItem && !parentItem->fetched && !childNodes(parentItem).empty();
+	}
+
+	void fetchMore(QModelIndex const& parent)
+	{
+		auto* const parentItem = parent.isValid() ? itemFromIndex(parent) : &_root;
+		if (!parentItem || parentItem->fetched)
+		{
+			return;
+		}
+
+		auto const count = static_cast<int>(childNodes(parentItem).size());
+		if (count == 0)
+		{
+			parentItem->fetched = true;
+			return;
+		}
+
+		Q_Q(ControlledEntityTreeModel);
+
+		q->beginInsertRows(parent, 0, count - 1);
+		createChildren(parentItem);
+		q->endInsertRows();
+	}
+
+	QVariant data(QModelIndex const& index, int role) const
+	{
+		auto const* const item = itemFromIndex(index);
+		if (!item)
+		{
+			return {};
+		}
+
+		auto const& nodeInfo = _nodes[item->nodeInfoIndex];
+
+		switch (role)
+		{
+			case Qt::DisplayRole:
+				if (item->name.isNull())
+				{
+					auto& manager = avdecc::ControllerManager::getInstance();
+					auto controlledEntity = manager.getControlledEntity(_controlledEntityID);
+					if (!controlledEntity)
+					{
+						return {};
+					}
+					item->name = nodeInfo.nameGenerator(controlledEntity.get(), nodeInfo.node);
+				}
+				return item->name;
+			case Qt::FontRole:
+				if (nodeInfo.isActiveConfiguration)
+				{
+					QFont boldFont;
+					boldFont.setBold(true);
+					return boldFont;
+				}
+				break;
+			case Qt::UserRole:
+				return QVariant::fromValue(nodeInfo.anyNode);
+			case ControlledEntityTreeModel::KeyRole:
+				return item->key;
+			case ControlledEntityTreeModel::DefaultExpandedRole:
+				return nodeInfo.defaultExpanded;
+			default:
+				break;
+		}
+
+		return {};
+	}
+
+private:
+	using DescriptorKey = std::uint32_t;
+
+	static DescriptorKey makeDescriptorKey(la::avdecc::entity::model::DescriptorType const descriptorType, la::avdecc::entity::model::DescriptorIndex const descriptorIndex) noexcept
+	{
+		return (static_cast<DescriptorKey>(la::avdecc::to_integral(descriptorType)) << 16) | static_cast<DescriptorKey>(descriptorIndex);
+	}
+
+	TreeItem* itemFromIndex(QModelIndex const& index) const
+	{
+		if (!index.isValid())
+		{
+			return nullptr;
+		}
+		return static_cast<TreeItem*>(index.internalPointer());
+	}
+
+	std::vector<std::size_t> const& childNodes(TreeItem const* const item) const
+	{
+		return item == &_root ? _rootNodes : _nodes[item->nodeInfoIndex].children;
+	}
+
+	void clear()
+	{
+		_root.children.clear();
+		_root.fetched = false;
+		_nodes.clear();
+		_rootNodes.clear();
+		_nodeInfoIndexes.clear();
+		_descriptorItems.clear();
+		_memoryAccount.set(0);
+	}
+
+	void load()
+	{
+		Q_Q(ControlledEntityTreeModel);
+
+		q->beginResetModel();
+
+		clear();
+
+		if (_controlledEntityID)
+		{
+			auto& manager = avdecc::ControllerManager::getInstance();
+			auto controlledEntity = manager.getControlledEntity(_controlledEntityID);
+
+			if (controlledEntity)
+			{
+				controlledEntity->accept(this);
+				_nodeInfoIndexes.clear();
+				accountNodes();
+
+				// Top level rows are always shown
+				createChildren(&_root);
+			}
+		}
+
+		q->endResetModel();
+	}
+
+	void createChildren(TreeItem* const parentItem)
+	{
+		auto const& children = childNodes(parentItem);
+
+		parentItem->children.reserve(children.size());
+		for (auto const nodeInfoIndex : children)
+		{
+			auto const& nodeInfo = _nodes[nodeInfoIndex];
+
+			auto item = std::make_unique<TreeItem>();
+			item->nodeInfoIndex = nodeInfoIndex;
+			item->parent = parentItem;
+			item->row = static_cast<int>(parentItem->children.size());
+			item->key = (parentItem == &_root ? QString{} : parentItem->key + '/') + QString("%1.%2").arg(la::avdecc::to_integral(nodeInfo.node->descriptorType)).arg(nodeInfo.keyIndex);
+
+			if (nodeInfo.isDescriptorIndex)
+			{
+				_descriptorItems.insert({ makeDescriptorKey(nodeInfo.node->descriptorType, nodeInfo.keyIndex), item.get() });
+			}
+
+			_memoryAccount.add(static_cast<std::int64_t>(sizeof(TreeItem) + sizeof(std::unique_ptr<TreeItem>)) + profiler::stringBytes(item->key));
+			parentItem->children.push_back(std::move(item));
+		}
+		parentItem->fetched = true;
+	}
+
+	/** Accounts the collected nodes, created rows are added as they are fetched */
+	void accountNodes() noexcept
+	{
+		auto bytes = static_cast<std::int64_t>(_nodes.capacity() * sizeof(NodeInfo) + _rootNodes.capacity() * sizeof(std::size_t));
+		for (auto const& nodeInfo : _nodes)
+		{
+			bytes += static_cast<std::int64_t>(nodeInfo.children.capacity() * sizeof(std::size_t));
+		}
+		_memoryAccount.set(bytes);
+	}
+
+	void invalidateNames(la::avdecc::entity::model::DescriptorType const descriptorType, la::avdecc::entity::model::DescriptorIndex const descriptorIndex)
+	{
+		Q_Q(ControlledEntityTreeModel);
+
+		// Rows that are not created yet will get the new name when they are
+		auto const range = _descriptorItems.equal_range(makeDescriptorKey(descriptorType, descriptorIndex));
+		for (auto it = range.first; it != range.second; ++it)
+		{
+			auto* const item = it->second;
+			item->name = QString{};
+
+			auto const index = q->createIndex(item->row, 0, item);
+			emit q->dataChanged(index, index, { Qt::DisplayRole });
+		}
+	}
+
+	template<class NodeType>
+	void addNode(la::avdecc::controller::model::Node const* const parent, NodeType const* const node, NameGenerator const nameGenerator, la::avdecc::entity::model::DescriptorIndex const keyIndex, bool const isDescriptorIndex = true, bool const defaultExpanded = false, bool const isActiveConfiguration = false) noexcept
+	{
+		auto const nodeInfoIndex = _nodes.size();
+
+		auto nodeInfo = NodeInfo{};
+		nodeInfo.node = node;
+		nodeInfo.anyNode = AnyNode(node);
+		nodeInfo.nameGenerator = nameGenerator;
+		nodeInfo.keyIndex = keyIndex;
+		nodeInfo.isDescriptorIndex = isDescriptorIndex;
+		nodeInfo.defaultExpanded = defaultExpanded;
+		nodeInfo.isActiveConfiguration = isActiveConfiguration;
+		_nodes.push_back(std::move(nodeInfo));
+
+		// The visitor always visits a parent before its children
+		auto const parentIt = parent ? _nodeInfoIndexes.find(parent) : _nodeInfoIndexes.end();
+		if (parentIt != _nodeInfoIndexes.end())
+		{
+			_nodes[parentIt->second].children.push_back(nodeInfoIndex);
+		}
+		else
+		{
+			_rootNodes.push_back(nodeInfoIndex);
+		}
+
+		_nodeInfoIndexes.insert({ node, nodeInfoIndex });
+	}
+
+	virtual void visit(la::avdecc::controller::ControlledEntity const* const /*controlledEntity*/, la::avdecc::controller::model::Node const* const parent, la::avdecc::controller::model::EntityNode const& node) noexcept override
+	{
+		addNode(parent, &node, &entityNodeName, 0u, true, true);
+	}
+
+	virtual void visit(la::avdecc::controller::ControlledEntity const* const /*controlledEntity*/, la::avdecc::controller::model::Node const* const parent, la::avdecc::controller::model::ConfigurationNode const& node) noexcept override
+	{
+		auto const isActiveConfiguration = node.dynamicModel->isActiveConfiguration;
+		addNode(parent, &node, &configurationNodeName, node.descriptorIndex, true, isActiveConfiguration, isActiveConfiguration);
+	}
+
+	virtual void visit(la::avdecc::controller::ControlledEntity const* const /*controlledEntity*/, la::avdecc::controller::model::Node const* const parent, la::avdecc::controller::model::AudioUnitNode const& node) noexcept override
+	{
+		addNode(parent, &node, &objectNodeName<la::avdecc::controller::model::AudioUnitNode>, node.descriptorIndex);
+	}
+
+	virtual void visit(la::avdecc::controller::ControlledEntity const* const /*controlledEntity*/, la::avdecc::controller::model::Node const* const parent, la::avdecc::controller::model::StreamInputNode const& node) noexcept override
+	{
+		// Do not show redundant streams that have Configuration as direct parent
+		if (!node.isRedundant || parent->descriptorType != la::avdecc::entity::model::DescriptorType::Configuration)
+		{
+			addNode(parent, &node, &objectNodeName<la::avdecc::controller::model::StreamInputNode>, node.descriptorIndex);
+		}
+	}
+
+	virtual void visit(la::avdecc::controller::ControlledEntity const* const /*controlledEntity*/, la::avdecc::controller::model::Node const* const parent, la::avdecc::controller::model::StreamOutputNode const& node) noexcept override
+	{
+		// Do not show redundant streams that have Configuration as direct parent
+		if (!node.isRedundant || parent->descriptorType != la::avdecc::entity::model::DescriptorType::Configuration)
+		{
+			addNode(parent, &node, &objectNodeName<la::avdecc::controller::model::StreamOutputNode>, node.descriptorIndex);
+		}
+	}
+
+	virtual void visit(la::avdecc::controller::ControlledEntity const* const /*controlledEntity*/, la::avdecc::controller::model::Node const* const parent, la::avdecc::controller::model::AvbInterfaceNode const& node) noexcept override
+	{
+		addNode(parent, &node, &objectNodeName<la::avdecc::controller::model::AvbInterfaceNode>, node.descriptorIndex);
+	}
+
+	virtual void visit(la::avdecc::controller::ControlledEntity const* const /*controlledEntity*/, la::avdecc::controller::model::Node const* const parent, la::avdecc::controller::model::ClockSourceNode const& node) noexcept override
+	{
+		// Only add ClockSource nodes that are not direct parent of Configuration (use aliases only)
+		if (parent->descriptorType != la::avdecc::entity::model::DescriptorType::Configuration)
+		{
+			addNode(parent, &node, &objectNodeName<la::avdecc::controller::model::ClockSourceNode>, node.descriptorIndex);
+		}
+	}
+
+	virtual void visit(la::avdecc::controller::ControlledEntity const* const /*controlledEntity*/, la::avdecc::controller::model::Node const* const parent, la::avdecc::controller::model::LocaleNode const& node) noexcept override
+	{
+		addNode(parent, &node, &localeNodeName, node.descriptorIndex);
+	}
+
+	virtual void visit(la::avdecc::controller::ControlledEntity const* const /*controlledEntity*/, la::avdecc::controller::model::Node const* const parent, la::avdecc::controller::model::StringsNode const& node) noexcept override
+	{
+		addNode(parent, &node, &indexedNodeName<la::avdecc::controller::model::StringsNode>, node.descriptorIndex);
+	}
+
+	virtual void visit(la::avdecc::controller::ControlledEntity const* const /*controlledEntity*/, la::avdecc::controller::model::Node const* const parent, la::avdecc::controller::model::StreamPortNode const& node) noexcept override
+	{
+		addNode(parent, &node, &indexedNodeName<la::avdecc::controller::model::StreamPortNode>, node.descriptorIndex);
+	}
+
+	virtual void visit(la::avdecc::controller::ControlledEntity const* const /*controlledEntity*/, la::avdecc::controller::model::Node const* const parent, la::avdecc::controller::model::AudioClusterNode const& node) noexcept override
+	{
+		addNode(parent, &node, &objectNodeName<la::avdecc::controller::model::AudioClusterNode>, node.descriptorIndex);
+	}
+
+	virtual void visit(la::avdecc::controller::ControlledEntity const* const /*controlledEntity*/, la::avdecc::controller::model::Node const* const parent, la::avdecc::controller::model::AudioMapNode const& node) noexcept override
+	{
+		addNode(parent, &node, &indexedNodeName<la::avdecc::controller::model::AudioMapNode>, node.descriptorIndex);
+	}
+
+	virtual void visit(la::avdecc::controller::ControlledEntity const* const /*controlledEntity*/, la::avdecc::controller::model::Node const* const parent, la::avdecc::controller::model::ClockDomainNode const& node) noexcept override
+	{
+		addNode(parent, &node, &objectNodeName<la::avdecc::controller::model::ClockDomainNode>, node.descriptorIndex);
+	}
+
+	virtual void visit(la::avdecc::controller::ControlledEntity const* const /*controlledEntity*/, la::avdecc::controller::model::Node const* const parent, la::avdecc::controller::model::RedundantStreamNode const& node) noexcept override
+	{
+		addNode(parent, &node, &redundantStreamNodeName, node.virtualIndex, false);
+	}
+
+	virtual void visit(la::avdecc::controller::ControlledEntity const* const /*controlledEntity*/, la::avdecc::controller::model::Node const* const parent, la::avdecc::controller::model::MemoryObjectNode const& node) noexcept override
+	{
+		addNode(parent, &node, &objectNodeName<la::avdecc::controller::model::MemoryObjectNode>, node.descriptorIndex);
+	}
+
+private:
+	ControlledEntityTreeModel * const q_ptr{ nullptr };
+	Q_DECLARE_PUBLIC(ControlledEntityTreeModel);
+
+	la::avdecc::UniqueIdentifier _controlledEntityID{};
+	std::vector<NodeInfo> _nodes{};
+	std::vector<std::size_t> _rootNodes{};
+	std::unordered_map<la::avdecc::controller::model::Node const*, std::size_t> _nodeInfoIndexes{}; // Only used while visiting the model
+	TreeItem _root{};
+	std::unordered_multimap<DescriptorKey, TreeItem*> _descriptorItems{}; // Created rows only
+	profiler::MemoryAccount _memoryAccount{ profiler::MemorySubsystem::Inspector };
+};
+
+///////////////////////////////////////
+
+ControlledEntityTreeModel::ControlledEntityTreeModel(QObject* parent)
+	: QAbstractItemModel(parent)
+	, d_ptr(new ControlledEntityTreeModelPrivate(this))
+{
+}
+
+ControlledEntityTreeModel::~ControlledEntityTreeModel()
+{
+	delete d_ptr;
+}
+
+void ControlledEntityTreeModel::setControlledEntityID(la::avdecc::UniqueIdentifier const entityID)
+{
+	Q_D(ControlledEntityTreeModel);
+	d->setControlledEntityID(entityID);
+}
+
+la::avdecc::UniqueIdentifier ControlledEntityTreeModel::controlledEntityID() const
+{
+	Q_D(const ControlledEntityTreeModel);
+	return d->controlledEntityID();
+}
+
+la::avdecc::controller::model::Node const* ControlledEntityTreeModel::node(QModelIndex const& index) const
+{
+	Q_D(const ControlledEntityTreeModel);
+	return d->node(index);
+}
+
+QModelIndex ControlledEntityTreeModel::indexFromKey(QString const& key)
+{
+	Q_D(ControlledEntityTreeModel);
+	return d->indexFromKey(key);
+}
+
+QModelIndex ControlledEntityTreeModel::index(int row, int column, QModelIndex const& parent) const
+{
+	Q_D(const ControlledEntityTreeModel);
+	return d->index(row, column, parent);
+}
+
+QModelIndex ControlledEntityTreeModel::parent(QModelIndex const& child) const
+{
+	Q_D(const ControlledEntityTreeModel);
+	return d->parent(child);
+}
+
+int ControlledEntityTreeModel::rowCount(QModelIndex const& parent) const
+{
+	Q_D(const ControlledEntityTreeModel);
+	return d->rowCount(parent);
+}
+
+int ControlledEntityTreeModel::columnCount(QModelIndex const& /*parent*/) const
+{
+	return 1;
+}
+
+bool ControlledEntityTreeModel::hasChildren(QModelIndex const& parent) const
+{
+	Q_D(const ControlledEntityTreeModel);
+	return d->hasChildren(parent);
+}
+
+bool ControlledEntityTreeModel::canFetchMore(QModelIndex const& parent) const
+{
+	Q_D(const ControlledEntityTreeModel);
+	return d->canFetchMore(parent);
+}
+
+void ControlledEntityTreeModel::fetchMore(QModelIndex const& parent)
+{
+	Q_D(ControlledEntityTreeModel);
+	d->fetchMore(parent);
+}
+
+QVariant ControlledEntityTreeModel::data(QModelIndex const& index, int role) const
+{
+	Q_D(const ControlledEntityTreeModel);
+	return d->data(index, role);
+}
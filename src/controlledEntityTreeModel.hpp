@@ -0,0 +1,66 @@
+/*
+* Copyright 2017-2018, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be usefu_state,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#pragma once
+
+#include <QAbstractItemModel>
+#include <la/avdecc/internals/uniqueIdentifier.hpp>
+#include <la/avdecc/controller/internals/avdeccControlledEntity.hpp>
+
+class ControlledEntityTreeModelPrivate;
+
+/**
+* @brief Item model of the AEM of a controlled entity.
+* @details Rows are only created when their parent is expanded (canFetchMore/fetchMore), and their display name is only built when first requested.
+*          Qt::UserRole holds the AnyNode of the row, KeyRole a path identifying the row that is stable when the entity goes offline and online again.
+*/
+class ControlledEntityTreeModel : public QAbstractItemModel
+{
+	Q_OBJECT
+public:
+	static constexpr int KeyRole = Qt::UserRole + 1;
+	static constexpr int DefaultExpandedRole = Qt::UserRole + 2;
+
+	ControlledEntityTreeModel(QObject* parent = nullptr);
+	~ControlledEntityTreeModel();
+
+	void setControlledEntityID(la::avdecc::UniqueIdentifier const entityID);
+	la::avdecc::UniqueIdentifier controlledEntityID() const;
+
+	/** Returns the node of the specified index, or nullptr */
+	la::avdecc::controller::model::Node const* node(QModelIndex const& index) const;
+
+	/** Returns the index of the specified key, fetching all the rows along the path. Returns an invalid index if the key cannot be found */
+	QModelIndex indexFromKey(QString const& key);
+
+	// QAbstractItemModel overrides
+	virtual QModelIndex index(int row, int column, QModelIndex const& parent = QModelIndex()) const override;
+	virtual QModelIndex parent(QModelIndex const& child) const override;
+	virtual int rowCount(QModelIndex const& parent = QModelIndex()) const override;
+	virtual int columnCount(QModelIndex const& parent = QModelIndex()) const override;
+	virtual bool hasChildren(QModelIndex const& parent = QModelIndex()) const override;
+	virtual bool canFetchMore(QModelIndex const& parent) const override;
+	virtual void fetchMore(QModelIndex const& parent) override;
+	virtual QVariant data(QModelIndex const& index, int role = Qt::DisplayRole) const override;
+
+private:
+	ControlledEntityTreeModelPrivate * const d_ptr{ nullptr };
+	Q_DECLARE_PRIVATE(ControlledEntityTreeModel)
+};
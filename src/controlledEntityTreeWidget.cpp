@@ -17,23 +17,19 @@
 * along with Hive.  If not, see <http://www.gnu.org/licenses/>.
 */
 
+
 #include "controlledEntityTreeWidget.hpp"
+#include "controlledEntityTreeModel.hpp"
 
 #include <la/avdecc/controller/internals/avdeccControlledEntity.hpp>
 #include "avdecc/controllerManager.hpp"
-#include "avdecc/helper.hpp"
-
-#include "nodeVisitor.hpp"
 
 #include <QHeaderView>
 #include <QMenu>
+#include <QHash>
+#include <unordered_map>
 
-class TreeWidgetItem : public QObject, public QTreeWidgetItem
-{
-public:
-};
-
-class ControlledEntityTreeWidgetPrivate : public QObject, public la::avdecc::controller::model::EntityModelVisitor
+class ControlledEntityTreeWidgetPrivate : public QObject
 {
 public:
 	ControlledEntityTreeWidgetPrivate(ControlledEntityTreeWidget* q)
@@ -42,132 +38,93 @@ public:
 		auto& controllerManager = avdecc::ControllerManager::getInstance();
 
 		connect(&controllerManager, &avdecc::ControllerManager::controllerOffline, this, &ControlledEntityTreeWidgetPrivate::controllerOffline);
-		connect(&controllerManager, &avdecc::ControllerManager::entityOnline, this, &ControlledEntityTreeWidgetPrivate::entityOnline);
-		connect(&controllerManager, &avdecc::ControllerManager::entityOffline, this, &ControlledEntityTreeWidgetPrivate::entityOffline);
+
+		// Remember the current item before the model is reset (entity going offline), so it can be selected again when the entity comes back.
+		// The model already reports the new entity when switching, so use the one this widget displayed until now
+		connect(&_model, &QAbstractItemModel::modelAboutToBeReset, this, [this]()
+		{
+			Q_Q(ControlledEntityTreeWidget);
+
+			auto const currentIndex = q->currentIndex();
+			if (currentIndex.isValid())
+			{
+				_currentItemEntityID = _displayedEntityID;
+				_currentItemKey = currentIndex.data(ControlledEntityTreeModel::KeyRole).toString();
+			}
+		});
+		connect(&_model, &QAbstractItemModel::modelReset, this, &ControlledEntityTreeWidgetPrivate::modelReset);
+
+		// Rows are created when their parent is expanded, restore their own expanded state as they come
+		connect(&_model, &QAbstractItemModel::rowsInserted, this, [this](QModelIndex const& parent, int first, int last)
+		{
+			for (auto row = first; row <= last; ++row)
+			{
+				restoreExpandedState(_model.index(row, 0, parent));
+			}
+		});
+
+		// Track expanded state as it changes, so nothing has to be scanned when switching entity
+		connect(q, &QTreeView::expanded, this, [this](QModelIndex const& index)
+		{
+			setExpandedState(index, true);
+		});
+		connect(q, &QTreeView::collapsed, this, [this](QModelIndex const& index)
+		{
+			setExpandedState(index, false);
+		});
 	}
 
 	Q_SLOT void controllerOffline()
 	{
 		Q_Q(ControlledEntityTreeWidget);
 
-		q->setControlledEntityID(la::avdecc::UniqueIdentifier{});
+		// The model resets itself
 		q->clearSelection();
 
 		_entityExpandedStates.clear();
+		_displayedEntityID = la::avdecc::UniqueIdentifier{};
+		_currentItemEntityID = la::avdecc::UniqueIdentifier{};
+		_currentItemKey.clear();
 	}
 
-	Q_SLOT void entityOnline(la::avdecc::UniqueIdentifier const entityID)
-	{
-		loadCurrentControlledEntity();
-	}
-
-	Q_SLOT void entityOffline(la::avdecc::UniqueIdentifier const entityID)
+	void modelReset()
 	{
-		_entityExpandedStates.erase(entityID);
-
 		Q_Q(ControlledEntityTreeWidget);
-		q->clearSelection();
-	}
-
-	void saveExpandedState()
-	{
-		// Build expanded state
-		NodeExpandedStates states;
 
-		Q_Q(ControlledEntityTreeWidget);
-		for (auto const& kv : _map)
+		for (auto row = 0, count = _model.rowCount(); row < count; ++row)
 		{
-			auto const& node{ kv.first };
-			auto const& item{ kv.second };
-			states.insert({ node, q->isItemExpanded(item) });
+			restoreExpandedState(_model.index(row, 0));
 		}
 
-		// Save expanded state for previous EntityID
-		_entityExpandedStates[_controlledEntityID] = states;
-	}
-
-	void restoreExpandedState()
-	{
-		Q_Q(ControlledEntityTreeWidget);
-
-		// Load expanded state if any
-		auto const statesIt = _entityExpandedStates.find(_controlledEntityID);
-		if (statesIt != _entityExpandedStates.end())
+		// Select the previously selected node again
+		if (!_currentItemKey.isEmpty() && _currentItemEntityID == _model.controlledEntityID() && _model.rowCount() != 0)
 		{
-			// Restore expanded state
-			auto const& states = statesIt->second;
-			for (auto const& kv : _map)
+			auto const index = _model.indexFromKey(_currentItemKey);
+			if (index.isValid())
 			{
-				auto const& node{ kv.first };
-				auto const& item{ kv.second };
-				try
-				{
-					q->setItemExpanded(item, states.at(node));
-				}
-				catch (...)
-				{
-				}
+				q->setCurrentIndex(index);
+				q->scrollTo(index);
 			}
+			_currentItemKey.clear();
 		}
 	}
 
-	void loadCurrentControlledEntity()
-	{
-		Q_Q(ControlledEntityTreeWidget);
-
-		q->clear();
-		_map.clear();
-
-		if (!_controlledEntityID)
-			return;
-
-		auto& manager = avdecc::ControllerManager::getInstance();
-		auto controlledEntity = manager.getControlledEntity(_controlledEntityID);
-
-		if (controlledEntity)
-		{
-			controlledEntity->accept(this);
-		}
-
-		// Restore expanded state for new EntityID
-		restoreExpandedState();
-	}
-
 	void setControlledEntityID(la::avdecc::UniqueIdentifier const entityID)
 	{
-		if (_controlledEntityID == entityID)
-		{
-			return;
-		}
-
-		Q_Q(ControlledEntityTreeWidget);
-
-		if (_controlledEntityID)
-		{
-			saveExpandedState();
-		}
-
-		_controlledEntityID = entityID;
-
-		loadCurrentControlledEntity();
+		_model.setControlledEntityID(entityID);
+		_displayedEntityID = entityID;
 	}
 
 	la::avdecc::UniqueIdentifier controlledEntityID() const
 	{
-		return _controlledEntityID;
+		return _model.controlledEntityID();
 	}
 
 	void customContextMenuRequested(QPoint const& pos)
 	{
 		Q_Q(ControlledEntityTreeWidget);
 
-		auto const item = static_cast<TreeWidgetItem*>(q->itemAt(pos));
-		if (!item)
-		{
-			return;
-		}
-
-		auto const* node = find(item);
+		auto const* node = _model.node(q->indexAt(pos));
 		if (!node)
 		{
 			return;
@@ -189,252 +146,75 @@ public:
 			{
 				if (action == setAsCurrentConfigurationAction)
 				{
-					avdecc::ControllerManager::getInstance().setConfiguration(_controlledEntityID, configurationNode->descriptorIndex);
+					avdecc::ControllerManager::getInstance().setConfiguration(_model.controlledEntityID(), configurationNode->descriptorIndex);
 				}
 			}
 		}
 	}
 
-private:
-	la::avdecc::controller::model::Node const* find(TreeWidgetItem const* item)
-	{
-		for (auto const& it : _map)
-		{
-			if (it.second == item)
-			{
-				return it.first;
-			}
-		}
-
-		return nullptr;
-	}
-
-	TreeWidgetItem* find(la::avdecc::controller::model::Node const* const node)
+	ControlledEntityTreeModel* model() noexcept
 	{
-		return node ? _map.at(node) : nullptr;
+		return &_model;
 	}
 
-	template<typename T>
-	TreeWidgetItem* addItem(la::avdecc::controller::model::Node const* parent, T const* node, QString const& name) noexcept
+private:
+	void setExpandedState(QModelIndex const& index, bool const expanded)
 	{
-		auto* item = new TreeWidgetItem;
-
-		item->setData(0, Qt::DisplayRole, name);
-
-		auto const anyNode = AnyNode(node);
-		item->setData(0, Qt::UserRole, QVariant::fromValue(anyNode));
-
-		if (auto* parentItem = find(parent))
+		auto const entityID = _model.controlledEntityID();
+		if (entityID && index.isValid())
 		{
-			parentItem->addChild(item);
+			_entityExpandedStates[entityID][index.data(ControlledEntityTreeModel::KeyRole).toString()] = expanded;
 		}
-		else
-		{
-			Q_Q(ControlledEntityTreeWidget);
-			q->addTopLevelItem(item);
-		}
-
-		_map.insert({ node, item });
-
-		return item;
 	}
 
-	virtual void visit(la::avdecc::controller::ControlledEntity const* const controlledEntity, la::avdecc::controller::model::Node const* const parent, la::avdecc::controller::model::EntityNode const& node) noexcept override
+	/** Expands the row according to the saved state, or its default state if it has never been expanded nor collapsed. Expanding fetches its children */
+	void restoreExpandedState(QModelIndex const& index)
 	{
-		auto genName = [type = node.descriptorType](QString const& name)
-		{
-			return QString("%1: %2").arg(avdecc::helper::descriptorTypeToString(type), name);
-		};
-		auto* item = addItem(parent, &node, genName(node.dynamicModel->entityName.data()));
+		auto expanded = index.data(ControlledEntityTreeModel::DefaultExpandedRole).toBool();
 
-		connect(&avdecc::ControllerManager::getInstance(), &avdecc::ControllerManager::entityNameChanged, item, [genName, item](la::avdecc::UniqueIdentifier const entityID, QString const& entityName)
-		{
-			auto name = genName(entityName);
-			item->setData(0, Qt::DisplayRole, name);
-		});
-
-		Q_Q(ControlledEntityTreeWidget);
-		q->setItemExpanded(item, true);
-	}
-
-	virtual void visit(la::avdecc::controller::ControlledEntity const* const controlledEntity, la::avdecc::controller::model::Node const* const parent, la::avdecc::controller::model::ConfigurationNode const& node) noexcept override
-	{
-		auto genName = [type = node.descriptorType, index = node.descriptorIndex](QString const& name)
-		{
-			return QString("%1.%2: %3").arg(avdecc::helper::descriptorTypeToString(type), QString::number(index), name);
-		};
-		auto* item = addItem(parent, &node, genName(avdecc::helper::configurationName(controlledEntity, node)));
-
-		connect(&avdecc::ControllerManager::getInstance(), &avdecc::ControllerManager::configurationNameChanged, item, [this, genName, item, node](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, QString const& /*configurationName*/)
-		{
-			if (entityID == _controlledEntityID && configurationIndex == node.descriptorIndex)
-			{
-				auto& manager = avdecc::ControllerManager::getInstance();
-				auto controlledEntity = manager.getControlledEntity(entityID);
-
-				if (controlledEntity)
-				{
-					auto name = genName(avdecc::helper::configurationName(controlledEntity.get(), node));
-					item->setData(0, Qt::DisplayRole, name);
-				}
-			}
-		});
-
-		if (node.dynamicModel->isActiveConfiguration)
-		{
-			QFont boldFont;
-			boldFont.setBold(true);
-			item->setData(0, Qt::FontRole, boldFont);
-
-			Q_Q(ControlledEntityTreeWidget);
-			q->setItemExpanded(item, true);
-		}
-	}
-
-	template<class Node>
-	QString genName(la::avdecc::controller::ControlledEntity const* const controlledEntity, Node const& node)
-	{
-		return QString("%1.%2: %3").arg(avdecc::helper::descriptorTypeToString(node.descriptorType), QString::number(node.descriptorIndex), avdecc::helper::objectName(controlledEntity, node));
-	}
-	template<class Node>
-	void updateName(TreeWidgetItem* item, Node const& node, la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::DescriptorType const descriptorType, la::avdecc::entity::model::DescriptorIndex const descriptorIndex)
-	{
-		if (entityID == _controlledEntityID && descriptorType == node.descriptorType && descriptorIndex == node.descriptorIndex)
+		auto const statesIt = _entityExpandedStates.find(_model.controlledEntityID());
+		if (statesIt != _entityExpandedStates.end())
 		{
-			auto& manager = avdecc::ControllerManager::getInstance();
-			auto controlledEntity = manager.getControlledEntity(entityID);
-
-			// Filter configuration, we currently expand nodes only for current configuration
-			if (controlledEntity && configurationIndex == controlledEntity->getEntityNode().dynamicModel->currentConfiguration)
+			auto const stateIt = statesIt->second.find(index.data(ControlledEntityTreeModel::KeyRole).toString());
+			if (stateIt != statesIt->second.end())
 			{
-				auto name = genName(controlledEntity.get(), node);
-				item->setData(0, Qt::DisplayRole, name);
+				expanded = *stateIt;
 			}
 		}
-	}
-
-	virtual void visit(la::avdecc::controller::ControlledEntity const* const controlledEntity, la::avdecc::controller::model::Node const* const parent, la::avdecc::controller::model::AudioUnitNode const& node) noexcept override
-	{
-		auto const name = genName(controlledEntity, node);
-		addItem(parent, &node, name);
-	}
 
-	virtual void visit(la::avdecc::controller::ControlledEntity const* const controlledEntity, la::avdecc::controller::model::Node const* const parent, la::avdecc::controller::model::StreamInputNode const& node) noexcept override
-	{
-		// Do not show redundant streams that have Configuration as direct parent
-		if (!node.isRedundant || parent->descriptorType != la::avdecc::entity::model::DescriptorType::Configuration)
+		if (expanded)
 		{
-			auto const name = genName(controlledEntity, node);
-			auto* item = addItem(parent, &node, name);
-
-			connect(&avdecc::ControllerManager::getInstance(), &avdecc::ControllerManager::streamNameChanged, item, [this, item, node](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::DescriptorType const descriptorType, la::avdecc::entity::model::StreamIndex const streamIndex, QString const& /*streamName*/)
-			{
-				updateName(item, node, entityID, configurationIndex, descriptorType, streamIndex);
-			});
-		}
-	}
-
-	virtual void visit(la::avdecc::controller::ControlledEntity const* const controlledEntity, la::avdecc::controller::model::Node const* const parent, la::avdecc::controller::model::StreamOutputNode const& node) noexcept override
-	{
-		// Do not show redundant streams that have Configuration as direct parent
-		if (!node.isRedundant || parent->descriptorType != la::avdecc::entity::model::DescriptorType::Configuration)
-		{
-			auto const name = genName(controlledEntity, node);
-			auto* item = addItem(parent, &node, name);
-
-			connect(&avdecc::ControllerManager::getInstance(), &avdecc::ControllerManager::streamNameChanged, item, [this, item, node](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::DescriptorType const descriptorType, la::avdecc::entity::model::StreamIndex const streamIndex, QString const& /*streamName*/)
-			{
-				updateName(item, node, entityID, configurationIndex, descriptorType, streamIndex);
-			});
-		}
-	}
-
-	virtual void visit(la::avdecc::controller::ControlledEntity const* const controlledEntity, la::avdecc::controller::model::Node const* const parent, la::avdecc::controller::model::AvbInterfaceNode const& node) noexcept override
-	{
-		auto const name = genName(controlledEntity, node);
-		addItem(parent, &node, name);
-	}
-
-	virtual void visit(la::avdecc::controller::ControlledEntity const* const controlledEntity, la::avdecc::controller::model::Node const* const parent, la::avdecc::controller::model::ClockSourceNode const& node) noexcept override
-	{
-		// Only add ClockSource nodes that are not direct parent of Configuration (use aliases only)
-		if (parent->descriptorType != la::avdecc::entity::model::DescriptorType::Configuration)
-		{
-			auto const name = genName(controlledEntity, node);
-			addItem(parent, &node, name);
+			Q_Q(ControlledEntityTreeWidget);
+			q->setExpanded(index, true);
 		}
 	}
 
-	virtual void visit(la::avdecc::controller::ControlledEntity const* const controlledEntity, la::avdecc::controller::model::Node const* const parent, la::avdecc::controller::model::LocaleNode const& node) noexcept override
-	{
-		auto const name = QString("%1.%2: %3").arg(avdecc::helper::descriptorTypeToString(node.descriptorType), QString::number(node.descriptorIndex), node.staticModel->localeID.data());
-		addItem(parent, &node, name);
-	}
-
-	virtual void visit(la::avdecc::controller::ControlledEntity const* const controlledEntity, la::avdecc::controller::model::Node const* const parent, la::avdecc::controller::model::StringsNode const& node) noexcept override
-	{
-		auto const name = QString("%1.%2").arg(avdecc::helper::descriptorTypeToString(node.descriptorType), QString::number(node.descriptorIndex));
-		addItem(parent, &node, name);
-	}
-
-	virtual void visit(la::avdecc::controller::ControlledEntity const* const controlledEntity, la::avdecc::controller::model::Node const* const parent, la::avdecc::controller::model::StreamPortNode const& node) noexcept override
-	{
-		auto const name = QString("%1.%2").arg(avdecc::helper::descriptorTypeToString(node.descriptorType), QString::number(node.descriptorIndex));
-		addItem(parent, &node, name);
-	}
-
-	virtual void visit(la::avdecc::controller::ControlledEntity const* const controlledEntity, la::avdecc::controller::model::Node const* const parent, la::avdecc::controller::model::AudioClusterNode const& node) noexcept override
-	{
-		auto const name = genName(controlledEntity, node);
-		addItem(parent, &node, name);
-	}
-
-	virtual void visit(la::avdecc::controller::ControlledEntity const* const controlledEntity, la::avdecc::controller::model::Node const* const parent, la::avdecc::controller::model::AudioMapNode const& node) noexcept override
-	{
-		auto const name = QString("%1.%2").arg(avdecc::helper::descriptorTypeToString(node.descriptorType), QString::number(node.descriptorIndex));
-		addItem(parent, &node, name);
-	}
-
-	virtual void visit(la::avdecc::controller::ControlledEntity const* const controlledEntity, la::avdecc::controller::model::Node const* const parent, la::avdecc::controller::model::ClockDomainNode const& node) noexcept override
-	{
-		auto const name = genName(controlledEntity, node);
-		addItem(parent, &node, name);
-	}
-
-	virtual void visit(la::avdecc::controller::ControlledEntity const* const controlledEntity, la::avdecc::controller::model::Node const* const parent, la::avdecc::controller::model::RedundantStreamNode const& node) noexcept override
-	{
-		auto const name = QString("REDUNDANT_%1.%2").arg(avdecc::helper::descriptorTypeToString(node.descriptorType), QString::number(node.virtualIndex));
-		addItem(parent, &node, name);
-	}
-
-	virtual void visit(la::avdecc::controller::ControlledEntity const* const controlledEntity, la::avdecc::controller::model::Node const* const parent, la::avdecc::controller::model::MemoryObjectNode const& node) noexcept override
-	{
-		auto const name = genName(controlledEntity, node);
-		addItem(parent, &node, name);
-	}
-
 private:
 	ControlledEntityTreeWidget * const q_ptr{ nullptr };
 	Q_DECLARE_PUBLIC(ControlledEntityTreeWidget);
 
-	la::avdecc::UniqueIdentifier _controlledEntityID{};
-	std::unordered_map<la::avdecc::controller::model::Node const*, TreeWidgetItem*> _map;
+	ControlledEntityTreeModel _model{};
+	la::avdecc::UniqueIdentifier _displayedEntityID{}; // Updated once the model switched to the entity
+	la::avdecc::UniqueIdentifier _currentItemEntityID{}; // Entity _currentItemKey was recorded for
+	QString _currentItemKey{}; // Key of the item to select when the entity comes back online
 
-	using NodeExpandedStates = std::unordered_map<la::avdecc::controller::model::Node const*, bool>;
+	using NodeExpandedStates = QHash<QString, bool>; // Indexed by ControlledEntityTreeModel::KeyRole
 	std::unordered_map<la::avdecc::UniqueIdentifier, NodeExpandedStates, la::avdecc::UniqueIdentifier::hash> _entityExpandedStates;
 };
 
 ControlledEntityTreeWidget::ControlledEntityTreeWidget(QWidget* parent)
-	: QTreeWidget(parent)
+	: QTreeView(parent)
 	, d_ptr(new ControlledEntityTreeWidgetPrivate(this))
 {
+	setModel(d_ptr->model());
 	setSelectionBehavior(QAbstractItemView::SelectRows);
 	setSelectionMode(QAbstractItemView::SingleSelection);
+	setUniformRowHeights(true);
 	header()->hide();
 
 	setContextMenuPolicy(Qt::CustomContextMenu);
 
-	connect(this, &QTreeWidget::customContextMenuRequested, this, [this](QPoint const& pos)
+	connect(this, &QTreeView::customContextMenuRequested, this, [this](QPoint const& pos)
 	{
 		Q_D(ControlledEntityTreeWidget);
 		d->customContextMenuRequested(pos);
@@ -19,12 +19,14 @@
 
 #pragma once
 
-#include <QTreeWidget>
+#include <QTreeView>
 #include <la/avdecc/internals/uniqueIdentifier.hpp>
 #include <la/avdecc/controller/internals/avdeccControlledEntity.hpp>
 
 class ControlledEntityTreeWidgetPrivate;
-class ControlledEntityTreeWidget : public QTreeWidget
+
+/** View of the AEM of a controlled entity, backed by a ControlledEntityTreeModel so rows are only created when their parent is expanded */
+class ControlledEntityTreeWidget : public QTreeView
 {
 	Q_OBJECT
 public:
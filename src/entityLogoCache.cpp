@@ -19,75 +19,149 @@
 
 #include "entityLogoCache.hpp"
 #include "avdecc/helper.hpp"
+#include "avdecc/memoryObjectDownloadManager.hpp"
+#include "settingsManager/settings.hpp"
+#include "profiler/memoryAccounting.hpp"
 
 #include <QStandardPaths>
 #include <QFileInfo>
+#include <QFile>
 #include <QDir>
 #include <QApplication>
 #include <QtGlobal>
 #include <QThread>
+#include <QThreadPool>
+#include <QRunnable>
+#include <QCryptographicHash>
+#include <QSet>
+#include <QCache>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <optional>
 
-inline uint qHash(EntityLogoCache::Type const type, uint seed = 0) {
-	return qHash(static_cast<int>(type), seed);
-}
+/** Runs a function in a QThreadPool */
+class FunctionRunnable : public QRunnable
+{
+public:
+	FunctionRunnable(std::function<void()>&& function)
+		: _function(std::move(function))
+	{
+	}
+
+	virtual void run() override
+	{
+		_function();
+	}
+
+private:
+	std::function<void()> _function{};
+};
 
-class EntityLogoCacheImpl : public EntityLogoCache
+class EntityLogoCacheImpl : public EntityLogoCache, private settings::SettingsManager::Observer
 {
 public:
-	virtual QImage getImage(la::avdecc::UniqueIdentifier const entityID, Type const type, bool const downloadIfNotInCache) noexcept override
+	EntityLogoCacheImpl()
 	{
-		Q_ASSERT_X(QThread::currentThread() == qApp->thread(), "EntityLogoCache", "getImage must be called in the GUI thread.");
+		// Disk lookups, decodes and writes are done off the GUI thread, in a small bounded pool
+		_ioPool.setMaxThreadCount(MaxIoThreads);
 
-		auto const key{makeKey(entityID)};
+		// Register to settings::SettingsManager
+		auto& settings = settings::SettingsManager::getInstance();
+		settings.registerSettingObserver(settings::LogoCacheMemoryBudget.name, this);
 
-		// Check if we have something in the memory cache for this key (entityID-entityModelID)
-		auto imagesIt = _cache.find(key);
-		if (imagesIt != _cache.end())
+		// Forget offline entities, so they are not notified (nor used to download) anymore
+		connect(&avdecc::ControllerManager::getInstance(), &avdecc::ControllerManager::entityOffline, this, [this](la::avdecc::UniqueIdentifier const entityID)
 		{
-			// Check if we have the specified image type in the memory cache
-			auto imageIt = imagesIt->find(type);
-			if (imageIt != imagesIt->end())
+			for (auto& entry : _entries)
 			{
-				// Return the cached image (might be an empty QImage if the download is in progress)
-				return imageIt.value();
+				entry.entities.remove(entityID.getValue());
 			}
-		}
+		});
+	}
+
+	~EntityLogoCacheImpl()
+	{
+		// Remove settings observers
+		auto& settings = settings::SettingsManager::getInstance();
+		settings.unregisterSettingObserver(settings::LogoCacheMemoryBudget.name, this);
 
-		QImage image;
+		_ioPool.waitForDone();
+	}
 
-		// Try to load from the disk
-		QFileInfo fileInfo{imagePath(entityID, type)};
-		if (fileInfo.exists())
+	virtual QImage getImage(la::avdecc::UniqueIdentifier const entityID, Type const type, bool const downloadIfNotInCache) noexcept override
+	{
+		return getImage(entityID, computeEntityKey(entityID), type, downloadIfNotInCache);
+	}
+
+	virtual QImage getImage(la::avdecc::UniqueIdentifier const entityID, EntityLogoCache::Key const& entityKey, Type const type, bool const downloadIfNotInCache) noexcept override
+	{
+		Q_ASSERT_X(QThread::currentThread() == qApp->thread(), "EntityLogoCache", "getImage must be called in the GUI thread.");
+
+		auto const key{ makeKey(entityKey, type) };
+		if (!key)
 		{
-			// Found the image on the disk, add it to the memory cache
-			image = QImage{fileInfo.filePath()};
-			_cache[key][type] = image;
+			return {};
 		}
-		else if (downloadIfNotInCache)
+
+		auto& entry = _entries[*key];
+		entry.type = type;
+		// Remember this entity so it is notified when the (shared) image becomes available
+		entry.entities.insert(entityID.getValue());
+
+		switch (entry.state)
 		{
-			// Add a temporary empty QImage in the memory cache so we won't start another download while this one is pending
-			_cache[key][type] = image;
-			downloadImage(entityID, type);
+			case State::Unknown:
+				// Never looked for this image, check the disk asynchronously (will download it if not found and requested)
+				entry.state = State::Loading;
+				entry.downloadRequested = downloadIfNotInCache;
+				loadImage(*key);
+				break;
+			case State::Loading:
+				// Remember the download request, it will be processed when the disk lookup completes
+				entry.downloadRequested |= downloadIfNotInCache;
+				break;
+			case State::Missing:
+				if (downloadIfNotInCache)
+				{
+					entry.state = State::Downloading;
+					downloadImage(entityID, *key);
+				}
+				break;
+			case State::Loaded:
+				if (auto const* const image = _images.object(entry.contentHash))
+				{
+					return *image;
+				}
+				// Evicted from the memory cache, reload it from the disk
+				entry.state = State::Loading;
+				entry.downloadRequested = downloadIfNotInCache;
+				loadImage(*key);
+				break;
+			default:
+				break;
 		}
-		
-		return image;
+
+		// Empty QImage placeholder while loading or downloading
+		return {};
 	}
 
 	virtual bool isImageInCache(la::avdecc::UniqueIdentifier const entityID, Type const type) const noexcept override
 	{
 		Q_ASSERT_X(QThread::currentThread() == qApp->thread(), "EntityLogoCache", "isImageInCache must be called in the GUI thread.");
 
-		auto const key{ makeKey(entityID) };
-		auto imagesIt = _cache.find(key);
-		if (imagesIt != _cache.end())
+		auto const key{ makeKey(computeEntityKey(entityID), type) };
+		if (!key)
 		{
-			// Check if we have the specified image type in the memory cache
-			auto imageIt = imagesIt->find(type);
-			if (imageIt != imagesIt->end())
-			{
-				// The image has been found in the memory cache (either a real one, or a temporary one)
-				return true;
-			}
+			return false;
+		}
+
+		auto const entryIt = _entries.find(*key);
+		if (entryIt != _entries.end())
+		{
+			// The image has been found in the memory cache (either a real one, or one being loaded or downloaded)
+			return entryIt->state != State::Unknown && entryIt->state != State::Missing;
 		}
 
 		return false;
@@ -97,20 +171,127 @@ public:
 	{
 		Q_ASSERT_X(QThread::currentThread() == qApp->thread(), "EntityLogoCache", "clear must be called in the GUI thread.");
 
-		QDir dir(imageDir());
-		dir.removeRecursively();
+		// Loads, downloads and writes started before now are dropped when they complete
+		++_generation;
+
+		runInPool([dirPath = imageDir()]()
+		{
+			QDir dir(dirPath);
+			dir.removeRecursively();
+		});
+
+		auto const entries{ std::move(_entries) };
+		_entries.clear();
+		_images.clear();
+		_contentHashes.clear();
+		_thumbnails.clear();
+		_pendingThumbnails.clear();
+		updateMemoryAccount();
+
+		for (auto const& entry : entries)
+		{
+			notifyEntities(entry);
+		}
+	}
+
+	virtual QPixmap getThumbnail(QImage const& image, int const height, qreal const devicePixelRatio) noexcept override
+	{
+		Q_ASSERT_X(QThread::currentThread() == qApp->thread(), "EntityLogoCache", "getThumbnail must be called in the GUI thread.");
+
+		if (image.isNull() || height <= 0)
+		{
+			return {};
+		}
+
+		// Logos are identified by their content (so a thumbnail survives the eviction of its full image), other images by their cacheKey
+		auto const contentHashIt = _contentHashes.find(image.cacheKey());
+		auto const isLogo = contentHashIt != _contentHashes.end();
+		auto const sourceKey = isLogo ? QString::fromLatin1(*contentHashIt) : QString::number(image.cacheKey());
+		auto const thumbnailKey = QString{ "%1@%2x%3" }.arg(sourceKey).arg(height).arg(devicePixelRatio);
+
+		if (auto const* const pixmap = _thumbnails.object(thumbnailKey))
+		{
+			return *pixmap;
+		}
+
+		auto const targetHeight = static_cast<int>(height * devicePixelRatio);
 
-		auto const keys{ _cache.keys() };
-		_cache.clear();
+		// Not one of our images (icons from the resources), scale it right away, only once
+		if (!isLogo)
+		{
+			return insertThumbnail(thumbnailKey, makeThumbnail(image, targetHeight), devicePixelRatio);
+		}
 
-		for (auto const& key : keys)
+		if (!_pendingThumbnails.contains(thumbnailKey))
 		{
-			emit imageChanged(key.first, Type::Entity);
-			emit imageChanged(key.first, Type::Manufacturer);
+			_pendingThumbnails.insert(thumbnailKey);
+			runInPool([this, image, targetHeight, devicePixelRatio, thumbnailKey, contentHash = *contentHashIt]()
+			{
+				auto thumbnail = makeThumbnail(image, targetHeight);
+
+				QMetaObject::invokeMethod(this, [this, thumbnailKey, contentHash, devicePixelRatio, thumbnail = std::move(thumbnail)]()
+				{
+					if (!_pendingThumbnails.remove(thumbnailKey))
+					{
+						// Cache has been cleared in the meantime
+						return;
+					}
+
+					insertThumbnail(thumbnailKey, thumbnail, devicePixelRatio);
+
+					for (auto const& entry : _entries)
+					{
+						if (entry.state == State::Loaded && entry.contentHash == contentHash)
+						{
+							notifyEntities(entry);
+						}
+					}
+				});
+			});
 		}
+
+		return {};
 	}
 
 private:
+	// settings::SettingsManager::Observer overrides
+	virtual void onSettingChanged(settings::SettingsManager::Setting const& name, QVariant const& value) noexcept override
+	{
+		if (name == settings::LogoCacheMemoryBudget.name)
+		{
+			// Budget is in MiB, cache costs are in KiB. A quarter of the budget is dedicated to thumbnails
+			auto const budget = std::max(1, value.toInt()) * 1024;
+			_thumbnails.setMaxCost(budget / 4);
+			_images.setMaxCost(budget - budget / 4);
+			updateMemoryAccount();
+		}
+	}
+
+	static constexpr int MaxIoThreads = 2;
+
+	enum class State
+	{
+		Unknown, /**< Not looked for yet */
+		Loading, /**< Looking for the image on the disk */
+		Missing, /**< Not on the disk, and no download requested yet */
+		Downloading, /**< Downloading from the entity */
+		Loaded, /**< Image available */
+	};
+
+	/** Key identifying a logo: the type of the logo and the EntityLogoCache::Key of the entities sharing it */
+	using Key = QString;
+	/** Hash of the PNG data (hex encoded) */
+	using ContentHash = QByteArray;
+
+	struct Entry
+	{
+		Type type{ Type::None };
+		State state{ State::Unknown };
+		bool downloadRequested{ false };
+		ContentHash contentHash{};
+		QSet<quint64> entities{};
+	};
+
 	QString typeToString(Type const type) const noexcept
 	{
 		switch (type)
@@ -124,88 +305,302 @@ private:
 				return "Unsupported";
 		}
 	}
-	
-	using Key = QPair<quint64, quint64>;
-	
-	Key makeKey(la::avdecc::UniqueIdentifier const entityID) const noexcept
+
+	/** Computes the EntityLogoCache::Key of an online entity, locking it */
+	static EntityLogoCache::Key computeEntityKey(la::avdecc::UniqueIdentifier const entityID) noexcept
 	{
 		auto& manager = avdecc::ControllerManager::getInstance();
 		auto controlledEntity = manager.getControlledEntity(entityID);
-		auto const entityModelID = controlledEntity->getEntity().getEntityModelID();
-		return qMakePair(entityID.getValue(), entityModelID.getValue());
+		if (!controlledEntity)
+		{
+			return {};
+		}
+		return EntityLogoCache::makeKey(*controlledEntity);
 	}
-	
-	QString fileName(la::avdecc::UniqueIdentifier const entityID, Type const type) const noexcept
+
+	std::optional<Key> makeKey(EntityLogoCache::Key const& entityKey, Type const type) const noexcept
 	{
-		auto const key{makeKey(entityID)};
-		return QString{typeToString(type) + '-' + avdecc::helper::uniqueIdentifierToString(key.first) + '-' + avdecc::helper::uniqueIdentifierToString(key.second)};
+		if (entityKey.isEmpty())
+		{
+			return std::nullopt;
+		}
+		return typeToString(type) + '-' + entityKey;
 	}
-	
+
 	QString imageDir() const noexcept
 	{
 		return QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation) + '/' + QCoreApplication::applicationName();
 	}
-	
-	QString imagePath(la::avdecc::UniqueIdentifier const entityID, Type const type) const noexcept
+
+	/** Path of the file containing the ContentHash of the logo for the specified Key */
+	QString indexPath(Key const& key) const noexcept
 	{
-		return imageDir() + '/' + fileName(entityID, type) + ".png";
+		return imageDir() + "/models/" + key;
 	}
-	
-	void downloadImage(la::avdecc::UniqueIdentifier const entityID, Type const type) noexcept
+
+	/** Path of the PNG file for the specified ContentHash */
+	QString contentPath(ContentHash const& contentHash) const noexcept
 	{
+		return imageDir() + "/content/" + QString::fromLatin1(contentHash) + ".png";
+	}
+
+	static ContentHash computeContentHash(QByteArray const& data) noexcept
+	{
+		return QCryptographicHash::hash(data, QCryptographicHash::Sha256).toHex();
+	}
+
+	/** Cost of an image in KiB */
+	static int imageCost(QImage const& image) noexcept
+	{
+		return std::max(1, image.bytesPerLine() * image.height() / 1024);
+	}
+
+	/** Scales the image down to the specified height (in device pixels) and converts it to the fastest format to draw. Can be called from any thread */
+	static QImage makeThumbnail(QImage const& image, int const targetHeight) noexcept
+	{
+		auto const thumbnail = image.height() > targetHeight ? image.scaledToHeight(targetHeight, Qt::SmoothTransformation) : image;
+		return thumbnail.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+	}
+
+	QPixmap insertThumbnail(QString const& thumbnailKey, QImage const& thumbnail, qreal const devicePixelRatio) noexcept
+	{
+		auto* pixmap = new QPixmap{ QPixmap::fromImage(thumbnail) };
+		pixmap->setDevicePixelRatio(devicePixelRatio);
+		auto const result = *pixmap;
+		_thumbnails.insert(thumbnailKey, pixmap, std::min(imageCost(thumbnail), _thumbnails.maxCost()));
+		updateMemoryAccount();
+		return result;
+	}
+
+	/** Both caches costs are in KiB, and already account for evictions */
+	void updateMemoryAccount() noexcept
+	{
+		_memoryAccount.set((static_cast<std::int64_t>(_images.totalCost()) + static_cast<std::int64_t>(_thumbnails.totalCost())) * 1024);
+	}
+
+	void runInPool(std::function<void()>&& function) noexcept
+	{
+		auto* runnable = new FunctionRunnable(std::move(function));
+		runnable->setAutoDelete(true);
+		_ioPool.start(runnable);
+	}
+
+	void notifyEntities(Entry const& entry) noexcept
+	{
+		for (auto const entityID : entry.entities)
+		{
+			emit imageChanged(la::avdecc::UniqueIdentifier{ entityID }, entry.type);
+		}
+	}
+
+	/** Stores the image for the specified key, sharing the decoded image with other keys having the same content */
+	void setImage(Key const& key, ContentHash const& contentHash, QImage const& image) noexcept
+	{
+		auto const entryIt = _entries.find(key);
+		if (entryIt == _entries.end())
+		{
+			return;
+		}
+
+		if (!image.isNull() && !_images.contains(contentHash))
+		{
+			// Forget evicted images
+			for (auto it = _contentHashes.begin(); it != _contentHashes.end();)
+			{
+				if (!_images.contains(*it))
+				{
+					it = _contentHashes.erase(it);
+				}
+				else
+				{
+					++it;
+				}
+			}
+
+			// An image larger than the whole budget still has to be kept until the next one comes in
+			_images.insert(contentHash, new QImage{ image }, std::min(imageCost(image), _images.maxCost()));
+			_contentHashes.insert(image.cacheKey(), contentHash);
+			updateMemoryAccount();
+		}
+
+		entryIt->state = State::Loaded;
+		entryIt->contentHash = contentHash;
+		notifyEntities(*entryIt);
+	}
+
+	/** Looks for the image on the disk and decodes it in the IO pool, then updates the cache in the GUI thread */
+	void loadImage(Key const& key) noexcept
+	{
+		// Already decoded for another key, only the index has to be read
+		auto knownImages = _images.keys().toSet();
+
+		runInPool([this, key, generation = _generation.load(), indexFilePath = indexPath(key), contentDirPath = imageDir() + "/content/", knownImages = std::move(knownImages)]()
+		{
+			auto contentHash = ContentHash{};
+			auto image = QImage{};
+
+			QFile indexFile{ indexFilePath };
+			if (indexFile.open(QIODevice::ReadOnly))
+			{
+				contentHash = indexFile.readAll().trimmed();
+				if (!contentHash.isEmpty() && !knownImages.contains(contentHash))
+				{
+					auto const filePath = contentDirPath + QString::fromLatin1(contentHash) + ".png";
+					if (QFileInfo::exists(filePath))
+					{
+						image = QImage{ filePath };
+					}
+				}
+			}
+
+			QMetaObject::invokeMethod(this, [this, key, generation, contentHash = std::move(contentHash), image = std::move(image)]()
+			{
+				auto const entryIt = _entries.find(key);
+				if (generation != _generation || entryIt == _entries.end() || entryIt->state != State::Loading)
+				{
+					// Cache has been cleared in the meantime
+					return;
+				}
+
+				if (!contentHash.isEmpty() && (!image.isNull() || _images.contains(contentHash)))
+				{
+					setImage(key, contentHash, image);
+				}
+				else if (entryIt->downloadRequested && !entryIt->entities.isEmpty())
+				{
+					entryIt->state = State::Downloading;
+					downloadImage(la::avdecc::UniqueIdentifier{ *entryIt->entities.constBegin() }, key);
+				}
+				else
+				{
+					entryIt->state = State::Missing;
+				}
+			});
+		});
+	}
+
+	/** Writes the downloaded PNG data (if not already on the disk) and the index to the disk in the IO pool */
+	void saveImage(Key const& key, ContentHash const& contentHash, QByteArray const& data) noexcept
+	{
+		runInPool([this, generation = _generation.load(), filePath = contentPath(contentHash), indexFilePath = indexPath(key), contentHash, data]()
+		{
+			// Cache has been cleared since the download completed, do not write in the new cache
+			if (generation != _generation)
+			{
+				return;
+			}
+
+			// Make sure the directories exist
+			QDir().mkpath(QFileInfo{ filePath }.absolutePath());
+			QDir().mkpath(QFileInfo{ indexFilePath }.absolutePath());
+
+			// Content is immutable, only write it once
+			if (!QFileInfo::exists(filePath))
+			{
+				QFile file{ filePath };
+				if (file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+				{
+					file.write(data);
+				}
+			}
+
+			QFile indexFile{ indexFilePath };
+			if (indexFile.open(QIODevice::WriteOnly | QIODevice::Truncate))
+			{
+				indexFile.write(contentHash);
+			}
+		});
+	}
+
+	void downloadFailed(Key const& key) noexcept
+	{
+		auto const entryIt = _entries.find(key);
+		if (entryIt != _entries.end() && entryIt->state == State::Downloading)
+		{
+			// Allow a new download request
+			entryIt->state = State::Missing;
+		}
+	}
+
+	/** Downloads the logo for the specified key from the specified entity (any entity sharing the key will do) */
+	void downloadImage(la::avdecc::UniqueIdentifier const entityID, Key const& key) noexcept
+	{
+		auto const entryIt = _entries.find(key);
+		if (entryIt == _entries.end())
+		{
+			return;
+		}
+		auto const type = entryIt->type;
+
 		auto& manager = avdecc::ControllerManager::getInstance();
 		auto controlledEntity = manager.getControlledEntity(entityID);
-		
+
 		if (!controlledEntity)
 		{
+			downloadFailed(key);
 			return;
 		}
-		
+
+		auto downloadStarted = false;
+
 		try
 		{
 			auto const& configurationNode{controlledEntity->getCurrentConfigurationNode()};
-			
+
 			for (auto const& it : configurationNode.memoryObjects)
 			{
 				auto const& obj{it.second};
 				auto const& model{obj.staticModel};
-				
+
 				if (
 						(type == Type::Entity && model->memoryObjectType == la::avdecc::entity::model::MemoryObjectType::PngEntity) ||
 						(type == Type::Manufacturer && model->memoryObjectType == la::avdecc::entity::model::MemoryObjectType::PngManufacturer)
 						)
 				{
-					manager.readDeviceMemory(entityID, model->startAddress, model->maximumLength, [this, entityID, type](la::avdecc::controller::ControlledEntity const* const /*entity*/, la::avdecc::entity::ControllerEntity::AaCommandStatus const status, la::avdecc::controller::Controller::DeviceMemoryBuffer const& memoryBuffer)
+					downloadStarted = true;
+					// Logos are usually much smaller than the memory object, stop reading at the end of the PNG
+					auto& downloadManager = avdecc::MemoryObjectDownloadManager::getInstance();
+					downloadManager.download(entityID, model->startAddress, model->maximumLength, true, [this, key, generation = _generation.load()](avdecc::MemoryObjectDownloadManager::Status const status, QByteArray const& data)
 					{
-						auto image = QImage::fromData(memoryBuffer.data(), memoryBuffer.size());
+						// Cache has been cleared in the meantime (the entry is gone, or belongs to a new download)
+						if (generation != _generation)
+						{
+							return;
+						}
 
-						// Be sure to run this code in the UI thread so we don't have to lock the cache
-						QMetaObject::invokeMethod(this, [this, entityID, type, status, image = std::move(image)]()
+						if (status != avdecc::MemoryObjectDownloadManager::Status::Success)
 						{
-							auto const key = makeKey(entityID);
-							if (!!status && !image.isNull())
-							{
-								QFileInfo fileInfo{ imagePath(entityID, type) };
+							downloadFailed(key);
+							return;
+						}
 
-								// Make sure this directory exists & save the image to the disk
-								QDir().mkpath(fileInfo.absoluteDir().absolutePath());
-								image.save(fileInfo.filePath());
+						// Decode and hash in the IO pool (not the GUI thread)
+						runInPool([this, key, generation, data]()
+						{
+							auto image = QImage::fromData(data);
+							auto contentHash = computeContentHash(data);
 
-								// Save the image to the cache
-								_cache[key][type] = image;
-								emit imageChanged(entityID, type);
-							}
-							else
+							// Be sure to run this code in the UI thread so we don't have to lock the cache
+							QMetaObject::invokeMethod(this, [this, key, generation, data, image = std::move(image), contentHash = std::move(contentHash)]()
 							{
-								// Error downloading the image, remove the temporary one from the cache
-								auto imagesIt = _cache.find(key);
-								if (imagesIt != _cache.end())
+								if (generation != _generation)
 								{
-									imagesIt->remove(type);
+									return;
 								}
-							}
+
+								if (!image.isNull())
+								{
+									saveImage(key, contentHash, data);
+									setImage(key, contentHash, image);
+								}
+								else
+								{
+									downloadFailed(key);
+								}
+							});
 						});
 					});
+					break;
 				}
 			}
 		}
@@ -213,13 +608,48 @@ private:
 		{
 			AVDECC_ASSERT(false, "Failed to find logo descriptor information in AEM");
 		}
+
+		if (!downloadStarted)
+		{
+			downloadFailed(key);
+		}
 	}
-	
+
 private:
-	using CacheData = QHash<Type, QImage>;
-	QHash<Key, CacheData> _cache;
+	QHash<Key, Entry> _entries{};
+	QCache<ContentHash, QImage> _images{}; // LRU of decoded images, cost in KiB
+	QHash<qint64, ContentHash> _contentHashes{}; // QImage::cacheKey to ContentHash, for images in _images
+	QCache<QString, QPixmap> _thumbnails{}; // LRU of pre-scaled images, cost in KiB
+	QSet<QString> _pendingThumbnails{};
+	std::atomic<std::uint32_t> _generation{ 0u }; // Incremented by clear(), also read from the IO pool
+	QThreadPool _ioPool{};
+	profiler::MemoryAccount _memoryAccount{ profiler::MemorySubsystem::LogoCache };
 };
 
+EntityLogoCache::Key EntityLogoCache::makeKey(la::avdecc::controller::ControlledEntity const& controlledEntity) noexcept
+{
+	auto const entityModelID = controlledEntity.getEntity().getEntityModelID();
+	// No EntityModelID, cannot share the logo with other entities
+	if (!entityModelID)
+	{
+		return "Entity-" + avdecc::helper::uniqueIdentifierToString(controlledEntity.getEntity().getEntityID());
+	}
+
+	auto firmwareVersion = QString{};
+	try
+	{
+		firmwareVersion = controlledEntity.getEntityNode().dynamicModel->firmwareVersion.data();
+	}
+	catch (...)
+	{
+		// No AEM, logos cannot be downloaded anyway
+	}
+
+	// Only keep characters safe for a file name
+	auto const firmware = QString::fromLatin1(firmwareVersion.toUtf8().toHex());
+	return avdecc::helper::uniqueIdentifierToString(entityModelID) + '-' + firmware;
+}
+
 EntityLogoCache& EntityLogoCache::getInstance() noexcept
 {
 	static EntityLogoCacheImpl s_LogoCache{};
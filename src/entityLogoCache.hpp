@@ -21,6 +21,7 @@
 
 #include <QObject>
 #include <QImage>
+#include <QPixmap>
 #include <QHash>
 
 #include "avdecc/controllerManager.hpp"
@@ -36,10 +37,20 @@ public:
 		Manufacturer
 	};
 	
+	/** Identifies the logos of an entity: all entities sharing the same EntityModelID and firmware share the same logos. Empty if unknown */
+	using Key = QString;
+
 	static EntityLogoCache& getInstance() noexcept;
-	
+
+	/** Computes the Key of an entity. Views painting logos often should compute it once, when the entity comes online, and use the getImage overload taking it */
+	static Key makeKey(la::avdecc::controller::ControlledEntity const& controlledEntity) noexcept;
+
 	virtual QImage getImage(la::avdecc::UniqueIdentifier const entityID, Type const type, bool const downloadIfNotInCache = false) noexcept = 0;
+	/** Same as above, without having to lock the entity to compute its Key */
+	virtual QImage getImage(la::avdecc::UniqueIdentifier const entityID, Key const& key, Type const type, bool const downloadIfNotInCache = false) noexcept = 0;
 	virtual bool isImageInCache(la::avdecc::UniqueIdentifier const entityID, Type const type) const noexcept = 0;
+	/** Returns a pixmap of the image scaled down to fit the specified height (in device independent pixels). For an image returned by getImage, the pixmap is built asynchronously (a null pixmap is returned and imageChanged is emitted when ready). */
+	virtual QPixmap getThumbnail(QImage const& image, int const height, qreal const devicePixelRatio) noexcept = 0;
 
 	virtual void clear() noexcept = 0;
 
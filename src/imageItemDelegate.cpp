@@ -1,5 +1,6 @@
 #include "imageItemDelegate.hpp"
 #include "painterHelper.hpp"
+#include "entityLogoCache.hpp"
 
 void ImageItemDelegate::paint(QPainter* painter, QStyleOptionViewItem const& option, QModelIndex const& index) const
 {
@@ -11,6 +12,8 @@ void ImageItemDelegate::paint(QPainter* painter, QStyleOptionViewItem const& opt
 		return;
 	}
 	
+	// Pre-scaled pixmap, so painting is a simple blit
 	auto const image = userData.value<QImage>();
-	painterHelper::drawCentered(painter, option.rect, image);
+	auto const thumbnail = EntityLogoCache::getInstance().getThumbnail(image, option.rect.height(), painter->device()->devicePixelRatioF());
+	painterHelper::drawCentered(painter, option.rect, thumbnail);
 }
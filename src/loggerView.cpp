@@ -19,11 +19,13 @@
 
 #include "loggerView.hpp"
 #include "avdecc/helper.hpp"
+#include "avdecc/loggerLevels.hpp"
 
 #include <QScrollBar>
 #include <QFileDialog>
 #include <QStandardPaths>
 #include <QShortcut>
+#include <QActionGroup>
 
 class AutoScrollBar : public QScrollBar {
 public:
@@ -72,20 +74,18 @@ const std::vector<la::avdecc::logger::Level> loggerLevels
 	la::avdecc::logger::Level::Error,
 };
 
-LoggerView::LoggerView(QWidget* parent)
+static la::avdecc::logger::Level toLevel(QVariant const& data) noexcept
+{
+	return static_cast<la::avdecc::logger::Level>(data.value<std::underlying_type_t<la::avdecc::logger::Level>>());
+}
+
+LoggerView::LoggerView(avdecc::LoggerModel* loggerModel, QWidget* parent)
 	: QWidget(parent)
+	, _loggerModel(loggerModel)
 {
 	setupUi(this);
 
-	auto* logger = &la::avdecc::logger::Logger::getInstance();
-
-#ifndef NDEBUG
-	logger->setLevel(la::avdecc::logger::Level::Trace);
-#else
-	logger->setLevel(la::avdecc::logger::Level::Info);
-#endif
-
-	tableView->setModel(&_loggerModel);
+	tableView->setModel(_loggerModel);
 	tableView->setSelectionBehavior(QAbstractItemView::SelectRows);
 	tableView->setSelectionMode(QAbstractItemView::SingleSelection);
 	tableView->setVerticalScrollBar(new AutoScrollBar{Qt::Vertical, this});
@@ -100,16 +100,16 @@ LoggerView::LoggerView(QWidget* parent)
 	tableView->setColumnWidth(1, 120);
 	tableView->setColumnWidth(2, 90);
 
-	_layerFilterProxyModel.setSourceModel(&_loggerModel);
+	_layerFilterProxyModel.setSourceModel(_loggerModel);
 	_levelFilterProxyModel.setSourceModel(&_layerFilterProxyModel);
 	_searchFilterProxyModel.setSourceModel(&_levelFilterProxyModel);
 	tableView->setModel(&_searchFilterProxyModel);
 
-	connect(actionClear, &QAction::triggered, &_loggerModel, &avdecc::LoggerModel::clear);
+	connect(actionClear, &QAction::triggered, _loggerModel, &avdecc::LoggerModel::clear);
 	connect(actionSave, &QAction::triggered, this, [this]()
 	{
 		auto const filename = QFileDialog::getSaveFileName(this, "Save As..", QString("%1/%2.txt").arg(QStandardPaths::writableLocation(QStandardPaths::DesktopLocation)).arg(qAppName()), "*.txt");
-		_loggerModel.save(filename);
+		_loggerModel->save(filename);
 	});
 
 	connect(actionSearch, &QAction::triggered, this, [this]()
@@ -140,64 +140,72 @@ qt::toolkit::DynamicHeaderView* LoggerView::header() const
 
 void LoggerView::createLayerFilterButton()
 {
+	// One submenu per layer, selecting the minimum level built for the layer ("Off" disables it at the source)
 	for (auto const& layer : loggerLayers)
 	{
-		auto* action = _layerFilterMenu.addAction(avdecc::helper::loggerLayerToString(layer));
-		action->setCheckable(true);
-		action->setChecked(true);
+		auto* layerMenu = _layerFilterMenu.addMenu(avdecc::helper::loggerLayerToString(layer));
+		layerMenu->menuAction()->setData(QVariant::fromValue(la::avdecc::to_integral(layer)));
+
+		auto* levelGroup = new QActionGroup{ layerMenu };
+		auto const addLevelAction = [layerMenu, levelGroup](QString const& text, la::avdecc::logger::Level const level)
+		{
+			auto* action = layerMenu->addAction(text);
+			action->setCheckable(true);
+			action->setData(QVariant::fromValue(la::avdecc::to_integral(level)));
+			levelGroup->addAction(action);
+		};
+		addLevelAction("Off", la::avdecc::logger::Level::None);
+		for (auto const& level : loggerLevels)
+		{
+			addLevelAction(avdecc::helper::loggerLevelToString(level), level);
+		}
+
+		connect(levelGroup, &QActionGroup::triggered, this, [this, layer](QAction* action)
+		{
+			avdecc::logger::LayerLevels::getInstance().setLevel(layer, toLevel(action->data()));
+			updateLayerFilter();
+		});
 	}
 
 	_layerFilterMenu.addSeparator();
-	_layerFilterMenu.addAction("All");
-	_layerFilterMenu.addAction("None");
+	auto* allAction = _layerFilterMenu.addAction("All");
+	auto* noneAction = _layerFilterMenu.addAction("None");
 
 	layerFilterButton->setMenu(&_layerFilterMenu);
 
-	connect(&_layerFilterMenu, &QMenu::triggered, this, [this](QAction* action)
+	auto const setAllLayersLevel = [this](la::avdecc::logger::Level const level)
 	{
-		// All & None are non checkable
-		if (!action->isCheckable())
-		{
-			auto const checked = action->text() == "All";
-
-			QSignalBlocker lock(&_layerFilterMenu);
-			for (auto* a : _layerFilterMenu.actions())
-			{
-				if (a->isCheckable())
-				{
-					a->setChecked(checked);
-				}
-			}
-		}
-
-		QStringList layerList;
-		for (auto* a : _layerFilterMenu.actions())
-		{
-			if (a->isCheckable() && a->isChecked())
-			{
-				layerList << a->text();
-			}
-		}
-
-		if (layerList.empty())
+		auto& layerLevels = avdecc::logger::LayerLevels::getInstance();
+		for (auto const& layer : loggerLayers)
 		{
-			// Invalid filter
-			layerList << "---";
+			layerLevels.setLevel(layer, level);
 		}
-
-		// Update the filter
-		_layerFilterProxyModel.setFilterKeyColumn(1);
-		_layerFilterProxyModel.setFilterRegExp(layerList.join('|'));
+		updateLayerMenus();
+		updateLayerFilter();
+	};
+	connect(allAction, &QAction::triggered, this, [setAllLayersLevel]()
+	{
+		setAllLayersLevel(avdecc::logger::LayerLevels::getDefaultLevel());
+	});
+	connect(noneAction, &QAction::triggered, this, [setAllLayersLevel]()
+	{
+		setAllLayersLevel(la::avdecc::logger::Level::None);
 	});
+
+	// Initial state from the levels set at startup
+	updateLayerMenus();
+	updateLayerFilter();
 }
 
 void LoggerView::createLevelFilterButton()
 {
+	// Only filters the displayed messages, the levels built for each layer are set in the layer menu
 	for (auto const& level : loggerLevels)
 	{
 		auto* action = _levelFilterMenu.addAction(avdecc::helper::loggerLevelToString(level));
 		action->setCheckable(true);
 		action->setChecked(true);
+		action->setData(QVariant::fromValue(la::avdecc::to_integral(level)));
 	}
 
 	_levelFilterMenu.addSeparator();
@@ -223,23 +231,70 @@ void LoggerView::createLevelFilterButton()
 			}
 		}
 
-		QStringList levelList;
-		for (auto* a : _levelFilterMenu.actions())
+		updateLevelFilter();
+	});
+
+	updateLevelFilter();
+}
+
+void LoggerView::updateLayerMenus()
+{
+	auto const& layerLevels = avdecc::logger::LayerLevels::getInstance();
+	for (auto* layerAction : _layerFilterMenu.actions())
+	{
+		if (auto* layerMenu = layerAction->menu())
 		{
-			if (a->isCheckable() && a->isChecked())
+			auto const layer = static_cast<la::avdecc::logger::Layer>(layerAction->data().value<std::underlying_type_t<la::avdecc::logger::Layer>>());
+			auto const level = layerLevels.getLevel(layer);
+			for (auto* a : layerMenu->actions())
 			{
-				levelList << a->text();
+				a->setChecked(toLevel(a->data()) == level);
 			}
 		}
+	}
+}
+
+void LoggerView::updateLayerFilter()
+{
+	// Disabled layers are hidden too
+	auto const& layerLevels = avdecc::logger::LayerLevels::getInstance();
+	QStringList layerList;
+	for (auto const& layer : loggerLayers)
+	{
+		if (layerLevels.getLevel(layer) != la::avdecc::logger::Level::None)
+		{
+			layerList << avdecc::helper::loggerLayerToString(layer);
+		}
+	}
+
+	if (layerList.empty())
+	{
+		// Invalid filter
+		layerList << "---";
+	}
+
+	// Match whole names, some layer names start with another one
+	_layerFilterProxyModel.setFilterKeyColumn(1);
+	_layerFilterProxyModel.setFilterRegExp(QString{ "^(%1)$" }.arg(layerList.join('|')));
+}
 
-		if (levelList.empty())
+void LoggerView::updateLevelFilter()
+{
+	QStringList levelList;
+	for (auto* a : _levelFilterMenu.actions())
+	{
+		if (a->isCheckable() && a->isChecked())
 		{
-			// Invalid filter
-			levelList << "---";
+			levelList << a->text();
 		}
+	}
 
-		// Update the filter
-		_levelFilterProxyModel.setFilterKeyColumn(2);
-		_levelFilterProxyModel.setFilterRegExp(levelList.join('|'));
-	});
+	if (levelList.empty())
+	{
+		// Invalid filter
+		levelList << "---";
+	}
+
+	_levelFilterProxyModel.setFilterKeyColumn(2);
+	_levelFilterProxyModel.setFilterRegExp(levelList.join('|'));
 }
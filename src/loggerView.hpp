@@ -30,15 +30,19 @@ class LoggerView : public QWidget, private Ui::LoggerView
 {
 	Q_OBJECT
 public:
-	LoggerView(QWidget* parent = nullptr);
+	/** The model is not owned, so it can be created (and collect messages) before the view */
+	LoggerView(avdecc::LoggerModel* loggerModel, QWidget* parent = nullptr);
 	qt::toolkit::DynamicHeaderView* header() const;
 
 private:
 	void createLayerFilterButton();
 	void createLevelFilterButton();
+	void updateLayerMenus();
+	void updateLayerFilter();
+	void updateLevelFilter();
 
 private:
-	avdecc::LoggerModel _loggerModel{this};
+	avdecc::LoggerModel* const _loggerModel{ nullptr };
 	QSortFilterProxyModel _layerFilterProxyModel{this};
 	QSortFilterProxyModel _levelFilterProxyModel{this};
 	QSortFilterProxyModel _searchFilterProxyModel{this};
@@ -26,17 +26,12 @@
 #include <QSplashScreen>
 
 #include <iostream>
-#include <chrono>
 
 #include "mainWindow.hpp"
 #include "internals/config.hpp"
 #include "settingsManager/settings.hpp"
-
-#ifdef DEBUG
-#define SPLASH_DELAY 0
-#else // !DEBUG
-#define SPLASH_DELAY 1250
-#endif // DEBUG
+#include "avdecc/loggerLevels.hpp"
+#include "startupTrace.hpp"
 
 // Setup BugTrap on windows (win32 only right now)
 #if defined(Q_OS_WIN32) && defined(HAVE_BUGTRAP)
@@ -60,6 +55,8 @@ void setupBugReporter()
 
 int main(int argc, char *argv[])
 {
+	startup::traceStart();
+
 	// Setup Bug Reporter
 	setupBugReporter();
 
@@ -107,36 +104,33 @@ int main(int argc, char *argv[])
 	auto& settings = settings::SettingsManager::getInstance();
 	settings.registerSetting(settings::LastLaunchedVersion);
 	settings.registerSetting(settings::AutomaticPNGDownloadEnabled);
+	settings.registerSetting(settings::LogoCacheMemoryBudget);
 	settings.registerSetting(settings::AemCacheEnabled);
 
+	// Log levels are gated at the source, set them before anything logs (the logger view might only be created much later)
+	avdecc::logger::LayerLevels::getInstance().setDefaultLevels();
+
 	QPixmap logo(":/Logo.png");
 	QSplashScreen splash(logo, Qt::WindowStaysOnTopHint);
 	splash.show();
 	app.processEvents();
+	startup::tracePhase("Splash screen shown");
 
 	/* Load everything we need */
-	std::chrono::time_point<std::chrono::system_clock> start{ std::chrono::system_clock::now() };
 
 	// Load fonts
 	// https://material.io/icons/
 	QFontDatabase::addApplicationFont(":/MaterialIcons-Regular.ttf");
 
-	// Load main window
+	// Load main window (the slow parts of the startup are done asynchronously)
 	MainWindow window;
-	//window.show(); // This forces the creation of the window // Don't try to show it, it blinks sometimes (and window.hide() seems to create the window too)
-	window.hide(); // Immediately hides it (even though it was not actually shown since processEvents was not called)
 
-	/* Loading done - Keep the splashscreen displayed until specified delay */
-	do
+	/* Kill the splashscreen and show the main window as soon as the startup is completed */
+	QObject::connect(&window, &MainWindow::startupCompleted, &splash, [&window, &splash]()
 	{
-		app.processEvents();
-		// Wait a little bit so we don't burn the CPU
-		std::this_thread::sleep_for(std::chrono::milliseconds(10));
-	} while (splash.isVisible() && std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now() - start).count() <= SPLASH_DELAY);
-
-	/* Ok, kill the splashscreen and show the main window */
-	splash.close();
-	window.show();
+		window.show();
+		splash.finish(&window);
+	});
 
 #ifndef BUGREPORTER_CATCH_EXCEPTIONS
 	try
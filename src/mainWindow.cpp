@@ -35,10 +35,19 @@
 #include "imageItemDelegate.hpp"
 #include "settingsManager/settings.hpp"
 #include "entityLogoCache.hpp"
+#include "avdecc/mappingPresetManager.hpp"
+#include "avdecc/networkSnapshotManager.hpp"
+#include "startupTrace.hpp"
+#include "profiler/profiler.hpp"
+#include "profiler/memoryAccounting.hpp"
 
 #include "updater/updater.hpp"
 
+#include <array>
+#include <chrono>
+#include <map>
 #include <mutex>
+#include <vector>
 
 #define VENDOR_ID 0x001B92
 #define DEVICE_ID 0x80
@@ -49,6 +58,7 @@ Q_DECLARE_METATYPE(la::avdecc::EndStation::ProtocolInterfaceType);
 MainWindow::MainWindow(QWidget* parent)
 	: QMainWindow(parent)
 	, _controllerModel(new avdecc::ControllerModel(this))
+	, _controllerProxyModel(new avdecc::ControllerSortFilterProxyModel(_controllerModel, this))
 {
 	setupUi(this);
 
@@ -63,17 +73,27 @@ MainWindow::MainWindow(QWidget* parent)
 	createControllerView();
 
 	populateProtocolComboBox();
-	populateInterfaceComboBox();
+
+	// The model is created right away to receive all entities, only its view is created lazily
+	_connectionMatrixItemDelegate = std::make_unique<connectionMatrix::ConnectionMatrixItemDelegate>();
+	_connectionMatrixModel = std::make_unique<connectionMatrix::ConnectionMatrixModel>();
 
 	loadSettings();
 
 	connectSignals();
 
-	_connectionMatrixItemDelegate = std::make_unique<connectionMatrix::ConnectionMatrixItemDelegate>();
-	routingTableView->setItemDelegate(_connectionMatrixItemDelegate.get());
+	startup::tracePhase("Main window created");
 
-	_connectionMatrixModel = std::make_unique<connectionMatrix::ConnectionMatrixModel>();
-	routingTableView->setModel(_connectionMatrixModel.get());
+	// Network interfaces and controller settings are loaded in a worker thread, the controller is created as soon as they are available
+	loadStartupData();
+}
+
+MainWindow::~MainWindow()
+{
+	if (_startupThread.joinable())
+	{
+		_startupThread.join();
+	}
 }
 
 void MainWindow::currentControllerChanged()
@@ -100,19 +120,24 @@ void MainWindow::currentControllerChanged()
 
 void MainWindow::currentControlledEntityChanged(QModelIndex const& index)
 {
+	if (!_entityInspector)
+	{
+		return;
+	}
+
 	if (!index.isValid())
 	{
-		entityInspector->setControlledEntityID(la::avdecc::UniqueIdentifier{});
+		_entityInspector->setControlledEntityID(la::avdecc::UniqueIdentifier{});
 		return;
 	}
 
 	auto& manager = avdecc::ControllerManager::getInstance();
-	auto const entityID = _controllerModel->controlledEntityID(index);
+	auto const entityID = _controllerProxyModel->controlledEntityID(index);
 	auto controlledEntity = manager.getControlledEntity(entityID);
 
 	if (controlledEntity)
 	{
-		entityInspector->setControlledEntityID(entityID);
+		_entityInspector->setControlledEntityID(entityID);
 	}
 }
 
@@ -172,13 +197,22 @@ void MainWindow::createMainToolBar()
 
 	mainToolBar->addWidget(controllerEntityIDLabel);
 	mainToolBar->addWidget(&_controllerEntityIDLabel);
+
+	mainToolBar->addSeparator();
+
+	_controllerFilterLineEdit.setPlaceholderText("Filter entities (name or ID)");
+	_controllerFilterLineEdit.setClearButtonEnabled(true);
+	_controllerFilterLineEdit.setMaximumWidth(250);
+	mainToolBar->addWidget(&_controllerFilterLineEdit);
 }
 
 void MainWindow::createControllerView()
 {
-	controllerTableView->setModel(_controllerModel);
+	controllerTableView->setModel(_controllerProxyModel);
+	controllerTableView->setSortingEnabled(true);
+	controllerTableView->sortByColumn(la::avdecc::to_integral(avdecc::ControllerModelColumn::Name), Qt::AscendingOrder);
 	controllerTableView->setSelectionBehavior(QAbstractItemView::SelectRows);
-	controllerTableView->setSelectionMode(QAbstractItemView::SingleSelection);
+	controllerTableView->setSelectionMode(QAbstractItemView::ExtendedSelection);
 	controllerTableView->setContextMenuPolicy(Qt::CustomContextMenu);
 	
 	auto* imageItemDelegate{new ImageItemDelegate};
@@ -221,41 +255,135 @@ void MainWindow::populateProtocolComboBox()
 	}
 }
 
-void MainWindow::populateInterfaceComboBox()
+void MainWindow::loadStartupData()
 {
-	la::avdecc::networkInterface::enumerateInterfaces([this](la::avdecc::networkInterface::Interface const& networkInterface)
+	_startupThread = std::thread([this]()
 	{
-		if (networkInterface.type != la::avdecc::networkInterface::Interface::Type::Loopback && networkInterface.isActive)
+		auto data = StartupData{};
+
+		// The SettingsManager snapshot can be read from any thread
 		{
-			_interfaceComboBox.addItem(QString::fromStdString(networkInterface.alias), QString::fromStdString(networkInterface.name));
+			auto const& settings = settings::SettingsManager::getInstance();
+			data.protocolType = settings.getValue(settings::ProtocolType).toString();
+			data.interfaceName = settings.getValue(settings::InterfaceName).toString();
 		}
+		startup::tracePhase("Controller settings loaded");
+
+		// Enumerating interfaces can be slow, depending on the platform and the number of interfaces
+		la::avdecc::networkInterface::enumerateInterfaces([&data](la::avdecc::networkInterface::Interface const& networkInterface)
+		{
+			if (networkInterface.type != la::avdecc::networkInterface::Interface::Type::Loopback && networkInterface.isActive)
+			{
+				data.interfaces.emplace_back(QString::fromStdString(networkInterface.alias), QString::fromStdString(networkInterface.name));
+			}
+		});
+		startup::tracePhase("Network interfaces enumerated");
+
+		QMetaObject::invokeMethod(this, [this, data = std::move(data)]()
+		{
+			startupDataLoaded(data);
+		});
 	});
 }
 
+void MainWindow::startupDataLoaded(StartupData const& data)
+{
+	for (auto const& [alias, name] : data.interfaces)
+	{
+		_interfaceComboBox.addItem(alias, name);
+	}
+
+	_protocolComboBox.setCurrentText(data.protocolType);
+	_interfaceComboBox.setCurrentText(data.interfaceName);
+
+	currentControllerChanged();
+	startup::tracePhase("Controller created");
+
+	emit startupCompleted();
+}
+
 void MainWindow::loadSettings()
 {
 	auto& settings = settings::SettingsManager::getInstance();
 
 	LOG_HIVE_DEBUG("Settings location: " + settings.getFilePath());
 
-	_protocolComboBox.setCurrentText(settings.getValue(settings::ProtocolType).toString());
-	_interfaceComboBox.setCurrentText(settings.getValue(settings::InterfaceName).toString());
-
-	currentControllerChanged();
-
 	_controllerDynamicHeaderView.restoreState(settings.getValue(settings::ControllerDynamicHeaderViewState).toByteArray());
-	loggerView->header()->restoreState(settings.getValue(settings::LoggerDynamicHeaderViewState).toByteArray());
-	entityInspector->restoreState(settings.getValue(settings::EntityInspectorState).toByteArray());
-	splitter->restoreState(settings.getValue(settings::SplitterState).toByteArray());
 
 	restoreGeometry(settings.getValue(settings::MainWindowGeometry).toByteArray());
 	restoreState(settings.getValue(settings::MainWindowState).toByteArray());
 }
 
+void MainWindow::createRoutingTableView()
+{
+	if (_routingTableView)
+	{
+		return;
+	}
+
+	_routingTableView = new connectionMatrix::ConnectionMatrixView{ splitter };
+	_routingTableView->setItemDelegate(_connectionMatrixItemDelegate.get());
+	_routingTableView->setModel(_connectionMatrixModel.get());
+	splitter->addWidget(_routingTableView);
+
+	auto& settings = settings::SettingsManager::getInstance();
+	splitter->restoreState(settings.getValue(settings::SplitterState).toByteArray());
+
+	startup::tracePhase("Connection matrix view created");
+}
+
+void MainWindow::createLoggerView()
+{
+	if (_loggerView)
+	{
+		return;
+	}
+
+	_loggerView = new LoggerView{ &_loggerModel, loggerDockWidget };
+	loggerDockWidget->setWidget(_loggerView);
+
+	auto& settings = settings::SettingsManager::getInstance();
+	_loggerView->header()->restoreState(settings.getValue(settings::LoggerDynamicHeaderViewState).toByteArray());
+
+	connect(_loggerView->header(), &qt::toolkit::DynamicHeaderView::sectionChanged, this, [this]()
+	{
+		auto& settings = settings::SettingsManager::getInstance();
+		settings.setValue(settings::LoggerDynamicHeaderViewState, _loggerView->header()->saveState());
+	});
+
+	startup::tracePhase("Logger view created");
+}
+
+void MainWindow::createEntityInspector()
+{
+	if (_entityInspector)
+	{
+		return;
+	}
+
+	_entityInspector = new EntityInspector{ entityInspectorDockWidget };
+	entityInspectorDockWidget->setWidget(_entityInspector);
+
+	auto& settings = settings::SettingsManager::getInstance();
+	_entityInspector->restoreState(settings.getValue(settings::EntityInspectorState).toByteArray());
+
+	connect(_entityInspector, &EntityInspector::stateChanged, this, [this]()
+	{
+		auto& settings = settings::SettingsManager::getInstance();
+		settings.setValue(settings::EntityInspectorState, _entityInspector->saveState());
+	});
+
+	// Inspect the entity selected before the inspector was created
+	currentControlledEntityChanged(controllerTableView->currentIndex());
+
+	startup::tracePhase("Entity inspector created");
+}
+
 void MainWindow::connectSignals()
 {
 	connect(&_protocolComboBox, QOverload<int>::of(&QComboBox::activated), this, &MainWindow::currentControllerChanged);
 	connect(&_interfaceComboBox, QOverload<int>::of(&QComboBox::activated), this, &MainWindow::currentControllerChanged);
+	connect(&_controllerFilterLineEdit, &QLineEdit::textChanged, _controllerProxyModel, &avdecc::ControllerSortFilterProxyModel::setFilterText);
 
 	connect(controllerTableView->selectionModel(), &QItemSelectionModel::currentChanged, this, &MainWindow::currentControlledEntityChanged);
 	connect(&_controllerDynamicHeaderView, &qt::toolkit::DynamicHeaderView::sectionChanged, this, [this]()
@@ -268,7 +396,7 @@ void MainWindow::connectSignals()
 		auto const index = controllerTableView->indexAt(pos);
 
 		auto& manager = avdecc::ControllerManager::getInstance();
-		auto const entityID = _controllerModel->controlledEntityID(index);
+		auto const entityID = _controllerProxyModel->controlledEntityID(index);
 		auto controlledEntity = manager.getControlledEntity(entityID);
 
 		if (controlledEntity)
@@ -280,6 +408,8 @@ void MainWindow::connectSignals()
 			auto* releaseAction{ static_cast<QAction*>(nullptr) };
 			auto* inspect{ static_cast<QAction*>(nullptr) };
 			auto* getLogo{ static_cast<QAction*>(nullptr) };
+			auto presetActions = std::map<QAction*, QString>{};
+			auto removePresetActions = std::map<QAction*, QString>{};
 
 			if (la::avdecc::hasFlag(entity.getEntityCapabilities(), la::avdecc::entity::EntityCapabilities::AemSupported))
 			{
@@ -307,6 +437,20 @@ void MainWindow::connectSignals()
 					getLogo = menu.addAction("Retrieve Entity Logo");
 					getLogo->setEnabled(!EntityLogoCache::getInstance().isImageInCache(entityID, EntityLogoCache::Type::Entity));
 				}
+				menu.addSeparator();
+				{
+					// Presets captured on entities of the same model, applied to all selected entities of that model
+					auto const presets = avdecc::MappingPresetManager::getInstance().getPresets(entity.getEntityModelID());
+					auto* applyMenu = menu.addMenu("Apply Mapping Preset");
+					auto* removeMenu = menu.addMenu("Remove Mapping Preset");
+					applyMenu->setEnabled(!presets.empty());
+					removeMenu->setEnabled(!presets.empty());
+					for (auto const& preset : presets)
+					{
+						presetActions[applyMenu->addAction(preset.name)] = preset.name;
+						removePresetActions[removeMenu->addAction(preset.name)] = preset.name;
+					}
+				}
 			}
 			menu.addSeparator();
 			menu.addAction("Cancel");
@@ -326,27 +470,42 @@ void MainWindow::connectSignals()
 					auto* inspector = new EntityInspector;
 					inspector->setAttribute(Qt::WA_DeleteOnClose);
 					inspector->setControlledEntityID(entityID);
-					inspector->restoreGeometry(entityInspector->saveGeometry());
+					if (_entityInspector)
+					{
+						inspector->restoreGeometry(_entityInspector->saveGeometry());
+					}
 					inspector->show();
 				}
 				else if (action == getLogo)
 				{
 					EntityLogoCache::getInstance().getImage(entityID, EntityLogoCache::Type::Entity, true);
 				}
+				else if (auto const presetIt = presetActions.find(action); presetIt != presetActions.end())
+				{
+					applyMappingPreset(presetIt->second, entityID);
+				}
+				else if (auto const removePresetIt = removePresetActions.find(action); removePresetIt != removePresetActions.end())
+				{
+					avdecc::MappingPresetManager::getInstance().removePreset(removePresetIt->second);
+				}
 			}
 		}
 	});
 
-	connect(entityInspector, &EntityInspector::stateChanged, this, [this]()
+	// Docked views are created the first time they are shown, after the main window had a chance to paint
+	connect(loggerDockWidget, &QDockWidget::visibilityChanged, this, [this](bool const visible)
 	{
-		auto& settings = settings::SettingsManager::getInstance();
-		settings.setValue(settings::EntityInspectorState, entityInspector->saveState());
+		if (visible)
+		{
+			QTimer::singleShot(0, this, &MainWindow::createLoggerView);
+		}
 	});
-
-	connect(loggerView->header(), &qt::toolkit::DynamicHeaderView::sectionChanged, this, [this]()
+	connect(entityInspectorDockWidget, &QDockWidget::visibilityChanged, this, [this](bool const visible)
 	{
-		auto& settings = settings::SettingsManager::getInstance();
-		settings.setValue(settings::LoggerDynamicHeaderViewState, loggerView->header()->saveState());
+		if (visible)
+		{
+			QTimer::singleShot(0, this, &MainWindow::createEntityInspector);
+		}
 	});
 
 	connect(splitter, &QSplitter::splitterMoved, this, [this]()
@@ -374,6 +533,91 @@ void MainWindow::connectSignals()
 
 	//
 
+	auto& snapshotManager = avdecc::NetworkSnapshotManager::getInstance();
+
+	connect(actionSaveNetworkSnapshot, &QAction::triggered, this, [this, &snapshotManager]()
+	{
+		auto selectedFilter = QString{};
+		auto const fileName = QFileDialog::getSaveFileName(this, "Save Network Snapshot", QString{ "%1/hive-snapshot-%2.hns" }.arg(QDir::homePath()).arg(QDateTime::currentDateTime().toString("yyyyMMdd-hhmmss")), "Hive Network Snapshot (*.hns);;JSON (*.json)", &selectedFilter);
+		if (fileName.isEmpty())
+		{
+			return;
+		}
+
+		auto const snapshot = snapshotManager.capture();
+		auto const isJson = selectedFilter.contains("*.json");
+		auto const saved = isJson ? avdecc::NetworkSnapshotManager::exportJson(snapshot, fileName) : avdecc::NetworkSnapshotManager::save(snapshot, fileName);
+		if (saved)
+		{
+			LOG_HIVE_INFO(QString("Network snapshot of %1 entities saved to %2").arg(snapshot.entities.size()).arg(fileName));
+		}
+		else
+		{
+			QMessageBox::warning(this, "", "Failed to save network snapshot to " + fileName);
+		}
+	});
+
+	connect(actionRestoreNetworkSnapshot, &QAction::triggered, this, [this, &snapshotManager]()
+	{
+		if (snapshotManager.isRestoring())
+		{
+			QMessageBox::information(this, "", "A network snapshot is already being restored.");
+			return;
+		}
+
+		auto const fileName = QFileDialog::getOpenFileName(this, "Restore Network Snapshot", QDir::homePath(), "Hive Network Snapshot (*.hns)");
+		if (fileName.isEmpty())
+		{
+			return;
+		}
+
+		auto const snapshot = avdecc::NetworkSnapshotManager::load(fileName);
+		if (!snapshot)
+		{
+			QMessageBox::warning(this, "", "Failed to load network snapshot from " + fileName);
+			return;
+		}
+
+		auto const diff = snapshotManager.diff(*snapshot, avdecc::NetworkSnapshot::AllSections);
+		if (diff.changedEntities.empty())
+		{
+			QMessageBox::information(this, "", QString("The network already matches the snapshot (%1 entities up to date, %2 offline, %3 incompatible).").arg(diff.upToDateEntities).arg(diff.offlineEntities.size()).arg(diff.incompatibleEntities.size()));
+			return;
+		}
+
+		// Count the entities with changes in each section
+		auto sectionsChanges = std::array<std::size_t, avdecc::NetworkSnapshot::SectionsCount>{};
+		for (auto const& entityDiff : diff.changedEntities)
+		{
+			for (auto index = std::size_t{ 0u }; index < sectionsChanges.size(); ++index)
+			{
+				sectionsChanges[index] += static_cast<std::size_t>(entityDiff.changedSections[index]);
+			}
+		}
+		auto details = QStringList{};
+		for (auto index = std::size_t{ 0u }; index < sectionsChanges.size(); ++index)
+		{
+			if (sectionsChanges[index] != 0u)
+			{
+				details << QString("%1: %2 entities").arg(avdecc::NetworkSnapshotManager::sectionName(static_cast<avdecc::NetworkSnapshot::Section>(index))).arg(sectionsChanges[index]);
+			}
+		}
+
+		auto const message = QString("%1 entities differ from the snapshot taken %2 (%3 up to date, %4 offline, %5 incompatible).\n\n%6\n\nRestore them?").arg(diff.changedEntities.size()).arg(snapshot->captureTime.toString(Qt::DefaultLocaleShortDate)).arg(diff.upToDateEntities).arg(diff.offlineEntities.size()).arg(diff.incompatibleEntities.size()).arg(details.join("\n"));
+		if (QMessageBox::question(this, "Restore Network Snapshot", message) == QMessageBox::Yes)
+		{
+			statusbar->showMessage("Restoring network snapshot...");
+			snapshotManager.restore(*snapshot);
+		}
+	});
+
+	connect(&snapshotManager, &avdecc::NetworkSnapshotManager::restoreCompleted, this, [this](std::size_t const failedCommands)
+	{
+		statusbar->showMessage(failedCommands == 0u ? QString("Network snapshot restored") : QString("Network snapshot restored, %1 commands failed").arg(failedCommands), 10000);
+	});
+
+	//
+
 	connect(actionSettings, &QAction::triggered, this, [this]()
 	{
 		SettingsDialog dialog{ this };
@@ -382,6 +626,54 @@ void MainWindow::connectSignals()
 
 	//
 
+	connect(actionRecordPerformanceTrace, &QAction::toggled, this, [this](bool const checked)
+	{
+		auto& profiler = profiler::Profiler::getInstance();
+		profiler.setEnabled(checked);
+		if (checked)
+		{
+			statusbar->showMessage("Recording performance trace...");
+			return;
+		}
+
+		statusbar->clearMessage();
+		auto const fileName = QFileDialog::getSaveFileName(this, "Save Performance Trace", QString{ "%1/hive-trace-%2.json" }.arg(QDir::homePath()).arg(QDateTime::currentDateTime().toString("yyyyMMdd-hhmmss")), "Chrome Trace (*.json)");
+		if (!fileName.isEmpty())
+		{
+			if (profiler.save(fileName))
+			{
+				LOG_HIVE_INFO("Performance trace saved to " + fileName);
+			}
+			else
+			{
+				QMessageBox::warning(this, "", "Failed to save performance trace to " + fileName);
+			}
+		}
+		profiler.clear();
+	});
+
+	//
+
+	connect(actionMemoryUsage, &QAction::triggered, this, [this]()
+	{
+		if (!_memoryUsageDialog)
+		{
+			_memoryUsageDialog = new profiler::MemoryUsageDialog{ this };
+		}
+		_memoryUsageDialog->show();
+		_memoryUsageDialog->raise();
+		_memoryUsageDialog->activateWindow();
+	});
+
+	// Periodically log the memory usage, so it can be followed over long sessions
+	connect(&_memorySnapshotTimer, &QTimer::timeout, this, []()
+	{
+		LOG_HIVE_INFO(profiler::MemoryAccounting::getInstance().snapshot());
+	});
+	_memorySnapshotTimer.start(std::chrono::minutes{ 5 });
+
+	//
+
 	connect(actionAbout, &QAction::triggered, this, [this]()
 	{
 		AboutDialog dialog{ this };
@@ -403,6 +695,26 @@ void MainWindow::connectSignals()
 	});
 }
 
+void MainWindow::applyMappingPreset(QString const& presetName, la::avdecc::UniqueIdentifier const clickedEntityID)
+{
+	// Apply to all selected entities (the manager skips the ones of another model), or to the clicked one if it is not part of the selection
+	auto entityIDs = std::vector<la::avdecc::UniqueIdentifier>{};
+	auto clickedEntitySelected = false;
+	for (auto const& index : controllerTableView->selectionModel()->selectedRows())
+	{
+		auto const entityID = _controllerProxyModel->controlledEntityID(index);
+		clickedEntitySelected |= entityID == clickedEntityID;
+		entityIDs.push_back(entityID);
+	}
+	if (!clickedEntitySelected)
+	{
+		entityIDs = { clickedEntityID };
+	}
+
+	auto const result = avdecc::MappingPresetManager::getInstance().applyPreset(presetName, entityIDs);
+	statusbar->showMessage(QString{ "Mapping preset '%1': %2 entities updated (%3 mappings added, %4 removed), %5 already up to date, %6 skipped" }.arg(presetName).arg(result.updatedEntities).arg(result.addedMappings).arg(result.removedMappings).arg(result.upToDateEntities).arg(result.skippedEntities), 5000);
+}
+
 #define STRINGIFY(a) #a
 
 void MainWindow::showEvent(QShowEvent* event)
@@ -410,6 +722,13 @@ void MainWindow::showEvent(QShowEvent* event)
 	static std::once_flag once;
 	std::call_once(once, [this]()
 	{
+		// The window is usable once it had a chance to paint, the connection matrix view is created right after
+		QTimer::singleShot(0, this, [this]()
+		{
+			createRoutingTableView();
+			startup::traceUsable();
+		});
+
 		// Start a new version check
 		Updater::getInstance().checkForNewVersion();
 
@@ -22,9 +22,20 @@
 #include "ui_mainWindow.h"
 #include <QSettings>
 #include <QLabel>
+#include <QLineEdit>
+#include <QTimer>
+#include <QString>
 #include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
 #include "avdecc/controllerModel.hpp"
+#include "avdecc/controllerSortFilterProxyModel.hpp"
+#include "avdecc/loggerModel.hpp"
 #include "connectionMatrix.hpp"
+#include "entityInspector.hpp"
+#include "loggerView.hpp"
+#include "profiler/memoryUsageDialog.hpp"
 #include "toolkit/dynamicHeaderView.hpp"
 #include "toolkit/comboBox.hpp"
 
@@ -35,11 +46,23 @@ class MainWindow : public QMainWindow, private Ui::MainWindow
 	Q_OBJECT
 public:
 	MainWindow(QWidget* parent = nullptr);
+	~MainWindow();
 
 	Q_SLOT void currentControllerChanged();
 	Q_SLOT void currentControlledEntityChanged(QModelIndex const& index);
 
+	/** Emitted once the startup data are loaded and the controller is created, the window can be shown */
+	Q_SIGNAL void startupCompleted();
+
 private:
+	/** Data loaded off the GUI thread during startup */
+	struct StartupData
+	{
+		QString protocolType{};
+		QString interfaceName{};
+		std::vector<std::pair<QString, QString>> interfaces{}; // Pairs of "Alias", "Name" of the active network interfaces
+	};
+
 	void registerMetaTypes();
 
 	void createViewMenu();
@@ -48,12 +71,21 @@ private:
 	void createControllerView();
 
 	void populateProtocolComboBox();
-	void populateInterfaceComboBox();
+
+	void loadStartupData();
+	void startupDataLoaded(StartupData const& data);
 
 	void loadSettings();
 
+	// Views are only created when first shown
+	void createRoutingTableView();
+	void createLoggerView();
+	void createEntityInspector();
+
 	void connectSignals();
 
+	void applyMappingPreset(QString const& presetName, la::avdecc::UniqueIdentifier const clickedEntityID);
+
 private:
 	void showEvent(QShowEvent* event) override;
 	void closeEvent(QCloseEvent* event) override;
@@ -62,8 +94,17 @@ private:
 	qt::toolkit::ComboBox _protocolComboBox{this};
 	qt::toolkit::ComboBox _interfaceComboBox{this};
 	QLabel _controllerEntityIDLabel{this};
+	QLineEdit _controllerFilterLineEdit{this};
 	avdecc::ControllerModel* _controllerModel{ nullptr };
+	avdecc::ControllerSortFilterProxyModel* _controllerProxyModel{ nullptr };
 	qt::toolkit::DynamicHeaderView _controllerDynamicHeaderView{ Qt::Horizontal, this };
 	std::unique_ptr<connectionMatrix::ConnectionMatrixModel> _connectionMatrixModel{ nullptr };
 	std::unique_ptr<connectionMatrix::ConnectionMatrixItemDelegate> _connectionMatrixItemDelegate{ nullptr };
+	avdecc::LoggerModel _loggerModel{ this }; // Created before the view, so messages logged before it is shown are kept
+	LoggerView* _loggerView{ nullptr };
+	EntityInspector* _entityInspector{ nullptr };
+	connectionMatrix::ConnectionMatrixView* _routingTableView{ nullptr };
+	std::thread _startupThread{};
+	profiler::MemoryUsageDialog* _memoryUsageDialog{ nullptr }; // Created when first opened
+	QTimer _memorySnapshotTimer{ this };
 };
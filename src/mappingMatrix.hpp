@@ -23,9 +23,13 @@
 #include <QDialog>
 #include <QGridLayout>
 
+#include <algorithm>
+#include <memory>
 #include <utility>
 #include <vector>
 #include <string>
+#include "mappingMatrixTypes.hpp"
+#include "mappingMatrixGrid.hpp"
 #include "toolkit/graph/view.hpp"
 #include "toolkit/graph/node.hpp"
 #include "toolkit/graph/inputSocket.hpp"
@@ -34,50 +38,12 @@
 namespace mappingMatrix
 {
 
-struct Node
-{
-	std::string name{};
-	std::vector<std::string> sockets;
-};
-
-using Nodes = std::vector<Node>;
-using Outputs = Nodes;
-using Inputs = Nodes;
-using SlotID = std::pair<size_t, size_t>; // Pair of "Node Index", "Socket Index"
-using Connection = std::pair<SlotID, SlotID>; // Pair of "Output SlotID", "Input SlotID"
-using Connections = std::vector<Connection>;
-
-/*
-
-	 Node 0                   Node 0
-------------            ------------
-| Socket 0 | ---------- | Socket 0 |
-| Socket 1 |     \----- | Socket 1 |
-| Socket 2 |            ------------
-| Socket 3 |
-------------                Node 1
-												------------
-	 Node 1          ---- | Socket 0 |
-------------      /      ------------
-| Socket 0 |     /
-| Socket 1 | ---/
-| Socket 2 |
-| Socket 3 |
-------------
-
- Connections:
-	- <0,0> -> <0,0>
-	- <0,0> -> <0,1>
-	- <1,1> -> <1,0>
-
-*/
-
 class MappingMatrix : public graph::GraphicsView
 {
 public:
 	MappingMatrix(const Outputs& outputs, const Inputs& inputs, const Connections& connections, QWidget* parent = nullptr)
 		: graph::GraphicsView(parent)
-		, _connections{ connections }
+		, _connections{ connections.begin(), connections.end() }
 	{
 		setScene(&_scene);
 
@@ -144,65 +110,120 @@ public:
 		}
 
 		connect(this, &graph::GraphicsView::connectionCreated, this, [this](graph::ConnectionItem* connection) {
-			_connections.emplace_back(
-				std::make_pair(connection->output()->nodeId(), connection->output()->index()),
-				std::make_pair(connection->input()->nodeId(), connection->input()->index())
-			);
+			_connections.insert(toConnection(connection));
 		});
 
 		connect(this, &graph::GraphicsView::connectionDeleted, this, [this](graph::ConnectionItem* connection) {
-			_connections.erase(std::remove_if(_connections.begin(), _connections.end(), [connection](Connection const& item)
-			{
-				return
-					(item.first.first == connection->output()->nodeId() && item.first.second == connection->output()->index()) &&
-					(item.second.first == connection->input()->nodeId() && item.second.second == connection->input()->index());
-			}), _connections.end());
+			_connections.erase(toConnection(connection));
 		});
 
 		auto const scenePadding{ 80 };
 		_scene.setSceneRect(_scene.sceneRect().adjusted(-scenePadding, -scenePadding, scenePadding, scenePadding));
 	}
 
-	Connections const& connections() const
+	Connections connections() const
+	{
+		return Connections{ _connections.begin(), _connections.end() };
+	}
+
+private:
+	static Connection toConnection(graph::ConnectionItem const* connection)
 	{
-		return _connections;
+		auto const* const output = connection->output();
+		auto const* const input = connection->input();
+		return Connection{ SlotID{ static_cast<std::size_t>(output->nodeId()), static_cast<std::size_t>(output->index()) }, SlotID{ static_cast<std::size_t>(input->nodeId()), static_cast<std::size_t>(input->index()) } };
 	}
 
 private:
 	QGraphicsScene _scene{ this };
 	std::vector<graph::NodeItem*> _outputs;
 	std::vector<graph::NodeItem*> _inputs;
-	Connections _connections;
+	ConnectionSet _connections;
 };
 
 class MappingMatrixDialog : public QDialog
 {
 public:
+	// Above this number of sockets on one side, the dialog opens in grid mode
+	static constexpr std::size_t GridModeSocketsThreshold = 64;
+
 	MappingMatrixDialog(const Outputs& outputs, const Inputs& inputs, const Connections& connections, QWidget* parent = nullptr)
 #ifdef Q_OS_WIN32
 		: QDialog(parent, Qt::Dialog) // Because Qt::Tool is ugly on windows
 #else
 		: QDialog(parent, Qt::Tool)
 #endif
-		, _mappingMatrix{ outputs, inputs, connections, this }
+		, _outputs{ outputs }
+		, _inputs{ inputs }
 	{
-		auto* layout = new QGridLayout{ this };
-
-		layout->addWidget(&_mappingMatrix, 0, 0, 1, 2);
-		layout->addWidget(&_applyButton, 1, 0);
-		layout->addWidget(&_cancelButton, 1, 1);
+		_layout.addWidget(&_modeButton, 1, 0, 1, 2);
+		_layout.addWidget(&_applyButton, 2, 0);
+		_layout.addWidget(&_cancelButton, 2, 1);
 
+		connect(&_modeButton, &QPushButton::clicked, this, [this]()
+		{
+			setGridMode(!_mappingGrid);
+		});
 		connect(&_applyButton, &QPushButton::clicked, this, &QDialog::accept);
 		connect(&_cancelButton, &QPushButton::clicked, this, &QDialog::reject);
+
+		auto const socketsCount = [](Nodes const& nodes)
+		{
+			auto count = std::size_t{ 0u };
+			for (auto const& node : nodes)
+			{
+				count += node.sockets.size();
+			}
+			return count;
+		};
+		auto const gridMode = std::max(socketsCount(outputs), socketsCount(inputs)) > GridModeSocketsThreshold;
+		createView(gridMode, connections);
+	}
+
+	Connections connections() const
+	{
+		return _mappingGrid ? _mappingGrid->connections() : _mappingMatrix->connections();
+	}
+
+private:
+	/** Switches between the graph and the grid views, keeping the current mappings */
+	void setGridMode(bool const gridMode)
+	{
+		if (gridMode != static_cast<bool>(_mappingGrid))
+		{
+			createView(gridMode, connections());
+		}
 	}
 
-	Connections const& connections() const
+	void createView(bool const gridMode, Connections const& connections)
 	{
-		return _mappingMatrix.connections();
+		// Only one of the views exists at a time, the graph one creates scene items for all the sockets
+		_mappingMatrix.reset();
+		_mappingGrid.reset();
+
+		QWidget* view{ nullptr };
+		if (gridMode)
+		{
+			_mappingGrid = std::make_unique<MappingGrid>(_outputs, _inputs, connections, this);
+			view = _mappingGrid.get();
+			_modeButton.setText("Switch to Graph View");
+		}
+		else
+		{
+			_mappingMatrix = std::make_unique<MappingMatrix>(_outputs, _inputs, connections, this);
+			view = _mappingMatrix.get();
+			_modeButton.setText("Switch to Grid View");
+		}
+		_layout.addWidget(view, 0, 0, 1, 2);
 	}
 
 private:
-	MappingMatrix _mappingMatrix;
+	Outputs const _outputs{};
+	Inputs const _inputs{};
+	QGridLayout _layout{ this };
+	std::unique_ptr<MappingMatrix> _mappingMatrix{};
+	std::unique_ptr<MappingGrid> _mappingGrid{};
+	QPushButton _modeButton{ this };
 	QPushButton _applyButton{ "Apply", this };
 	QPushButton _cancelButton{ "Cancel", this };
 };
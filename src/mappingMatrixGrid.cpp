@@ -0,0 +1,537 @@
+/*
+* Copyright 2017-2018, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be usefu_state,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "mappingMatrixGrid.hpp"
+
+#include <QPainter>
+#include <QPaintEvent>
+#include <QMouseEvent>
+#include <QScrollBar>
+#include <algorithm>
+
+namespace mappingMatrix
+{
+static constexpr int CellSize = 14;
+static constexpr int HeaderPadding = 6;
+static constexpr int MaxHeaderSize = 240;
+static constexpr int AutoScrollInterval = 50; // In milliseconds
+static constexpr int AutoScrollMargin = CellSize; // Distance to the edges of the cells area where the drag starts scrolling
+
+MappingGrid::MappingGrid(Outputs const& outputs, Inputs const& inputs, Connections const& connections, QWidget* parent)
+	: QAbstractScrollArea(parent)
+	, _rows{ buildHeader(outputs) }
+	, _columns{ buildHeader(inputs) }
+{
+	_wordsPerRow = (_columns.slotIDs.size() + 63u) / 64u;
+	_bits.resize(_wordsPerRow * _rows.slotIDs.size(), 0u);
+
+	for (auto const& connection : connections)
+	{
+		auto const& outputSlot{ connection.first };
+		auto const& inputSlot{ connection.second };
+
+		if (outputSlot.first < _rows.nodeOffsets.size() && inputSlot.first < _columns.nodeOffsets.size())
+		{
+			auto const row = _rows.nodeOffsets[outputSlot.first] + outputSlot.second;
+			auto const column = _columns.nodeOffsets[inputSlot.first] + inputSlot.second;
+			if (row < _rows.slotIDs.size() && column < _columns.slotIDs.size())
+			{
+				setMapped(static_cast<int>(row), static_cast<int>(column), true);
+			}
+		}
+	}
+
+	// Headers are sized to their longest label
+	auto const metrics = fontMetrics();
+	auto const headerSize = [&metrics](std::vector<QString> const& labels)
+	{
+		auto size = 0;
+		for (auto const& label : labels)
+		{
+			size = std::max(size, metrics.width(label));
+		}
+		return std::min(size + 2 * HeaderPadding, MaxHeaderSize);
+	};
+	_rowHeaderWidth = headerSize(_rows.labels);
+	_columnHeaderHeight = headerSize(_columns.labels);
+
+	viewport()->setMouseTracking(true);
+	setMinimumSize(320, 240);
+
+	_autoScrollTimer.setInterval(AutoScrollInterval);
+	connect(&_autoScrollTimer, &QTimer::timeout, this, &MappingGrid::autoScroll);
+}
+
+Connections MappingGrid::connections() const
+{
+	auto connections = Connections{};
+
+	for (auto row = 0u; row < _rows.slotIDs.size(); ++row)
+	{
+		auto const* const rowBits = _bits.data() + row * _wordsPerRow;
+		for (auto word = 0u; word < _wordsPerRow; ++word)
+		{
+			// Only visit the bits that are set
+			auto bits = rowBits[word];
+			while (bits != 0u)
+			{
+				auto bit = 0u;
+				while ((bits & (std::uint64_t{ 1u } << bit)) == 0u)
+				{
+					++bit;
+				}
+				bits &= ~(std::uint64_t{ 1u } << bit);
+
+				auto const column = word * 64u + bit;
+				connections.emplace_back(_rows.slotIDs[row], _columns.slotIDs[column]);
+			}
+		}
+	}
+
+	return connections;
+}
+
+MappingGrid::Header MappingGrid::buildHeader(Nodes const& nodes)
+{
+	auto header = Header{};
+
+	for (auto nodeIndex = 0u; nodeIndex < nodes.size(); ++nodeIndex)
+	{
+		auto const& node = nodes[nodeIndex];
+		auto const nodeName = QString::fromStdString(node.name);
+
+		header.nodeOffsets.push_back(header.slotIDs.size());
+		for (auto socketIndex = 0u; socketIndex < node.sockets.size(); ++socketIndex)
+		{
+			header.slotIDs.emplace_back(nodeIndex, socketIndex);
+			header.labels.push_back(nodeName + ": " + QString::fromStdString(node.sockets[socketIndex]));
+			header.isFirstOfNode.push_back(socketIndex == 0u);
+		}
+	}
+
+	return header;
+}
+
+bool MappingGrid::isMapped(int const row, int const column) const noexcept
+{
+	auto const& word = _bits[row * _wordsPerRow + column / 64];
+	return (word & (std::uint64_t{ 1u } << (column % 64))) != 0u;
+}
+
+void MappingGrid::setMapped(int const row, int const column, bool const mapped) noexcept
+{
+	auto const wordIndex = static_cast<std::size_t>(column / 64);
+	auto const mask = std::uint64_t{ 1u } << (column % 64);
+	if (mapped)
+	{
+		// An input has a single source, unmap the column first
+		for (auto r = std::size_t{ 0u }; r < _rows.slotIDs.size(); ++r)
+		{
+			_bits[r * _wordsPerRow + wordIndex] &= ~mask;
+		}
+		_bits[row * _wordsPerRow + wordIndex] |= mask;
+	}
+	else
+	{
+		_bits[row * _wordsPerRow + wordIndex] &= ~mask;
+	}
+}
+
+bool MappingGrid::isUnmappingDrag() const noexcept
+{
+	return isMapped(_anchorCell.row, _anchorCell.column);
+}
+
+template<class Handler>
+void MappingGrid::forEachDragCell(Handler&& handler) const
+{
+	auto const firstRow = std::min(_anchorCell.row, _currentCell.row);
+	auto const lastRow = std::max(_anchorCell.row, _currentCell.row);
+	auto const firstColumn = std::min(_anchorCell.column, _currentCell.column);
+	auto const lastColumn = std::max(_anchorCell.column, _currentCell.column);
+
+	// Unmapping and single row drags cover the whole rectangle (an output can feed many inputs)
+	if (isUnmappingDrag() || firstRow == lastRow)
+	{
+		for (auto row = firstRow; row <= lastRow; ++row)
+		{
+			for (auto column = firstColumn; column <= lastColumn; ++column)
+			{
+				handler(row, column);
+			}
+		}
+		return;
+	}
+
+	// Otherwise map along the diagonal starting at the anchor, so each input gets a single source
+	auto const rowStep = _currentCell.row >= _anchorCell.row ? 1 : -1;
+	auto const columnStep = _currentCell.column >= _anchorCell.column ? 1 : -1;
+	auto const count = std::min(lastRow - firstRow, lastColumn - firstColumn) + 1;
+	for (auto i = 0; i < count; ++i)
+	{
+		handler(_anchorCell.row + i * rowStep, _anchorCell.column + i * columnStep);
+	}
+}
+
+void MappingGrid::autoScroll()
+{
+	if (!_anchorCell.isValid())
+	{
+		_autoScrollTimer.stop();
+		return;
+	}
+
+	auto const size = viewport()->size();
+	auto const scrollStep = [](int const position, int const low, int const high)
+	{
+		if (position < low + AutoScrollMargin)
+		{
+			return -CellSize;
+		}
+		if (position > high - AutoScrollMargin)
+		{
+			return CellSize;
+		}
+		return 0;
+	};
+	auto const dx = scrollStep(_dragPosition.x(), _rowHeaderWidth, size.width());
+	auto const dy = scrollStep(_dragPosition.y(), _columnHeaderHeight, size.height());
+	if (dx == 0 && dy == 0)
+	{
+		_autoScrollTimer.stop();
+		return;
+	}
+
+	horizontalScrollBar()->setValue(horizontalScrollBar()->value() + dx);
+	verticalScrollBar()->setValue(verticalScrollBar()->value() + dy);
+
+	// The cell under the mouse changed with the scrolling
+	_currentCell = cellAt(_dragPosition, true);
+	viewport()->update();
+}
+
+int MappingGrid::rowCount() const noexcept
+{
+	return static_cast<int>(_rows.slotIDs.size());
+}
+
+int MappingGrid::columnCount() const noexcept
+{
+	return static_cast<int>(_columns.slotIDs.size());
+}
+
+QPoint MappingGrid::cellsOrigin() const noexcept
+{
+	return { _rowHeaderWidth - horizontalScrollBar()->value(), _columnHeaderHeight - verticalScrollBar()->value() };
+}
+
+MappingGrid::Cell MappingGrid::cellAt(QPoint const& pos, bool const clamp) const noexcept
+{
+	if (rowCount() == 0 || columnCount() == 0)
+	{
+		return {};
+	}
+
+	if (!clamp && (pos.x() < _rowHeaderWidth || pos.y() < _columnHeaderHeight))
+	{
+		return {};
+	}
+
+	auto const origin = cellsOrigin();
+	auto const x = pos.x() - origin.x();
+	auto const y = pos.y() - origin.y();
+	auto const column = x < 0 ? -1 : x / CellSize;
+	auto const row = y < 0 ? -1 : y / CellSize;
+
+	if (clamp)
+	{
+		return { std::clamp(row, 0, rowCount() - 1), std::clamp(column, 0, columnCount() - 1) };
+	}
+
+	if (row < 0 || row >= rowCount() || column < 0 || column >= columnCount())
+	{
+		return {};
+	}
+
+	return { row, column };
+}
+
+void MappingGrid::updateScrollBars()
+{
+	auto const size = viewport()->size();
+	auto const visibleWidth = std::max(0, size.width() - _rowHeaderWidth);
+	auto const visibleHeight = std::max(0, size.height() - _columnHeaderHeight);
+
+	horizontalScrollBar()->setPageStep(visibleWidth);
+	horizontalScrollBar()->setSingleStep(CellSize);
+	horizontalScrollBar()->setRange(0, std::max(0, columnCount() * CellSize - visibleWidth));
+	verticalScrollBar()->setPageStep(visibleHeight);
+	verticalScrollBar()->setSingleStep(CellSize);
+	verticalScrollBar()->setRange(0, std::max(0, rowCount() * CellSize - visibleHeight));
+}
+
+void MappingGrid::paintEvent(QPaintEvent* event)
+{
+	QPainter painter{ viewport() };
+
+	auto const& palette = viewport()->palette();
+	auto const size = viewport()->size();
+	auto const origin = cellsOrigin();
+
+	auto const cellsRect = QRect{ _rowHeaderWidth, _columnHeaderHeight, size.width() - _rowHeaderWidth, size.height() - _columnHeaderHeight };
+	auto const rowHeaderRect = QRect{ 0, _columnHeaderHeight, _rowHeaderWidth, cellsRect.height() };
+	auto const columnHeaderRect = QRect{ _rowHeaderWidth, 0, cellsRect.width(), _columnHeaderHeight };
+
+	painter.fillRect(event->rect(), palette.base());
+
+	if (rowCount() == 0 || columnCount() == 0)
+	{
+		return;
+	}
+
+	// Only the visible rows and columns are painted
+	auto const firstRow = std::max(0, (cellsRect.top() - origin.y()) / CellSize);
+	auto const lastRow = std::min(rowCount() - 1, (cellsRect.bottom() - origin.y()) / CellSize);
+	auto const firstColumn = std::max(0, (cellsRect.left() - origin.x()) / CellSize);
+	auto const lastColumn = std::min(columnCount() - 1, (cellsRect.right() - origin.x()) / CellSize);
+
+	auto const cellRect = [&origin](int const row, int const column)
+	{
+		return QRect{ origin.x() + column * CellSize, origin.y() + row * CellSize, CellSize, CellSize };
+	};
+
+	auto const lineColor = palette.color(QPalette::Midlight);
+	auto const nodeLineColor = palette.color(QPalette::Dark);
+	auto hoverColor = palette.color(QPalette::Highlight);
+	hoverColor.setAlpha(32);
+
+	// Cells
+	{
+		painter.save();
+		painter.setClipRect(cellsRect);
+
+		if (_hoveredCell.isValid())
+		{
+			painter.fillRect(QRect{ cellsRect.left(), origin.y() + _hoveredCell.row * CellSize, cellsRect.width(), CellSize }, hoverColor);
+			painter.fillRect(QRect{ origin.x() + _hoveredCell.column * CellSize, cellsRect.top(), CellSize, cellsRect.height() }, hoverColor);
+		}
+
+		auto const mappedBrush = palette.brush(QPalette::Highlight);
+		for (auto row = firstRow; row <= lastRow; ++row)
+		{
+			for (auto column = firstColumn; column <= lastColumn; ++column)
+			{
+				if (isMapped(row, column))
+				{
+					painter.fillRect(cellRect(row, column).adjusted(2, 2, -2, -2), mappedBrush);
+				}
+			}
+		}
+
+		auto const right = std::min(cellsRect.right(), origin.x() + columnCount() * CellSize);
+		auto const bottom = std::min(cellsRect.bottom(), origin.y() + rowCount() * CellSize);
+		for (auto row = firstRow; row <= lastRow + 1; ++row)
+		{
+			auto const y = origin.y() + row * CellSize;
+			painter.setPen(row < rowCount() && _rows.isFirstOfNode[row] ? nodeLineColor : lineColor);
+			painter.drawLine(cellsRect.left(), y, right, y);
+		}
+		for (auto column = firstColumn; column <= lastColumn + 1; ++column)
+		{
+			auto const x = origin.x() + column * CellSize;
+			painter.setPen(column < columnCount() && _columns.isFirstOfNode[column] ? nodeLineColor : lineColor);
+			painter.drawLine(x, cellsRect.top(), x, bottom);
+		}
+
+		// Rubber band of the current drag, with the cells it will change
+		if (_anchorCell.isValid() && _currentCell.isValid())
+		{
+			auto const selection = cellRect(_anchorCell.row, _anchorCell.column).united(cellRect(_currentCell.row, _currentCell.column));
+			auto selectionColor = palette.color(QPalette::Highlight);
+			painter.setPen(selectionColor);
+			painter.setBrush(Qt::NoBrush);
+			painter.drawRect(selection.adjusted(0, 0, -1, -1));
+
+			selectionColor.setAlpha(96);
+			forEachDragCell([&painter, &cellRect, &selectionColor](int const row, int const column)
+			{
+				painter.fillRect(cellRect(row, column).adjusted(1, 1, -1, -1), selectionColor);
+			});
+		}
+
+		painter.restore();
+	}
+
+	// Row header
+	{
+		painter.save();
+		painter.setClipRect(rowHeaderRect);
+		painter.fillRect(rowHeaderRect, palette.button());
+
+		for (auto row = firstRow; row <= lastRow; ++row)
+		{
+			auto const rect = QRect{ 0, origin.y() + row * CellSize, _rowHeaderWidth, CellSize };
+			if (row == _hoveredCell.row)
+			{
+				painter.fillRect(rect, hoverColor);
+			}
+			if (_rows.isFirstOfNode[row])
+			{
+				painter.setPen(nodeLineColor);
+				painter.drawLine(rect.topLeft(), rect.topRight());
+			}
+			painter.setPen(palette.color(QPalette::ButtonText));
+			auto const text = painter.fontMetrics().elidedText(_rows.labels[row], Qt::ElideMiddle, _rowHeaderWidth - 2 * HeaderPadding);
+			painter.drawText(rect.adjusted(HeaderPadding, 0, -HeaderPadding, 0), Qt::AlignVCenter | Qt::AlignRight, text);
+		}
+
+		painter.restore();
+	}
+
+	// Column header, labels are drawn vertically
+	{
+		painter.save();
+		painter.setClipRect(columnHeaderRect);
+		painter.fillRect(columnHeaderRect, palette.button());
+
+		for (auto column = firstColumn; column <= lastColumn; ++column)
+		{
+			auto const x = origin.x() + column * CellSize;
+			auto const rect = QRect{ x, 0, CellSize, _columnHeaderHeight };
+			if (column == _hoveredCell.column)
+			{
+				painter.fillRect(rect, hoverColor);
+			}
+			if (_columns.isFirstOfNode[column])
+			{
+				painter.setPen(nodeLineColor);
+				painter.drawLine(rect.topLeft(), rect.bottomLeft());
+			}
+
+			painter.save();
+			painter.translate(x, _columnHeaderHeight);
+			painter.rotate(-90);
+			painter.setPen(palette.color(QPalette::ButtonText));
+			auto const text = painter.fontMetrics().elidedText(_columns.labels[column], Qt::ElideMiddle, _columnHeaderHeight - 2 * HeaderPadding);
+			painter.drawText(QRect{ HeaderPadding, 0, _columnHeaderHeight - 2 * HeaderPadding, CellSize }, Qt::AlignVCenter | Qt::AlignLeft, text);
+			painter.restore();
+		}
+
+		painter.restore();
+	}
+
+	// Corner
+	painter.fillRect(QRect{ 0, 0, _rowHeaderWidth, _columnHeaderHeight }, palette.button());
+}
+
+void MappingGrid::resizeEvent(QResizeEvent* event)
+{
+	QAbstractScrollArea::resizeEvent(event);
+	updateScrollBars();
+}
+
+void MappingGrid::mousePressEvent(QMouseEvent* event)
+{
+	if (event->button() == Qt::LeftButton)
+	{
+		auto const cell = cellAt(event->pos());
+		if (cell.isValid())
+		{
+			_anchorCell = cell;
+			_currentCell = cell;
+			_dragPosition = event->pos();
+			viewport()->update();
+		}
+	}
+
+	QAbstractScrollArea::mousePressEvent(event);
+}
+
+void MappingGrid::mouseMoveEvent(QMouseEvent* event)
+{
+	auto const hoveredCell = cellAt(event->pos());
+	auto needsUpdate = hoveredCell != _hoveredCell;
+	_hoveredCell = hoveredCell;
+
+	if (_anchorCell.isValid())
+	{
+		auto const currentCell = cellAt(event->pos(), true);
+		needsUpdate |= currentCell != _currentCell;
+		_currentCell = currentCell;
+
+		// Scroll while the mouse is near (or past) the edges of the cells area
+		_dragPosition = event->pos();
+		if (!_autoScrollTimer.isActive())
+		{
+			_autoScrollTimer.start();
+		}
+	}
+
+	if (needsUpdate)
+	{
+		viewport()->update();
+	}
+
+	QAbstractScrollArea::mouseMoveEvent(event);
+}
+
+void MappingGrid::mouseReleaseEvent(QMouseEvent* event)
+{
+	if (event->button() == Qt::LeftButton && _anchorCell.isValid())
+	{
+		// Map the cells of the drag, or unmap them if the first one was mapped (a single cell is simply toggled)
+		auto const mapped = !isUnmappingDrag();
+		auto cells = std::vector<Cell>{};
+		forEachDragCell([&cells](int const row, int const column)
+		{
+			cells.push_back({ row, column });
+		});
+		for (auto const& cell : cells)
+		{
+			setMapped(cell.row, cell.column, mapped);
+		}
+
+		_autoScrollTimer.stop();
+		_anchorCell = {};
+		_currentCell = {};
+		viewport()->update();
+	}
+
+	QAbstractScrollArea::mouseReleaseEvent(event);
+}
+
+bool MappingGrid::viewportEvent(QEvent* event)
+{
+	if (event->type() == QEvent::Leave && _hoveredCell.isValid())
+	{
+		_hoveredCell = {};
+		viewport()->update();
+	}
+
+	return QAbstractScrollArea::viewportEvent(event);
+}
+
+void MappingGrid::scrollContentsBy(int /*dx*/, int /*dy*/)
+{
+	// Headers don't scroll along both axes, repaint everything
+	viewport()->update();
+}
+
+} // namespace mappingMatrix
@@ -0,0 +1,118 @@
+/*
+* Copyright 2017-2018, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be usefu_state,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#pragma once
+
+#include <QAbstractScrollArea>
+#include <QTimer>
+
+#include <cstdint>
+#include <vector>
+#include "mappingMatrixTypes.hpp"
+
+namespace mappingMatrix
+{
+
+/**
+* @brief Dense grid editor for mappings, one row per output socket and one column per input socket.
+* @details Mappings are stored as a bitset and only the visible cells are painted, so it scales to thousands of channels
+*          where MappingMatrix would need one scene item per socket and per connection.
+*          An input can only have one source, so mapping a cell unmaps the other cells of its column.
+*          Clicking a cell toggles it. Dragging over a single row maps all the cells it covers, dragging over several rows maps the cells along the diagonal
+*          starting at the first cell, and if the first cell was mapped the drag unmaps all the cells of the rectangle instead.
+*/
+class MappingGrid : public QAbstractScrollArea
+{
+	Q_OBJECT
+public:
+	MappingGrid(Outputs const& outputs, Inputs const& inputs, Connections const& connections, QWidget* parent = nullptr);
+
+	/** Returns the current mappings, sorted by output then input */
+	Connections connections() const;
+
+protected:
+	virtual void paintEvent(QPaintEvent* event) override;
+	virtual void resizeEvent(QResizeEvent* event) override;
+	virtual void mousePressEvent(QMouseEvent* event) override;
+	virtual void mouseMoveEvent(QMouseEvent* event) override;
+	virtual void mouseReleaseEvent(QMouseEvent* event) override;
+	virtual bool viewportEvent(QEvent* event) override;
+	virtual void scrollContentsBy(int dx, int dy) override;
+
+private:
+	struct Cell
+	{
+		int row{ -1 };
+		int column{ -1 };
+
+		bool isValid() const noexcept
+		{
+			return row >= 0 && column >= 0;
+		}
+		bool operator==(Cell const& other) const noexcept
+		{
+			return row == other.row && column == other.column;
+		}
+		bool operator!=(Cell const& other) const noexcept
+		{
+			return !operator==(other);
+		}
+	};
+
+	struct Header
+	{
+		std::vector<SlotID> slotIDs{};
+		std::vector<QString> labels{};
+		std::vector<bool> isFirstOfNode{};
+		std::vector<std::size_t> nodeOffsets{}; // Index of the first slot of each node
+	};
+
+	static Header buildHeader(Nodes const& nodes);
+
+	bool isMapped(int const row, int const column) const noexcept;
+	void setMapped(int const row, int const column, bool const mapped) noexcept;
+	bool isUnmappingDrag() const noexcept;
+	/** Calls the handler with the row and column of each cell changed by the current drag */
+	template<class Handler>
+	void forEachDragCell(Handler&& handler) const;
+	void autoScroll();
+
+	int rowCount() const noexcept;
+	int columnCount() const noexcept;
+	QPoint cellsOrigin() const noexcept; // Position of the top-left cell in viewport coordinates, scrolling included
+	Cell cellAt(QPoint const& pos, bool const clamp = false) const noexcept;
+	void updateScrollBars();
+
+private:
+	Header _rows{};
+	Header _columns{};
+	std::vector<std::uint64_t> _bits{};
+	std::size_t _wordsPerRow{ 0u };
+	int _rowHeaderWidth{ 0 };
+	int _columnHeaderHeight{ 0 };
+
+	Cell _hoveredCell{};
+	Cell _anchorCell{}; // Cell where the current drag started
+	Cell _currentCell{}; // Cell under the mouse during the current drag
+	QPoint _dragPosition{}; // Last mouse position during the current drag
+	QTimer _autoScrollTimer{};
+};
+
+} // namespace mappingMatrix
@@ -0,0 +1,87 @@
+/*
+* Copyright 2017-2018, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be usefu_state,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+#include <string>
+
+namespace mappingMatrix
+{
+
+struct Node
+{
+	std::string name{};
+	std::vector<std::string> sockets;
+};
+
+using Nodes = std::vector<Node>;
+using Outputs = Nodes;
+using Inputs = Nodes;
+using SlotID = std::pair<size_t, size_t>; // Pair of "Node Index", "Socket Index"
+using Connection = std::pair<SlotID, SlotID>; // Pair of "Output SlotID", "Input SlotID"
+using Connections = std::vector<Connection>;
+
+struct ConnectionHash
+{
+	std::size_t operator()(Connection const& connection) const noexcept
+	{
+		auto const hasher = std::hash<std::size_t>{};
+		auto seed = std::size_t{ 0u };
+		for (auto const value : { connection.first.first, connection.first.second, connection.second.first, connection.second.second })
+		{
+			seed ^= hasher(value) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+		}
+		return seed;
+	}
+};
+
+using ConnectionSet = std::unordered_set<Connection, ConnectionHash>;
+
+/*
+
+	 Node 0                   Node 0
+------------            ------------
+| Socket 0 | ---------- | Socket 0 |
+| Socket 1 |     \----- | Socket 1 |
+| Socket 2 |            ------------
+| Socket 3 |
+------------                Node 1
+												------------
+	 Node 1          ---- | Socket 0 |
+------------      /      ------------
+| Socket 0 |     /
+| Socket 1 | ---/
+| Socket 2 |
+| Socket 3 |
+------------
+
+ Connections:
+	- <0,0> -> <0,0>
+	- <0,0> -> <0,1>
+	- <1,1> -> <1,0>
+
+*/
+
+} // namespace mappingMatrix
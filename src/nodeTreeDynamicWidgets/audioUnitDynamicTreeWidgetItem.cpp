@@ -18,6 +18,7 @@
 */
 
 #include "audioUnitDynamicTreeWidgetItem.hpp"
+#include "avdecc/descriptorDispatcher.hpp"
 
 #include <QMenu>
 
@@ -48,12 +49,10 @@ AudioUnitDynamicTreeWidgetItem::AudioUnitDynamicTreeWidgetItem(la::avdecc::Uniqu
 	});
 
 	// Listen for changes
-	connect(&avdecc::ControllerManager::getInstance(), &avdecc::ControllerManager::audioUnitSamplingRateChanged, _samplingRate, [this](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::AudioUnitIndex const audioUnitIndex, la::avdecc::entity::model::SamplingRate const samplingRate)
+	auto* notifier = avdecc::DescriptorDispatcher::getInstance().getNotifier(_entityID, la::avdecc::entity::model::DescriptorType::AudioUnit, _audioUnitIndex);
+	connect(notifier, &avdecc::DescriptorNotifier::audioUnitSamplingRateChanged, _samplingRate, [this](la::avdecc::entity::model::SamplingRate const samplingRate)
 	{
-		if (entityID == _entityID && audioUnitIndex == _audioUnitIndex)
-		{
-			updateSamplingRate(samplingRate);
-		}
+		updateSamplingRate(samplingRate);
 	});
 
 	// Update now
@@ -18,6 +18,7 @@
 */
 
 #include "avbInterfaceDynamicTreeWidgetItem.hpp"
+#include "avdecc/descriptorDispatcher.hpp"
 
 #include <QMenu>
 
@@ -45,12 +46,10 @@ AvbInterfaceDynamicTreeWidgetItem::AvbInterfaceDynamicTreeWidgetItem(la::avdecc:
 		updateAvbInfo(dynamicModel->avbInfo);
 
 		// Listen for AvbInfoChanged
-		connect(&avdecc::ControllerManager::getInstance(), &avdecc::ControllerManager::avbInfoChanged, this, [this](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::AvbInterfaceIndex const avbInterfaceIndex, la::avdecc::entity::model::AvbInfo const& info)
+		auto* notifier = avdecc::DescriptorDispatcher::getInstance().getNotifier(_entityID, la::avdecc::entity::model::DescriptorType::AvbInterface, _avbInterfaceIndex);
+		connect(notifier, &avdecc::DescriptorNotifier::avbInfoChanged, this, [this](la::avdecc::entity::model::AvbInfo const& info)
 		{
-			if (entityID == _entityID && avbInterfaceIndex == _avbInterfaceIndex)
-			{
-				updateAvbInfo(info);
-			}
+			updateAvbInfo(info);
 		});
 	}
 }
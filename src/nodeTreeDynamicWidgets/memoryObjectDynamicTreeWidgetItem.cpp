@@ -18,11 +18,22 @@
 */
 
 #include "memoryObjectDynamicTreeWidgetItem.hpp"
+#include "avdecc/descriptorDispatcher.hpp"
 
-MemoryObjectDynamicTreeWidgetItem::MemoryObjectDynamicTreeWidgetItem(la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::MemoryObjectIndex const memoryObjectIndex, la::avdecc::controller::model::MemoryObjectNodeDynamicModel const* const dynamicModel, QTreeWidget *parent)
+#include <QFile>
+#include <QFileDialog>
+#include <QHBoxLayout>
+#include <QMessageBox>
+#include <QPointer>
+#include <QStandardPaths>
+
+MemoryObjectDynamicTreeWidgetItem::MemoryObjectDynamicTreeWidgetItem(la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::MemoryObjectIndex const memoryObjectIndex, la::avdecc::controller::model::MemoryObjectNodeStaticModel const* const staticModel, la::avdecc::controller::model::MemoryObjectNodeDynamicModel const* const dynamicModel, QTreeWidget *parent)
 	: QTreeWidgetItem(parent)
 	, _entityID(entityID)
+	, _configurationIndex(configurationIndex)
 	, _memoryObjectIndex(memoryObjectIndex)
+	, _startAddress(staticModel->startAddress)
+	, _maximumLength(staticModel->maximumLength)
 {
 	// MemoryObjectLength
 	{
@@ -34,17 +45,138 @@ MemoryObjectDynamicTreeWidgetItem::MemoryObjectDynamicTreeWidgetItem(la::avdecc:
 		updateMemoryObjectLength(dynamicModel->length);
 
 		// Listen for MemoryObjectLengthChanged
-		connect(&avdecc::ControllerManager::getInstance(), &avdecc::ControllerManager::memoryObjectLengthChanged, this, [this](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::MemoryObjectIndex const memoryObjectIndex, std::uint64_t const length)
+		auto* notifier = avdecc::DescriptorDispatcher::getInstance().getNotifier(_entityID, la::avdecc::entity::model::DescriptorType::MemoryObject, _memoryObjectIndex);
+		connect(notifier, &avdecc::DescriptorNotifier::memoryObjectLengthChanged, this, [this](std::uint64_t const length)
+		{
+			updateMemoryObjectLength(length);
+		});
+	}
+
+	// Transfer
+	{
+		auto* transferItem = new QTreeWidgetItem(this);
+		transferItem->setText(0, "Transfer");
+
+		auto* transferWidget = new QWidget;
+		auto* layout = new QHBoxLayout{ transferWidget };
+		layout->setContentsMargins(0, 0, 0, 0);
+		_readButton = new QPushButton{ "Read to File...", transferWidget };
+		_writeButton = new QPushButton{ "Write from File...", transferWidget };
+		_cancelButton = new QPushButton{ "Cancel", transferWidget };
+		_transferStatus = new QLabel{ transferWidget };
+		layout->addWidget(_readButton);
+		layout->addWidget(_writeButton);
+		layout->addWidget(_cancelButton);
+		layout->addWidget(_transferStatus, 1);
+		parent->setItemWidget(transferItem, 1, transferWidget);
+
+		setTransferInProgress(false);
+
+		connect(_readButton, &QPushButton::clicked, this, &MemoryObjectDynamicTreeWidgetItem::readToFile);
+		connect(_writeButton, &QPushButton::clicked, this, &MemoryObjectDynamicTreeWidgetItem::writeFromFile);
+		connect(_cancelButton, &QPushButton::clicked, this, [this]()
+		{
+			avdecc::MemoryObjectTransferEngine::getInstance().cancel(_transferID);
+		});
+
+		auto& engine = avdecc::MemoryObjectTransferEngine::getInstance();
+		connect(&engine, &avdecc::MemoryObjectTransferEngine::transferProgress, this, [this](avdecc::MemoryObjectTransferEngine::TransferID const transferID, la::avdecc::UniqueIdentifier const /*entityID*/, avdecc::MemoryObjectTransferEngine::Progress const& progress)
 		{
-			if (entityID == _entityID && memoryObjectIndex == _memoryObjectIndex)
+			if (!_transferInProgress || transferID != _transferID)
 			{
-				updateMemoryObjectLength(length);
+				return;
 			}
+
+			auto const percent = progress.totalBytes != 0u ? (progress.transferredBytes * 100u / progress.totalBytes) : 100u;
+			auto text = QString("%1%2% - %3 KiB/s").arg(progress.verifying ? "Verifying " : "").arg(percent).arg(progress.bytesPerSecond / 1024.0, 0, 'f', 1);
+			if (progress.remainingMs >= 0)
+			{
+				text += QString(" - %1 s left").arg((progress.remainingMs + 999) / 1000);
+			}
+			_transferStatus->setText(text);
+		});
+		connect(&engine, &avdecc::MemoryObjectTransferEngine::transferCompleted, this, [this](avdecc::MemoryObjectTransferEngine::TransferID const transferID, la::avdecc::UniqueIdentifier const /*entityID*/, avdecc::MemoryObjectTransferEngine::Status const status)
+		{
+			if (!_transferInProgress || transferID != _transferID)
+			{
+				return;
+			}
+
+			setTransferInProgress(false);
+			_transferStatus->setText(avdecc::MemoryObjectTransferEngine::statusToString(status));
 		});
 	}
 }
 
 void MemoryObjectDynamicTreeWidgetItem::updateMemoryObjectLength(std::uint64_t const length)
 {
+	_currentLength = length;
 	_length->setText(1, avdecc::helper::toHexQString(length, false, true));
 }
+
+void MemoryObjectDynamicTreeWidgetItem::readToFile()
+{
+	auto const fileName = QFileDialog::getSaveFileName(treeWidget(), "Save Memory Object As...", QStandardPaths::writableLocation(QStandardPaths::DesktopLocation), "*.bin");
+	if (fileName.isEmpty())
+	{
+		return;
+	}
+
+	// Read the whole memory object if the device does not report its current length
+	auto const length = _currentLength != 0u ? _currentLength : _maximumLength;
+
+	// The item might be destroyed before the transfer completes
+	auto item = QPointer<MemoryObjectDynamicTreeWidgetItem>{ this };
+	setTransferInProgress(true);
+	_transferID = avdecc::MemoryObjectTransferEngine::getInstance().read(_entityID, _startAddress, length, {}, [item, fileName](avdecc::MemoryObjectTransferEngine::TransferID const /*transferID*/, avdecc::MemoryObjectTransferEngine::Status const status, QByteArray const& data)
+	{
+		if (status != avdecc::MemoryObjectTransferEngine::Status::Success)
+		{
+			return;
+		}
+
+		QFile file{ fileName };
+		if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate) || file.write(data) != data.size())
+		{
+			QMessageBox::warning(item ? item->treeWidget() : nullptr, "", QString("Failed to save memory object to %1").arg(fileName));
+		}
+	});
+}
+
+void MemoryObjectDynamicTreeWidgetItem::writeFromFile()
+{
+	auto const fileName = QFileDialog::getOpenFileName(treeWidget(), "Write File to Memory Object...", QStandardPaths::writableLocation(QStandardPaths::DesktopLocation), "*.bin;;*");
+	if (fileName.isEmpty())
+	{
+		return;
+	}
+
+	QFile file{ fileName };
+	if (!file.open(QIODevice::ReadOnly))
+	{
+		QMessageBox::warning(treeWidget(), "", QString("Failed to open %1").arg(fileName));
+		return;
+	}
+
+	auto const data = file.readAll();
+	if (static_cast<std::uint64_t>(data.size()) > _maximumLength)
+	{
+		QMessageBox::warning(treeWidget(), "", QString("File is too large for this memory object (%1 bytes max)").arg(_maximumLength));
+		return;
+	}
+
+	setTransferInProgress(true);
+	_transferID = avdecc::MemoryObjectTransferEngine::getInstance().writeMemoryObject(_entityID, _configurationIndex, _memoryObjectIndex, _startAddress, data, {}, {});
+}
+
+void MemoryObjectDynamicTreeWidgetItem::setTransferInProgress(bool const inProgress)
+{
+	_transferInProgress = inProgress;
+	_readButton->setEnabled(!inProgress);
+	_writeButton->setEnabled(!inProgress);
+	_cancelButton->setEnabled(inProgress);
+	if (inProgress)
+	{
+		_transferStatus->setText("Waiting...");
+	}
+}
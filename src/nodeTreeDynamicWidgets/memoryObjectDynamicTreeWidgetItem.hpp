@@ -23,21 +23,39 @@
 
 #include "avdecc/helper.hpp"
 #include "avdecc/controllerManager.hpp"
+#include "avdecc/memoryObjectTransferEngine.hpp"
 
 #include <QObject>
 #include <QTreeWidgetItem>
+#include <QPushButton>
+#include <QLabel>
 
 class MemoryObjectDynamicTreeWidgetItem : public QObject, public QTreeWidgetItem
 {
 public:
-	MemoryObjectDynamicTreeWidgetItem(la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::MemoryObjectIndex const memoryObjectIndex, la::avdecc::controller::model::MemoryObjectNodeDynamicModel const* const dynamicModel, QTreeWidget *parent = nullptr);
+	MemoryObjectDynamicTreeWidgetItem(la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::MemoryObjectIndex const memoryObjectIndex, la::avdecc::controller::model::MemoryObjectNodeStaticModel const* const staticModel, la::avdecc::controller::model::MemoryObjectNodeDynamicModel const* const dynamicModel, QTreeWidget *parent = nullptr);
 
 private:
 	void updateMemoryObjectLength(std::uint64_t const memoryObjectLength);
+	void readToFile();
+	void writeFromFile();
+	void setTransferInProgress(bool const inProgress);
 
 	la::avdecc::UniqueIdentifier const _entityID{};
+	la::avdecc::entity::model::ConfigurationIndex const _configurationIndex{ 0u };
 	la::avdecc::entity::model::MemoryObjectIndex const _memoryObjectIndex{ 0u };
+	std::uint64_t const _startAddress{ 0u };
+	std::uint64_t const _maximumLength{ 0u };
+	std::uint64_t _currentLength{ 0u };
 
 	// AvbInfo
 	QTreeWidgetItem* _length{ nullptr };
+
+	// Transfer
+	QPushButton* _readButton{ nullptr };
+	QPushButton* _writeButton{ nullptr };
+	QPushButton* _cancelButton{ nullptr };
+	QLabel* _transferStatus{ nullptr };
+	avdecc::MemoryObjectTransferEngine::TransferID _transferID{ avdecc::MemoryObjectTransferEngine::InvalidTransferID };
+	bool _transferInProgress{ false };
 };
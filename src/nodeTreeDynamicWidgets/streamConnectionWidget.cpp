@@ -18,6 +18,7 @@
 */
 
 #include "streamConnectionWidget.hpp"
+#include "avdecc/descriptorDispatcher.hpp"
 
 #include <QMenu>
 
@@ -44,22 +45,14 @@ StreamConnectionWidget::StreamConnectionWidget(la::avdecc::entity::model::Stream
 
 	updateData();
 
-	// Connect ControllerManager signals
-	auto const& manager = avdecc::ControllerManager::getInstance();
+	// Connect listener entity signals
+	auto* notifier = avdecc::DescriptorDispatcher::getInstance().getEntityNotifier(_listenerConnection.entityID);
 
 	// EntityOnline
-	connect(&manager, &avdecc::ControllerManager::entityOnline, this, [this](la::avdecc::UniqueIdentifier const entityID)
-	{
-		if (entityID == _listenerConnection.entityID)
-			updateData();
-	});
+	connect(notifier, &avdecc::DescriptorNotifier::entityOnline, this, &StreamConnectionWidget::updateData);
 
 	// EntityOffline
-	connect(&manager, &avdecc::ControllerManager::entityOffline, this, [this](la::avdecc::UniqueIdentifier const entityID)
-	{
-		if (entityID == _listenerConnection.entityID)
-			updateData();
-	});
+	connect(notifier, &avdecc::DescriptorNotifier::entityOffline, this, &StreamConnectionWidget::updateData);
 
 	// Connect Widget signals
 	// Disconnect button
@@ -20,6 +20,7 @@
 #include "streamDynamicTreeWidgetItem.hpp"
 #include "streamFormatComboBox.hpp"
 #include "streamConnectionWidget.hpp"
+#include "avdecc/descriptorDispatcher.hpp"
 
 #include <QMenu>
 
@@ -40,6 +41,8 @@ StreamDynamicTreeWidgetItem::StreamDynamicTreeWidgetItem(la::avdecc::UniqueIdent
 
 	parent->setItemWidget(currentFormatItem, 1, formatComboBox);
 
+	auto* notifier = avdecc::DescriptorDispatcher::getInstance().getNotifier(_entityID, _streamType, _streamIndex);
+
 	// Send changes
 	connect(formatComboBox, &StreamFormatComboBox::currentFormatChanged, this, [this, formatComboBox](la::avdecc::entity::model::StreamFormat const& streamFormat)
 	{
@@ -54,10 +57,9 @@ StreamDynamicTreeWidgetItem::StreamDynamicTreeWidgetItem(la::avdecc::UniqueIdent
 	});
 
 	// Listen for changes
-	connect(&avdecc::ControllerManager::getInstance(), &avdecc::ControllerManager::streamFormatChanged, formatComboBox, [this, formatComboBox](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::DescriptorType const descriptorType, la::avdecc::entity::model::StreamIndex const streamIndex, la::avdecc::entity::model::StreamFormat const streamFormat)
+	connect(notifier, &avdecc::DescriptorNotifier::streamFormatChanged, formatComboBox, [formatComboBox](la::avdecc::entity::model::StreamFormat const streamFormat)
 	{
-		if (entityID == _entityID && descriptorType == _streamType && streamIndex == _streamIndex)
-			formatComboBox->setCurrentStreamFormat(streamFormat);
+		formatComboBox->setCurrentStreamFormat(streamFormat);
 	});
 
 	//
@@ -92,12 +94,9 @@ StreamDynamicTreeWidgetItem::StreamDynamicTreeWidgetItem(la::avdecc::UniqueIdent
 		updateStreamInfo(dynamicModel->streamInfo);
 
 		// Listen for StreamInfoChanged
-		connect(&avdecc::ControllerManager::getInstance(), &avdecc::ControllerManager::streamInfoChanged, this, [this](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::DescriptorType const descriptorType, la::avdecc::entity::model::StreamIndex const streamIndex, la::avdecc::entity::model::StreamInfo const& info)
+		connect(notifier, &avdecc::DescriptorNotifier::streamInfoChanged, this, [this](la::avdecc::entity::model::StreamInfo const& info)
 		{
-			if (entityID == _entityID && descriptorType == _streamType && streamIndex == _streamIndex)
-			{
-				updateStreamInfo(info);
-			}
+			updateStreamInfo(info);
 		});
 	}
 
@@ -112,15 +111,9 @@ StreamDynamicTreeWidgetItem::StreamDynamicTreeWidgetItem(la::avdecc::UniqueIdent
 		updateConnectionState(inputDynamicModel->connectionState);
 
 		// Listen for Connection changed signals
-		connect(&avdecc::ControllerManager::getInstance(), &avdecc::ControllerManager::streamConnectionChanged, this, [this](la::avdecc::controller::model::StreamConnectionState const& state)
+		connect(notifier, &avdecc::DescriptorNotifier::streamConnectionChanged, this, [this](la::avdecc::controller::model::StreamConnectionState const& state)
 		{
-			auto const listenerID = state.listenerStream.entityID;
-			auto const listenerIndex = state.listenerStream.streamIndex;
-
-			if (listenerID == _entityID && listenerIndex == _streamIndex)
-			{
-				updateConnectionState(state);
-			}
+			updateConnectionState(state);
 		});
 	}
 
@@ -138,12 +131,9 @@ StreamDynamicTreeWidgetItem::StreamDynamicTreeWidgetItem(la::avdecc::UniqueIdent
 		updateConnections(outputDynamicModel->connections);
 
 		// Listen for Connections changed signal
-		connect(&avdecc::ControllerManager::getInstance(), &avdecc::ControllerManager::streamConnectionsChanged, this, [this](la::avdecc::entity::model::StreamIdentification const& stream, la::avdecc::controller::model::StreamConnections const& connections)
+		connect(notifier, &avdecc::DescriptorNotifier::streamConnectionsChanged, this, [this](la::avdecc::controller::model::StreamConnections const& connections)
 		{
-			if (stream.entityID == _entityID && stream.streamIndex == _streamIndex)
-			{
-				updateConnections(connections);
-			}
+			updateConnections(connections);
 		});
 #pragma message("TODO: When the notification is available")
 	}
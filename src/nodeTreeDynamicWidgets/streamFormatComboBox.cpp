@@ -60,8 +60,7 @@ void StreamFormatComboBox::setStreamFormats(StreamFormats const& streamFormats)
 
 	for (auto const& streamFormat : _streamFormats)
 	{
-		auto const streamFormatInfo = la::avdecc::entity::model::StreamFormatInfo::create(streamFormat);
-		addItem(avdecc::helper::streamFormatToString(*streamFormatInfo), QVariant::fromValue(streamFormat));
+		addItem(avdecc::helper::streamFormatToString(streamFormat), QVariant::fromValue(streamFormat));
 	}
 }
 
@@ -69,8 +68,7 @@ void StreamFormatComboBox::setCurrentStreamFormat(StreamFormat const& streamForm
 {
 	QSignalBlocker lock(this); // Block internal signals so setCurrentText do not trigger "currentIndexChanged"
 
-	auto const streamFormatInfo = la::avdecc::entity::model::StreamFormatInfo::create(streamFormat);
-	auto const streamFormatString = avdecc::helper::streamFormatToString(*streamFormatInfo);
+	auto const streamFormatString = avdecc::helper::streamFormatToString(streamFormat);
 
 	// The format is not present in the list?
 	if (_streamFormats.count(_previousFormat) == 0)
@@ -22,24 +22,28 @@
 #endif // ENABLE_AVDECC_FEATURE_REDUNDANCY
 
 #include "streamPortDynamicTreeWidgetItem.hpp"
+#include "streamPortMappings.hpp"
 #include "mappingMatrix.hpp"
+#include "avdecc/mappingPresetManager.hpp"
 #include <vector>
 #include <utility>
+#include <algorithm>
+#include <iterator>
 #include <cstdint>
 #include <QPushButton>
 #include <QMessageBox>
+#include <QInputDialog>
 
 /* ************************************************************ */
 /* Internal types and functions                                 */
 /* ************************************************************ */
-struct NodeMapping
-{
-	la::avdecc::entity::model::DescriptorIndex descriptorIndex{ la::avdecc::entity::model::DescriptorIndex{ 0u } };
-	std::vector<std::uint16_t> channels{};
-};
-using NodeMappings = std::vector<NodeMapping>;
-using HashType = std::uint64_t;
-using HashedConnectionsList = std::set<HashType>;
+using streamPortMappings::NodeMapping;
+using streamPortMappings::NodeMappings;
+using streamPortMappings::HashedConnectionsList;
+using streamPortMappings::buildConnections;
+using streamPortMappings::unmakeHash;
+using streamPortMappings::hashConnectionsList;
+using streamPortMappings::substractList;
 
 std::pair<NodeMappings, mappingMatrix::Nodes> buildClusterMappings(la::avdecc::controller::ControlledEntity const* const controlledEntity, la::avdecc::controller::model::StreamPortNode const& streamPortNode)
 {
@@ -94,131 +98,6 @@ std::pair<NodeMappings, mappingMatrix::Nodes> buildStreamMappings(la::avdecc::co
 	return std::make_pair(streamMappings, streamMatrixNodes);
 }
 
-template<class StreamNodeType>
-mappingMatrix::Connections buildConnections(la::avdecc::controller::model::StreamPortNode const& streamPortNode, std::vector<StreamNodeType const*> const& streamNodes, NodeMappings const& streamMappings, NodeMappings const& clusterMappings, std::function<mappingMatrix::Connection(mappingMatrix::SlotID const streamSlotID, mappingMatrix::SlotID const clusterSlotID)> const& creationConnectionFunction)
-{
-	mappingMatrix::Connections connections;
-	
-	// Build list of current connections
-	for (auto const& mapping : streamPortNode.dynamicModel->dynamicAudioMap)
-	{
-		// Find the existing mapping, as mappingMatrix::SlotID
-		mappingMatrix::SlotID streamSlotID{ -1, -1 };
-		mappingMatrix::SlotID clusterSlotID{ -1, -1 };
-		
-		auto streamIndex{ mapping.streamIndex };
-		
-#ifdef ENABLE_AVDECC_FEATURE_REDUNDANCY
-		// In case of redundancy, we must check the streamIndex in the mapping is the one matching the primary stream (or convert it)
-		{
-			for (auto const* streamNode : streamNodes)
-			{
-				if (streamIndex == streamNode->descriptorIndex)
-				{
-					// Found the index, nothing to do
-					break;
-				}
-				else if(streamNode->isRedundant)
-				{
-					// Index not found and we have a redundant stream, check all association if we have it
-					for (auto const redundantIndex : streamNode->staticModel->redundantStreams)
-					{
-						if (streamIndex == redundantIndex)
-						{
-							// Replace mapping's streamIndex with this stream's index (streamNodes only contains single and primary streams)
-							streamIndex = streamNode->descriptorIndex;
-							break;
-						}
-					}
-				}
-			}
-		}
-#endif // ENABLE_AVDECC_FEATURE_REDUNDANCY
-		
-		{
-			int pos = 0;
-			// Search for descriptorIndex
-			for (auto const& m : streamMappings)
-			{
-				if (streamIndex == m.descriptorIndex)
-				{
-					// Now search for channel number
-					if (mapping.streamChannel < m.channels.size())
-					{
-						streamSlotID = { pos, mapping.streamChannel };
-					}
-					break;
-				}
-				++pos;
-			}
-		}
-		{
-			int pos = 0;
-			// Search for descriptorIndex
-			for (auto const& m : clusterMappings)
-			{
-				if (mapping.clusterOffset == m.descriptorIndex)
-				{
-					// Now search for channel number
-					if (mapping.clusterChannel < m.channels.size())
-					{
-						clusterSlotID = { pos, mapping.clusterChannel };
-					}
-					break;
-				}
-				++pos;
-			}
-		}
-		if (streamSlotID.first != -1 && clusterSlotID.first != -1)
-		{
-			connections.push_back(creationConnectionFunction(streamSlotID, clusterSlotID));
-		}
-	}
-	
-	return connections;
-}
-
-HashType makeHash(mappingMatrix::Connection const& connection)
-{
-	return (static_cast<HashType>(connection.first.first & 0xFFFF) << 48) + (static_cast<HashType>(connection.first.second & 0xFFFF) << 32) + (static_cast<HashType>(connection.second.first & 0xFFFF) << 16) + static_cast<HashType>(connection.second.second & 0xFFFF);
-}
-
-mappingMatrix::Connection unmakeHash(HashType const& hash)
-{
-	mappingMatrix::Connection connection;
-	
-	connection.first.first = (hash >> 48) & 0xFFFF;
-	connection.first.second = (hash >> 32) & 0xFFFF;
-	connection.second.first = (hash >> 16) & 0xFFFF;
-	connection.second.second = hash & 0xFFFF;
-	
-	return connection;
-}
-
-HashedConnectionsList hashConnectionsList(mappingMatrix::Connections const& connections)
-{
-	HashedConnectionsList list;
-	
-	for (auto const& c : connections)
-	{
-		list.insert(makeHash(c));
-	}
-	
-	return list;
-}
-
-HashedConnectionsList substractList(HashedConnectionsList const& a, HashedConnectionsList const& b)
-{
-	HashedConnectionsList sub{a};
-	
-	for (auto const& v : b)
-	{
-		sub.erase(v);
-	}
-	
-	return sub;
-}
-
 template<la::avdecc::entity::model::DescriptorType StreamPortType>
 mappingMatrix::SlotID getStreamSlotIDFromConnection(mappingMatrix::Connection const& connection)
 {
@@ -268,6 +147,7 @@ template<la::avdecc::entity::model::DescriptorType StreamPortType>
 la::avdecc::entity::model::AudioMappings convertList(NodeMappings const& streamMappings, NodeMappings const& clusterMappings, HashedConnectionsList const& list)
 {
 	la::avdecc::entity::model::AudioMappings mappings;
+	mappings.reserve(list.size());
 	
 	for (auto const& l : list)
 	{
@@ -299,7 +179,7 @@ void processNewConnections(la::avdecc::UniqueIdentifier const entityID, la::avde
 		toAdd = convertList<la::avdecc::entity::model::DescriptorType::StreamPortOutput>(streamMappings, clusterMappings, substractList(newConnections, oldConnections));
 	}
 	
-	// Remove and Add the mappings
+	// Remove and Add the mappings. Removals are sent first so a channel is never transiently mapped twice (ControllerManager splits them into commands fitting an AECP PDU, which are queued in order)
 	auto& manager = avdecc::ControllerManager::getInstance();
 	if (!toRemove.empty())
 	{
@@ -343,6 +223,12 @@ StreamPortDynamicTreeWidgetItem::StreamPortDynamicTreeWidgetItem(la::avdecc::Uni
 		connect(editMappingsButton, &QPushButton::clicked, this, &StreamPortDynamicTreeWidgetItem::editMappingsButtonClicked);
 		parent->setItemWidget(editMappings, 1, editMappingsButton);
 
+		auto* savePreset = new QTreeWidgetItem(this);
+		savePreset->setText(0, "Save dynamic mapping as preset");
+		auto* savePresetButton = new QPushButton("Save...");
+		connect(savePresetButton, &QPushButton::clicked, this, &StreamPortDynamicTreeWidgetItem::saveMappingsPresetButtonClicked);
+		parent->setItemWidget(savePreset, 1, savePresetButton);
+
 		// TODO: Listen for entity offline events and close the popup window
 	}
 }
@@ -484,3 +370,20 @@ void StreamPortDynamicTreeWidgetItem::editMappingsButtonClicked()
 	}
 }
 
+void StreamPortDynamicTreeWidgetItem::saveMappingsPresetButtonClicked()
+{
+	auto const isInput = _streamPortType == la::avdecc::entity::model::DescriptorType::StreamPortInput;
+	auto const defaultName = QString{ "%1 %2" }.arg(isInput ? "STREAM_PORT_INPUT" : "STREAM_PORT_OUTPUT").arg(_streamPortIndex);
+
+	auto ok = false;
+	auto const name = QInputDialog::getText(treeWidget(), "Save Mapping Preset", "Preset name:", QLineEdit::Normal, defaultName, &ok).trimmed();
+	if (!ok || name.isEmpty())
+	{
+		return;
+	}
+
+	if (!avdecc::MappingPresetManager::getInstance().capturePreset(name, _entityID, _streamPortType, _streamPortIndex))
+	{
+		QMessageBox::warning(treeWidget(), "", "Failed to save the mapping preset, the stream port is no longer available.");
+	}
+}
@@ -38,6 +38,7 @@ public:
 
 private:
 	void editMappingsButtonClicked();
+	void saveMappingsPresetButtonClicked();
 
 	la::avdecc::UniqueIdentifier const _entityID{};
 	la::avdecc::entity::model::DescriptorType const _streamPortType{ la::avdecc::entity::model::DescriptorType::Entity };
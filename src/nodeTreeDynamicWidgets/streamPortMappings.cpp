@@ -0,0 +1,82 @@
+/*
+* Copyright 2017-2018, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be usefu_state,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "streamPortMappings.hpp"
+#include <algorithm>
+#include <iterator>
+
+namespace streamPortMappings
+{
+
+DescriptorIndexLookup buildLookup(NodeMappings const& nodeMappings)
+{
+	DescriptorIndexLookup lookup;
+
+	auto pos = 0;
+	for (auto const& m : nodeMappings)
+	{
+		lookup.set(m.descriptorIndex, pos++);
+	}
+
+	return lookup;
+}
+
+HashType makeHash(mappingMatrix::Connection const& connection)
+{
+	return (static_cast<HashType>(connection.first.first & 0xFFFF) << 48) + (static_cast<HashType>(connection.first.second & 0xFFFF) << 32) + (static_cast<HashType>(connection.second.first & 0xFFFF) << 16) + static_cast<HashType>(connection.second.second & 0xFFFF);
+}
+
+mappingMatrix::Connection unmakeHash(HashType const& hash)
+{
+	mappingMatrix::Connection connection;
+	
+	connection.first.first = (hash >> 48) & 0xFFFF;
+	connection.first.second = (hash >> 32) & 0xFFFF;
+	connection.second.first = (hash >> 16) & 0xFFFF;
+	connection.second.second = hash & 0xFFFF;
+	
+	return connection;
+}
+
+HashedConnectionsList hashConnectionsList(mappingMatrix::Connections const& connections)
+{
+	HashedConnectionsList list;
+	list.reserve(connections.size());
+	
+	for (auto const& c : connections)
+	{
+		list.push_back(makeHash(c));
+	}
+	
+	std::sort(list.begin(), list.end());
+	list.erase(std::unique(list.begin(), list.end()), list.end());
+	
+	return list;
+}
+
+HashedConnectionsList substractList(HashedConnectionsList const& a, HashedConnectionsList const& b)
+{
+	HashedConnectionsList sub;
+	
+	std::set_difference(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(sub));
+	
+	return sub;
+}
+
+} // namespace streamPortMappings
@@ -0,0 +1,125 @@
+/*
+* Copyright 2017-2018, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be usefu_state,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#ifndef ENABLE_AVDECC_FEATURE_REDUNDANCY
+#error "Hive requires Redundancy Feature to be enabled in AVDECC Library"
+#endif // ENABLE_AVDECC_FEATURE_REDUNDANCY
+
+#include "mappingMatrixTypes.hpp"
+#include <la/avdecc/controller/avdeccController.hpp>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace streamPortMappings
+{
+
+/** Descriptor index and channels of a node (stream or cluster) of a mapping matrix */
+struct NodeMapping
+{
+	la::avdecc::entity::model::DescriptorIndex descriptorIndex{ la::avdecc::entity::model::DescriptorIndex{ 0u } };
+	std::vector<std::uint16_t> channels{};
+};
+using NodeMappings = std::vector<NodeMapping>;
+using HashType = std::uint64_t;
+using HashedConnectionsList = std::vector<HashType>; // Sorted, without duplicates
+
+/** Direct lookup of the position of a NodeMapping from its descriptor index */
+class DescriptorIndexLookup
+{
+public:
+	/** Sets the position of the descriptor index, unless it is already set and overwrite is false */
+	void set(la::avdecc::entity::model::DescriptorIndex const descriptorIndex, int const position, bool const overwrite = true)
+	{
+		if (descriptorIndex >= _positions.size())
+		{
+			_positions.resize(static_cast<std::size_t>(descriptorIndex) + 1u, -1);
+		}
+		if (overwrite || _positions[descriptorIndex] == -1)
+		{
+			_positions[descriptorIndex] = position;
+		}
+	}
+
+	/** Returns the position of the descriptor index, or -1 */
+	int find(la::avdecc::entity::model::DescriptorIndex const descriptorIndex) const noexcept
+	{
+		return descriptorIndex < _positions.size() ? _positions[descriptorIndex] : -1;
+	}
+
+private:
+	std::vector<int> _positions{};
+};
+
+DescriptorIndexLookup buildLookup(NodeMappings const& nodeMappings);
+
+template<class StreamNodeType>
+mappingMatrix::Connections buildConnections(la::avdecc::controller::model::StreamPortNode const& streamPortNode, std::vector<StreamNodeType const*> const& streamNodes, NodeMappings const& streamMappings, NodeMappings const& clusterMappings, std::function<mappingMatrix::Connection(mappingMatrix::SlotID const streamSlotID, mappingMatrix::SlotID const clusterSlotID)> const& creationConnectionFunction)
+{
+	mappingMatrix::Connections connections;
+
+	// Build direct lookups once, instead of searching the lists for each mapping
+	auto streamLookup = buildLookup(streamMappings);
+	auto const clusterLookup = buildLookup(clusterMappings);
+
+#ifdef ENABLE_AVDECC_FEATURE_REDUNDANCY
+	// In case of redundancy, the streamIndex in a mapping may be any stream of the redundant set, resolve it to the primary stream (streamNodes only contains single and primary streams)
+	for (auto const* streamNode : streamNodes)
+	{
+		if (streamNode->isRedundant)
+		{
+			auto const pos = streamLookup.find(streamNode->descriptorIndex);
+			for (auto const redundantIndex : streamNode->staticModel->redundantStreams)
+			{
+				// Never override a stream that is directly in the list
+				streamLookup.set(redundantIndex, pos, false);
+			}
+		}
+	}
+#endif // ENABLE_AVDECC_FEATURE_REDUNDANCY
+
+	connections.reserve(streamPortNode.dynamicModel->dynamicAudioMap.size());
+
+	// Build list of current connections
+	for (auto const& mapping : streamPortNode.dynamicModel->dynamicAudioMap)
+	{
+		auto const streamPos = streamLookup.find(mapping.streamIndex);
+		auto const clusterPos = clusterLookup.find(mapping.clusterOffset);
+
+		if (streamPos != -1 && clusterPos != -1 && mapping.streamChannel < streamMappings[streamPos].channels.size() && mapping.clusterChannel < clusterMappings[clusterPos].channels.size())
+		{
+			mappingMatrix::SlotID const streamSlotID{ static_cast<std::size_t>(streamPos), mapping.streamChannel };
+			mappingMatrix::SlotID const clusterSlotID{ static_cast<std::size_t>(clusterPos), mapping.clusterChannel };
+			connections.push_back(creationConnectionFunction(streamSlotID, clusterSlotID));
+		}
+	}
+	
+	return connections;
+}
+
+HashType makeHash(mappingMatrix::Connection const& connection);
+mappingMatrix::Connection unmakeHash(HashType const& hash);
+/** Returns the sorted hashes of the connections, without duplicates */
+HashedConnectionsList hashConnectionsList(mappingMatrix::Connections const& connections);
+/** Returns the hashes in a that are not in b */
+HashedConnectionsList substractList(HashedConnectionsList const& a, HashedConnectionsList const& b);
+
+} // namespace streamPortMappings
@@ -23,6 +23,7 @@
 #include <la/avdecc/logger.hpp>
 #include "avdecc/controllerManager.hpp"
 #include "avdecc/helper.hpp"
+#include "avdecc/descriptorDispatcher.hpp"
 #include "toolkit/textEntry.hpp"
 #include "toolkit/comboBox.hpp"
 #include "nodeTreeDynamicWidgets/audioUnitDynamicTreeWidgetItem.hpp"
@@ -31,13 +32,20 @@
 #include "nodeTreeDynamicWidgets/streamPortDynamicTreeWidgetItem.hpp"
 #include "nodeTreeDynamicWidgets/memoryObjectDynamicTreeWidgetItem.hpp"
 #include "entityLogoCache.hpp"
+#include "profiler/profiler.hpp"
+#include "profiler/memoryAccounting.hpp"
 
 #include <vector>
 #include <utility>
 #include <algorithm>
+#include <functional>
+#include <type_traits>
+#include <unordered_map>
 
 #include <QListWidget>
 #include <QHeaderView>
+#include <QStyledItemDelegate>
+#include <QTreeWidgetItemIterator>
 
 #include "painterHelper.hpp"
 
@@ -99,13 +107,46 @@ private:
 	QImage _image;
 };
 
+/** Paints rows as usual, and reports the rows having a pending item widget the first time they are painted (ie. become visible) */
+class LazyItemWidgetDelegate : public QStyledItemDelegate
+{
+public:
+	static constexpr int PendingItemWidgetRole = Qt::UserRole + 1;
+	using VisibleHandler = std::function<void(QModelIndex const& index)>;
+
+	LazyItemWidgetDelegate(VisibleHandler const& visibleHandler, QObject* parent = nullptr)
+		: QStyledItemDelegate{ parent }
+		, _visibleHandler{ visibleHandler }
+	{
+	}
+
+	virtual void paint(QPainter* painter, QStyleOptionViewItem const& option, QModelIndex const& index) const override
+	{
+		QStyledItemDelegate::paint(painter, option, index);
+
+		if (index.data(PendingItemWidgetRole).toBool())
+		{
+			_visibleHandler(index);
+		}
+	}
+
+private:
+	VisibleHandler _visibleHandler{};
+};
+
 class NodeTreeWidgetPrivate : public QObject, public NodeVisitor
 {
 	Q_OBJECT
 public:
 	NodeTreeWidgetPrivate(NodeTreeWidget* q)
 		: q_ptr(q)
+		, _lazyItemWidgetDelegate{ [this](QModelIndex const& index)
+			{
+				createPendingItemWidget(index);
+			} }
 	{
+		q->setItemDelegate(&_lazyItemWidgetDelegate);
+
 		auto& controllerManager = avdecc::ControllerManager::getInstance();
 		connect(&controllerManager, &avdecc::ControllerManager::controllerOffline, this, &NodeTreeWidgetPrivate::controllerOffline);
 		connect(&controllerManager, &avdecc::ControllerManager::entityOnline, this, &NodeTreeWidgetPrivate::entityOnline);
@@ -138,6 +179,10 @@ public:
 	{
 		Q_Q(NodeTreeWidget);
 
+		// Widgets not created yet reference the previous node
+		_pendingItemWidgets.clear();
+		++_pendingItemWidgetsGeneration;
+
 		q->clear();
 
 		_controlledEntityID = entityID;
@@ -151,6 +196,73 @@ public:
 		}
 
 		q->expandAll();
+
+		updateMemoryAccount();
+	}
+
+	/** Accounts the items of the tree (item widgets are not included) */
+	void updateMemoryAccount() noexcept
+	{
+		Q_Q(NodeTreeWidget);
+
+		auto bytes = std::int64_t{ 0 };
+		for (auto it = QTreeWidgetItemIterator{ q }; *it; ++it)
+		{
+			auto const* const item = *it;
+			bytes += static_cast<std::int64_t>(sizeof(QTreeWidgetItem));
+			for (auto column = 0; column < item->columnCount(); ++column)
+			{
+				bytes += profiler::stringBytes(item->text(column));
+			}
+		}
+		_memoryAccount.set(bytes);
+	}
+
+	/** Finds a node in the current model of the entity. Lazily created widgets use it instead of keeping references to the model, which might have been replaced since the tree was built */
+	template<class NodeType>
+	static NodeType const* findNode(la::avdecc::controller::ControlledEntity const& controlledEntity, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::DescriptorIndex const descriptorIndex) noexcept
+	{
+		try
+		{
+			if constexpr (std::is_same_v<NodeType, la::avdecc::controller::model::EntityNode>)
+			{
+				return &controlledEntity.getEntityNode();
+			}
+			else if constexpr (std::is_same_v<NodeType, la::avdecc::controller::model::ConfigurationNode>)
+			{
+				return &controlledEntity.getConfigurationNode(descriptorIndex);
+			}
+			else if constexpr (std::is_same_v<NodeType, la::avdecc::controller::model::StreamInputNode>)
+			{
+				return &controlledEntity.getStreamInputNode(configurationIndex, descriptorIndex);
+			}
+			else if constexpr (std::is_same_v<NodeType, la::avdecc::controller::model::StreamOutputNode>)
+			{
+				return &controlledEntity.getStreamOutputNode(configurationIndex, descriptorIndex);
+			}
+			else if constexpr (std::is_same_v<NodeType, la::avdecc::controller::model::AudioMapNode>)
+			{
+				return &controlledEntity.getAudioMapNode(configurationIndex, descriptorIndex);
+			}
+			else if constexpr (std::is_same_v<NodeType, la::avdecc::controller::model::ClockDomainNode>)
+			{
+				return &controlledEntity.getClockDomainNode(configurationIndex, descriptorIndex);
+			}
+			else
+			{
+				// Not needed by any lazily created widget yet
+				return nullptr;
+			}
+		}
+		catch (...)
+		{
+		}
+		return nullptr;
+	}
+
+	static la::avdecc::entity::model::ConfigurationIndex currentConfiguration(la::avdecc::controller::ControlledEntity const& controlledEntity) noexcept
+	{
+		return controlledEntity.getEntityNode().dynamicModel->currentConfiguration;
 	}
 
 private:
@@ -166,8 +278,16 @@ private:
 			auto* nameItem = new QTreeWidgetItem(q);
 			nameItem->setText(0, "Names");
 			
-			addEditableTextItem(nameItem, "Entity Name", avdecc::helper::entityName(*controlledEntity), avdecc::ControllerManager::AecpCommandType::SetEntityName, {});
-			addEditableTextItem(nameItem, "Group Name", avdecc::helper::groupName(*controlledEntity), avdecc::ControllerManager::AecpCommandType::SetEntityGroupName, {});
+			addEditableTextItem(nameItem, "Entity Name", [this]()
+			{
+				auto controlledEntity = avdecc::ControllerManager::getInstance().getControlledEntity(_controlledEntityID);
+				return controlledEntity ? avdecc::helper::entityName(*controlledEntity) : QString{};
+			}, avdecc::ControllerManager::AecpCommandType::SetEntityName, {});
+			addEditableTextItem(nameItem, "Group Name", [this]()
+			{
+				auto controlledEntity = avdecc::ControllerManager::getInstance().getControlledEntity(_controlledEntityID);
+				return controlledEntity ? avdecc::helper::groupName(*controlledEntity) : QString{};
+			}, avdecc::ControllerManager::AecpCommandType::SetEntityGroupName, {});
 		}
 		
 		// Static model
@@ -218,28 +338,43 @@ private:
 			auto* currentConfigurationItem = new QTreeWidgetItem(dynamicItem);
 			currentConfigurationItem->setText(0, "Current Configuration");
 			
-			auto* configurationComboBox = new qt::toolkit::ComboBox;
-			
-			for (auto const& it : node.configurations)
-			{
-				configurationComboBox->addItem(QString::number(it.first) + ": " + avdecc::helper::configurationName(controlledEntity, it.second), it.first);
-			}
-			
-			auto currentConfigurationComboBoxIndex = configurationComboBox->findData(node.dynamicModel->currentConfiguration);
-			q->setItemWidget(currentConfigurationItem, 1, configurationComboBox);
-			
-			// Send changes
-			connect(configurationComboBox, QOverload<int>::of(&QComboBox::currentIndexChanged), this, [this, configurationComboBox, node]()
+			setItemWidgetLater(currentConfigurationItem, [this, entityID = _controlledEntityID]() -> QWidget*
 			{
-				auto const configurationIndex = configurationComboBox->currentData().value<la::avdecc::entity::model::ConfigurationIndex>();
-				avdecc::ControllerManager::getInstance().setConfiguration(_controlledEntityID, configurationIndex);
+				auto controlledEntity = avdecc::ControllerManager::getInstance().getControlledEntity(entityID);
+				if (!controlledEntity)
+				{
+					return nullptr;
+				}
+				auto const* const node = findNode<la::avdecc::controller::model::EntityNode>(*controlledEntity, {}, {});
+				if (!node)
+				{
+					return nullptr;
+				}
+				
+				auto* configurationComboBox = new qt::toolkit::ComboBox;
+				
+				for (auto const& it : node->configurations)
+				{
+					configurationComboBox->addItem(QString::number(it.first) + ": " + avdecc::helper::configurationName(controlledEntity.get(), it.second), it.first);
+				}
+				
+				auto currentConfigurationComboBoxIndex = configurationComboBox->findData(node->dynamicModel->currentConfiguration);
+				
+				// Send changes
+				connect(configurationComboBox, QOverload<int>::of(&QComboBox::currentIndexChanged), this, [this, configurationComboBox]()
+				{
+					auto const configurationIndex = configurationComboBox->currentData().value<la::avdecc::entity::model::ConfigurationIndex>();
+					avdecc::ControllerManager::getInstance().setConfiguration(_controlledEntityID, configurationIndex);
+				});
+				
+				// Initialize current value
+				{
+					QSignalBlocker const lg{ configurationComboBox }; // Block internal signals so setCurrentIndex do not trigger "currentIndexChanged"
+					configurationComboBox->setCurrentIndex(currentConfigurationComboBoxIndex);
+				}
+				
+				return configurationComboBox;
 			});
-			
-			// Initialize current value
-			{
-				QSignalBlocker const lg{ configurationComboBox }; // Block internal signals so setCurrentIndex do not trigger "currentIndexChanged"
-				configurationComboBox->setCurrentIndex(currentConfigurationComboBoxIndex);
-			}
 		}
 	}
 
@@ -467,20 +602,33 @@ private:
 			auto* descriptorItem = new QTreeWidgetItem(q);
 			descriptorItem->setText(0, "Static Info");
 
-			auto const* const model = node.staticModel;
-
 			auto* mappingsIndexItem = new QTreeWidgetItem(descriptorItem);
 			mappingsIndexItem->setText(0, "Mappings");
 
-			auto* listWidget = new QListWidget;
+			setItemWidgetLater(mappingsIndexItem, [entityID = _controlledEntityID, configurationIndex = currentConfiguration(*controlledEntity), audioMapIndex = node.descriptorIndex]() -> QWidget*
+			{
+				auto controlledEntity = avdecc::ControllerManager::getInstance().getControlledEntity(entityID);
+				if (!controlledEntity)
+				{
+					return nullptr;
+				}
+				auto const* const node = findNode<la::avdecc::controller::model::AudioMapNode>(*controlledEntity, configurationIndex, audioMapIndex);
+				if (!node)
+				{
+					return nullptr;
+				}
+				auto const* const model = node->staticModel;
 
-			q->setItemWidget(mappingsIndexItem, 1, listWidget);
-			listWidget->setStyleSheet(".QListWidget{margin-top:4px;margin-bottom:4px}");
+				auto* listWidget = new QListWidget;
+				listWidget->setStyleSheet(".QListWidget{margin-top:4px;margin-bottom:4px}");
 
-			for (auto const& mapping : model->mappings)
-			{
-				listWidget->addItem(QString("%1.%2 > %3.%4").arg(mapping.streamIndex).arg(mapping.streamChannel).arg(mapping.clusterOffset).arg(mapping.clusterChannel));
-			}
+				for (auto const& mapping : model->mappings)
+				{
+					listWidget->addItem(QString("%1.%2 > %3.%4").arg(mapping.streamIndex).arg(mapping.streamChannel).arg(mapping.clusterOffset).arg(mapping.clusterChannel));
+				}
+
+				return listWidget;
+			});
 		}
 	}
 
@@ -490,15 +638,13 @@ private:
 		createNameItem(controlledEntity, node, avdecc::ControllerManager::AecpCommandType::None, {}); // SetName not supported yet
 
 		Q_Q(NodeTreeWidget);
-		auto const* const model = node.staticModel;
-		auto const* const dynamicModel = node.dynamicModel;
 
 		// Static model
 		{
 			auto* descriptorItem = new QTreeWidgetItem(q);
 			descriptorItem->setText(0, "Static Info");
 
-			addTextItem(descriptorItem, "Clock Sources count", model->clockSources.size());
+			addTextItem(descriptorItem, "Clock Sources count", node.staticModel->clockSources.size());
 		}
 		
 		// Dynamic model
@@ -509,36 +655,46 @@ private:
 			auto* currentSourceItem = new QTreeWidgetItem(dynamicItem);
 			currentSourceItem->setText(0, "Current Clock Source");
 			
-			auto* sourceComboBox = new qt::toolkit::ComboBox;
-			
-			for (auto const sourceIndex : model->clockSources)
+			setItemWidgetLater(currentSourceItem, [this, entityID = _controlledEntityID, configurationIndex = currentConfiguration(*controlledEntity), clockDomainIndex = node.descriptorIndex]() -> QWidget*
 			{
-				try
+				auto controlledEntity = avdecc::ControllerManager::getInstance().getControlledEntity(entityID);
+				if (!controlledEntity)
 				{
-					auto const& node = controlledEntity->getClockSourceNode(controlledEntity->getEntityNode().dynamicModel->currentConfiguration, sourceIndex);
-					auto const name = QString::number(sourceIndex) + ": '" + avdecc::helper::objectName(controlledEntity, node) + "' (" + avdecc::helper::clockSourceToString(node) + ")";
-					sourceComboBox->addItem(name, QVariant::fromValue(sourceIndex));
+					return nullptr;
 				}
-				catch (...)
+				auto const* const clockDomainNode = findNode<la::avdecc::controller::model::ClockDomainNode>(*controlledEntity, configurationIndex, clockDomainIndex);
+				if (!clockDomainNode)
 				{
+					return nullptr;
 				}
-			}
-			
-			auto const currentSourceComboBoxIndex = sourceComboBox->findData(dynamicModel->clockSourceIndex);
-			q->setItemWidget(currentSourceItem, 1, sourceComboBox);
-			
-			// Send changes
-			connect(sourceComboBox, QOverload<int>::of(&QComboBox::currentIndexChanged), this, [this, sourceComboBox, node]()
-			{
-				auto const clockDomainIndex = node.descriptorIndex;
-				auto const sourceIndex = sourceComboBox->currentData().value<la::avdecc::entity::model::ClockSourceIndex>();
-				avdecc::ControllerManager::getInstance().setClockSource(_controlledEntityID, clockDomainIndex, sourceIndex);
-			});
-			
-			// Listen for changes
-			connect(&avdecc::ControllerManager::getInstance(), &avdecc::ControllerManager::clockSourceChanged, sourceComboBox, [this, streamType = node.descriptorType, domainIndex = node.descriptorIndex, sourceComboBox](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::ClockDomainIndex const clockDomainIndex, la::avdecc::entity::model::ClockSourceIndex const sourceIndex)
-			{
-				if (entityID == _controlledEntityID && clockDomainIndex == domainIndex)
+				
+				auto* sourceComboBox = new qt::toolkit::ComboBox;
+				
+				for (auto const sourceIndex : clockDomainNode->staticModel->clockSources)
+				{
+					try
+					{
+						auto const& node = controlledEntity->getClockSourceNode(configurationIndex, sourceIndex);
+						auto const name = QString::number(sourceIndex) + ": '" + avdecc::helper::objectName(controlledEntity.get(), node) + "' (" + avdecc::helper::clockSourceToString(node) + ")";
+						sourceComboBox->addItem(name, QVariant::fromValue(sourceIndex));
+					}
+					catch (...)
+					{
+					}
+				}
+				
+				auto const currentSourceComboBoxIndex = sourceComboBox->findData(clockDomainNode->dynamicModel->clockSourceIndex);
+				
+				// Send changes
+				connect(sourceComboBox, QOverload<int>::of(&QComboBox::currentIndexChanged), this, [this, sourceComboBox, clockDomainIndex]()
+				{
+					auto const sourceIndex = sourceComboBox->currentData().value<la::avdecc::entity::model::ClockSourceIndex>();
+					avdecc::ControllerManager::getInstance().setClockSource(_controlledEntityID, clockDomainIndex, sourceIndex);
+				});
+				
+				// Listen for changes
+				auto* notifier = avdecc::DescriptorDispatcher::getInstance().getNotifier(_controlledEntityID, la::avdecc::entity::model::DescriptorType::ClockDomain, clockDomainIndex);
+				connect(notifier, &avdecc::DescriptorNotifier::clockSourceChanged, sourceComboBox, [sourceComboBox](la::avdecc::entity::model::ClockSourceIndex const sourceIndex)
 				{
 					auto index = sourceComboBox->findData(QVariant::fromValue(sourceIndex));
 					AVDECC_ASSERT(index != -1, "Index not found");
@@ -547,14 +703,16 @@ private:
 						QSignalBlocker const lg{ sourceComboBox }; // Block internal signals so setCurrentIndex do not trigger "currentIndexChanged"
 						sourceComboBox->setCurrentIndex(index);
 					}
+				});
+				
+				// Initialize current value
+				{
+					QSignalBlocker const lg{ sourceComboBox }; // Block internal signals so setCurrentIndex do not trigger "currentIndexChanged"
+					sourceComboBox->setCurrentIndex(currentSourceComboBoxIndex);
 				}
+				
+				return sourceComboBox;
 			});
-			
-			// Initialize current value
-			{
-				QSignalBlocker const lg{ sourceComboBox }; // Block internal signals so setCurrentIndex do not trigger "currentIndexChanged"
-				sourceComboBox->setCurrentIndex(currentSourceComboBoxIndex);
-			}
 		}
 	}
 
@@ -588,7 +746,7 @@ private:
 
 		// Dynamic model
 		{
-			auto* dynamicItem = new MemoryObjectDynamicTreeWidgetItem(_controlledEntityID, node.descriptorIndex, node.dynamicModel, q);
+			auto* dynamicItem = new MemoryObjectDynamicTreeWidgetItem(_controlledEntityID, currentConfiguration(*controlledEntity), node.descriptorIndex, node.staticModel, node.dynamicModel, q);
 			dynamicItem->setText(0, "Dynamic Info");
 		}
 	}
@@ -661,7 +819,12 @@ private:
 
 		if (commandType != avdecc::ControllerManager::AecpCommandType::None)
 		{
-			addEditableTextItem(nameItem, "Name", node.dynamicModel->objectName.data(), commandType, customData);
+			addEditableTextItem(nameItem, "Name", [entityID = _controlledEntityID, configurationIndex = currentConfiguration(*controlledEntity), descriptorIndex = node.descriptorIndex]()
+			{
+				auto controlledEntity = avdecc::ControllerManager::getInstance().getControlledEntity(entityID);
+				auto const* const node = controlledEntity ? findNode<NodeType>(*controlledEntity, configurationIndex, descriptorIndex) : nullptr;
+				return node ? QString{ node->dynamicModel->objectName.data() } : QString{};
+			}, commandType, customData);
 		}
 		else
 		{
@@ -698,121 +861,115 @@ private:
 		addTextItem(treeWidgetItem, std::move(itemName), QVariant::fromValue(itemValue));
 	}
 
-	/** An editable text entry item */
-	void addEditableTextItem(QTreeWidgetItem* const treeWidgetItem, QString itemName, QString itemValue, avdecc::ControllerManager::AecpCommandType commandType, std::any const& customData)
+	/** An editable text entry item. The value is read when the text entry is created */
+	void addEditableTextItem(QTreeWidgetItem* const treeWidgetItem, QString itemName, std::function<QString()> const& valueGetter, avdecc::ControllerManager::AecpCommandType commandType, std::any const& customData)
 	{
-		Q_Q(NodeTreeWidget);
-
 		auto* item = new QTreeWidgetItem(treeWidgetItem);
 		item->setText(0, itemName);
 
-		auto* textEntry = new qt::toolkit::TextEntry(itemValue);
+		setItemWidgetLater(item, [this, valueGetter, commandType, customData]() -> QWidget*
+		{
+			auto* textEntry = new qt::toolkit::TextEntry(valueGetter());
 
-		q->setItemWidget(item, 1, textEntry);
+			auto& dispatcher = avdecc::DescriptorDispatcher::getInstance();
+			auto* entityNotifier = dispatcher.getEntityNotifier(_controlledEntityID);
 
-		connect(&avdecc::ControllerManager::getInstance(), &avdecc::ControllerManager::beginAecpCommand, textEntry, [this, commandType, textEntry](la::avdecc::UniqueIdentifier const entityID, avdecc::ControllerManager::AecpCommandType cmdType)
-		{
-			if (entityID == _controlledEntityID && cmdType == commandType)
-				textEntry->setEnabled(false);
-		});
+			connect(entityNotifier, &avdecc::DescriptorNotifier::beginAecpCommand, textEntry, [commandType, textEntry](avdecc::ControllerManager::AecpCommandType cmdType)
+			{
+				if (cmdType == commandType)
+					textEntry->setEnabled(false);
+			});
 
-		connect(textEntry, &qt::toolkit::TextEntry::returnPressed, textEntry, [this, textEntry, commandType, customData]()
-		{
-			// Send changes
-			switch (commandType)
+			connect(textEntry, &qt::toolkit::TextEntry::returnPressed, textEntry, [this, textEntry, commandType, customData]()
 			{
-				case avdecc::ControllerManager::AecpCommandType::SetEntityName:
-					avdecc::ControllerManager::getInstance().setEntityName(_controlledEntityID, textEntry->text());
-					break;
-				case avdecc::ControllerManager::AecpCommandType::SetEntityGroupName:
-					avdecc::ControllerManager::getInstance().setEntityGroupName(_controlledEntityID, textEntry->text());
-					break;
-				case avdecc::ControllerManager::AecpCommandType::SetConfigurationName:
-					try
+				// Send changes
+				switch (commandType)
+				{
+					case avdecc::ControllerManager::AecpCommandType::SetEntityName:
+						avdecc::ControllerManager::getInstance().setEntityName(_controlledEntityID, textEntry->text());
+						break;
+					case avdecc::ControllerManager::AecpCommandType::SetEntityGroupName:
+						avdecc::ControllerManager::getInstance().setEntityGroupName(_controlledEntityID, textEntry->text());
+						break;
+					case avdecc::ControllerManager::AecpCommandType::SetConfigurationName:
+						try
+						{
+							auto const configIndex = std::any_cast<la::avdecc::entity::model::ConfigurationIndex>(customData);
+							avdecc::ControllerManager::getInstance().setConfigurationName(_controlledEntityID, configIndex, textEntry->text());
+						}
+						catch (...)
+						{
+						}
+						break;
+					case avdecc::ControllerManager::AecpCommandType::SetStreamName:
+						try
+						{
+							auto const customTuple = std::any_cast<std::tuple<la::avdecc::entity::model::ConfigurationIndex, la::avdecc::entity::model::DescriptorType, la::avdecc::entity::model::StreamIndex>>(customData);
+							auto const configIndex = std::get<0>(customTuple);
+							auto const streamType = std::get<1>(customTuple);
+							auto const streamIndex = std::get<2>(customTuple);
+							if (streamType == la::avdecc::entity::model::DescriptorType::StreamInput)
+								avdecc::ControllerManager::getInstance().setStreamInputName(_controlledEntityID, configIndex, streamIndex, textEntry->text());
+							else if (streamType == la::avdecc::entity::model::DescriptorType::StreamOutput)
+								avdecc::ControllerManager::getInstance().setStreamOutputName(_controlledEntityID, configIndex, streamIndex, textEntry->text());
+						}
+						catch (...)
+						{
+						}
+						break;
+					default:
+						break;
+				}
+			});
+
+			connect(entityNotifier, &avdecc::DescriptorNotifier::endAecpCommand, textEntry, [commandType, textEntry](avdecc::ControllerManager::AecpCommandType cmdType, la::avdecc::entity::ControllerEntity::AemCommandStatus const /*status*/)
+			{
+				if (cmdType == commandType)
+					textEntry->setEnabled(true);
+			});
+
+			// Listen for changes
+			try
+			{
+				switch (commandType)
+				{
+					case avdecc::ControllerManager::AecpCommandType::SetEntityName:
+						connect(entityNotifier, &avdecc::DescriptorNotifier::entityNameChanged, textEntry, &qt::toolkit::TextEntry::setText);
+						break;
+					case avdecc::ControllerManager::AecpCommandType::SetEntityGroupName:
+						connect(entityNotifier, &avdecc::DescriptorNotifier::entityGroupNameChanged, textEntry, &qt::toolkit::TextEntry::setText);
+						break;
+					case avdecc::ControllerManager::AecpCommandType::SetConfigurationName:
 					{
 						auto const configIndex = std::any_cast<la::avdecc::entity::model::ConfigurationIndex>(customData);
-						avdecc::ControllerManager::getInstance().setConfigurationName(_controlledEntityID, configIndex, textEntry->text());
-					}
-					catch (...)
-					{
+						auto* notifier = dispatcher.getNotifier(_controlledEntityID, la::avdecc::entity::model::DescriptorType::Configuration, configIndex);
+						connect(notifier, &avdecc::DescriptorNotifier::configurationNameChanged, textEntry, &qt::toolkit::TextEntry::setText);
+						break;
 					}
-					break;
-				case avdecc::ControllerManager::AecpCommandType::SetStreamName:
-					try
+					case avdecc::ControllerManager::AecpCommandType::SetStreamName:
 					{
 						auto const customTuple = std::any_cast<std::tuple<la::avdecc::entity::model::ConfigurationIndex, la::avdecc::entity::model::DescriptorType, la::avdecc::entity::model::StreamIndex>>(customData);
 						auto const configIndex = std::get<0>(customTuple);
 						auto const streamType = std::get<1>(customTuple);
 						auto const streamIndex = std::get<2>(customTuple);
-						if (streamType == la::avdecc::entity::model::DescriptorType::StreamInput)
-							avdecc::ControllerManager::getInstance().setStreamInputName(_controlledEntityID, configIndex, streamIndex, textEntry->text());
-						else if (streamType == la::avdecc::entity::model::DescriptorType::StreamOutput)
-							avdecc::ControllerManager::getInstance().setStreamOutputName(_controlledEntityID, configIndex, streamIndex, textEntry->text());
-					}
-					catch (...)
-					{
+						auto* notifier = dispatcher.getNotifier(_controlledEntityID, streamType, streamIndex);
+						connect(notifier, &avdecc::DescriptorNotifier::streamNameChanged, textEntry, [textEntry, configIndex](la::avdecc::entity::model::ConfigurationIndex const configurationIndex, QString const& streamName)
+						{
+							if (configurationIndex == configIndex)
+								textEntry->setText(streamName);
+						});
+						break;
 					}
-					break;
-				default:
-					break;
+					default:
+						break;
+				}
 			}
-		});
-
-		connect(&avdecc::ControllerManager::getInstance(), &avdecc::ControllerManager::endAecpCommand, textEntry, [this, commandType, textEntry](la::avdecc::UniqueIdentifier const entityID, avdecc::ControllerManager::AecpCommandType cmdType, la::avdecc::entity::ControllerEntity::AemCommandStatus const status)
-		{
-			if (entityID == _controlledEntityID && cmdType == commandType)
-				textEntry->setEnabled(true);
-		});
-
-		// Listen for changes
-		try
-		{
-			switch (commandType)
+			catch (...)
 			{
-				case avdecc::ControllerManager::AecpCommandType::SetEntityName:
-					connect(&avdecc::ControllerManager::getInstance(), &avdecc::ControllerManager::entityNameChanged, textEntry, [this, textEntry](la::avdecc::UniqueIdentifier const entityID, QString const& entityName)
-					{
-						if (entityID == _controlledEntityID)
-							textEntry->setText(entityName);
-					});
-					break;
-				case avdecc::ControllerManager::AecpCommandType::SetEntityGroupName:
-					connect(&avdecc::ControllerManager::getInstance(), &avdecc::ControllerManager::entityGroupNameChanged, textEntry, [this, textEntry](la::avdecc::UniqueIdentifier const entityID, QString const& entityGroupName)
-					{
-						if (entityID == _controlledEntityID)
-							textEntry->setText(entityGroupName);
-					});
-					break;
-				case avdecc::ControllerManager::AecpCommandType::SetConfigurationName:
-				{
-					auto const configIndex = std::any_cast<la::avdecc::entity::model::ConfigurationIndex>(customData);
-					connect(&avdecc::ControllerManager::getInstance(), &avdecc::ControllerManager::configurationNameChanged, textEntry, [this, textEntry, configIndex](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, QString const& configurationName)
-					{
-						if (entityID == _controlledEntityID && configurationIndex == configIndex)
-							textEntry->setText(configurationName);
-					});
-					break;
-				}
-				case avdecc::ControllerManager::AecpCommandType::SetStreamName:
-				{
-					auto const customTuple = std::any_cast<std::tuple<la::avdecc::entity::model::ConfigurationIndex, la::avdecc::entity::model::DescriptorType, la::avdecc::entity::model::StreamIndex>>(customData);
-					auto const configIndex = std::get<0>(customTuple);
-					auto const streamType = std::get<1>(customTuple);
-					auto const streamIndex = std::get<2>(customTuple);
-					connect(&avdecc::ControllerManager::getInstance(), &avdecc::ControllerManager::streamNameChanged, textEntry, [this, textEntry, configIndex, streamType, strIndex = streamIndex](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::DescriptorType const descriptorType, la::avdecc::entity::model::StreamIndex const streamIndex, QString const& streamName)
-					{
-						if (entityID == _controlledEntityID && configurationIndex == configIndex && descriptorType == streamType && streamIndex == strIndex)
-							textEntry->setText(streamName);
-					});
-					break;
-				}
-				default:
-					break;
 			}
-		}
-		catch (...)
-		{
-		}
+
+			return textEntry;
+		});
 	}
 	
 	void addImageItem(QTreeWidgetItem* const treeWidgetItem, QString itemName, la::avdecc::entity::model::MemoryObjectType const memoryObjectType)
@@ -830,31 +987,75 @@ private:
 				return;
 		}
 		
-		auto const image = EntityLogoCache::getInstance().getImage(_controlledEntityID, type);
-
-		Q_Q(NodeTreeWidget);
-		
 		auto* item = new QTreeWidgetItem(treeWidgetItem);
 		item->setText(0, std::move(itemName));
 		
-		auto* label = new Label;
-		label->setFixedHeight(96);
-		label->setImage(image);
-		q->setItemWidget(item, 1, label);
-		
-		connect(label, &Label::clicked, label, [this, requestedType = type]()
+		// The image is only requested from the cache once the row is visible
+		setItemWidgetLater(item, [this, type]() -> QWidget*
 		{
-			EntityLogoCache::getInstance().getImage(_controlledEntityID, requestedType, true);
+			auto const image = EntityLogoCache::getInstance().getImage(_controlledEntityID, type);
+			
+			auto* label = new Label;
+			label->setFixedHeight(96);
+			label->setImage(image);
+			
+			connect(label, &Label::clicked, label, [this, requestedType = type]()
+			{
+				EntityLogoCache::getInstance().getImage(_controlledEntityID, requestedType, true);
+			});
+			
+			connect(&EntityLogoCache::getInstance(), &EntityLogoCache::imageChanged, label, [this, label, requestedType = type](const la::avdecc::UniqueIdentifier entityID, const EntityLogoCache::Type type)
+			{
+				if (entityID == _controlledEntityID && type == requestedType)
+				{
+					auto const image = EntityLogoCache::getInstance().getImage(_controlledEntityID, type);
+					label->setImage(image);
+				}
+			});
+			
+			return label;
 		});
-		
-		connect(&EntityLogoCache::getInstance(), &EntityLogoCache::imageChanged, label, [this, label, requestedType = type](const la::avdecc::UniqueIdentifier entityID, const EntityLogoCache::Type type)
+	}
+
+	using ItemWidgetFactory = std::function<QWidget*()>;
+
+	/** Sets the widget of the value column of the item, only creating it when the item is painted for the first time */
+	void setItemWidgetLater(QTreeWidgetItem* const item, ItemWidgetFactory const& factory)
+	{
+		item->setData(1, LazyItemWidgetDelegate::PendingItemWidgetRole, true);
+		_pendingItemWidgets[item] = factory;
+	}
+
+	void createPendingItemWidget(QModelIndex const& index)
+	{
+		Q_Q(NodeTreeWidget);
+
+		auto* const item = q->itemFromIndex(index);
+		auto const it = _pendingItemWidgets.find(item);
+		if (it == _pendingItemWidgets.end())
 		{
-			if (entityID == _controlledEntityID && type == requestedType)
+			return;
+		}
+
+		auto factory = std::move(it->second);
+		_pendingItemWidgets.erase(it);
+
+		// We are called while painting, defer the creation of the widget. The item might have been destroyed by then, if setNode was called
+		QMetaObject::invokeMethod(this, [this, item, factory = std::move(factory), generation = _pendingItemWidgetsGeneration]()
+		{
+			if (generation != _pendingItemWidgetsGeneration)
 			{
-				auto const image = EntityLogoCache::getInstance().getImage(_controlledEntityID, type);
-				label->setImage(image);
+				return;
 			}
-		});
+
+			Q_Q(NodeTreeWidget);
+
+			item->setData(1, LazyItemWidgetDelegate::PendingItemWidgetRole, QVariant{});
+			if (auto* widget = factory())
+			{
+				q->setItemWidget(item, 1, widget);
+			}
+		}, Qt::QueuedConnection);
 	}
 
 private:
@@ -862,6 +1063,10 @@ private:
 	Q_DECLARE_PUBLIC(NodeTreeWidget);
 
 	la::avdecc::UniqueIdentifier _controlledEntityID{};
+	LazyItemWidgetDelegate _lazyItemWidgetDelegate;
+	std::unordered_map<QTreeWidgetItem*, ItemWidgetFactory> _pendingItemWidgets{};
+	std::uint32_t _pendingItemWidgetsGeneration{ 0u }; // Incremented each time the tree is cleared
+	profiler::MemoryAccount _memoryAccount{ profiler::MemorySubsystem::Inspector };
 };
 
 NodeTreeWidget::NodeTreeWidget(QWidget* parent)
@@ -880,6 +1085,8 @@ NodeTreeWidget::~NodeTreeWidget()
 
 void NodeTreeWidget::setNode(la::avdecc::UniqueIdentifier const entityID, AnyNode const& node)
 {
+	PROFILER_SCOPE("nodeTree", "NodeTreeWidget::setNode");
+
 	Q_D(NodeTreeWidget);
 	d->setNode(entityID, node);
 }
@@ -0,0 +1,96 @@
+/*
+* Copyright 2017-2018, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be usefu_state,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "memoryAccounting.hpp"
+#include <QStringList>
+#include <la/avdecc/utils.hpp>
+
+namespace profiler
+{
+MemoryAccounting& MemoryAccounting::getInstance() noexcept
+{
+	static MemoryAccounting s_MemoryAccounting{};
+
+	return s_MemoryAccounting;
+}
+
+void MemoryAccounting::adjust(MemorySubsystem const subsystem, std::int64_t const deltaBytes) noexcept
+{
+	auto const index = la::avdecc::to_integral(subsystem);
+	auto const current = _currentBytes[index].fetch_add(deltaBytes, std::memory_order_relaxed) + deltaBytes;
+
+	// Raise the peak if needed
+	auto peak = _peakBytes[index].load(std::memory_order_relaxed);
+	while (current > peak && !_peakBytes[index].compare_exchange_weak(peak, current, std::memory_order_relaxed))
+	{
+	}
+}
+
+MemoryAccounting::Usage MemoryAccounting::getUsage(MemorySubsystem const subsystem) const noexcept
+{
+	auto const index = la::avdecc::to_integral(subsystem);
+	return Usage{ _currentBytes[index].load(std::memory_order_relaxed), _peakBytes[index].load(std::memory_order_relaxed) };
+}
+
+QString MemoryAccounting::snapshot() const noexcept
+{
+	auto elements = QStringList{};
+	for (auto index = std::size_t{ 0u }; index < SubsystemsCount; ++index)
+	{
+		auto const subsystem = static_cast<MemorySubsystem>(index);
+		auto const usage = getUsage(subsystem);
+		elements << QString{ "%1 %2 (peak %3)" }.arg(subsystemName(subsystem), formatBytes(usage.currentBytes), formatBytes(usage.peakBytes));
+	}
+	return "Memory usage: " + elements.join(", ");
+}
+
+QString MemoryAccounting::subsystemName(MemorySubsystem const subsystem) noexcept
+{
+	switch (subsystem)
+	{
+		case MemorySubsystem::Logger:
+			return "Logger";
+		case MemorySubsystem::LogoCache:
+			return "Logo Cache";
+		case MemorySubsystem::MatrixNodes:
+			return "Matrix Nodes";
+		case MemorySubsystem::ConnectionMatrix:
+			return "Connection Matrix";
+		case MemorySubsystem::Inspector:
+			return "Inspector";
+		default:
+			AVDECC_ASSERT(false, "Not handled!");
+			return "Unknown";
+	}
+}
+
+QString MemoryAccounting::formatBytes(std::int64_t const bytes) noexcept
+{
+	if (bytes < 1024)
+	{
+		return QString{ "%1 B" }.arg(bytes);
+	}
+	if (bytes < 1024 * 1024)
+	{
+		return QString{ "%1 KiB" }.arg(static_cast<double>(bytes) / 1024.0, 0, 'f', 1);
+	}
+	return QString{ "%1 MiB" }.arg(static_cast<double>(bytes) / (1024.0 * 1024.0), 0, 'f', 1);
+}
+
+} // namespace profiler
@@ -0,0 +1,134 @@
+/*
+* Copyright 2017-2018, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be usefu_state,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <QString>
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace profiler
+{
+enum class MemorySubsystem
+{
+	Logger = 0,
+	LogoCache,
+	MatrixNodes,
+	ConnectionMatrix,
+	Inspector,
+
+	Count
+};
+
+/**
+* @brief Current and peak bytes used by each subsystem of Hive.
+* @details Subsystems report what they own through MemoryAccount objects (explicit accounting, not allocator hooks),
+*          so the numbers are estimates of the data structures sizes, not including allocator overhead.
+*          All methods are lock-free and can be called from any thread.
+*/
+class MemoryAccounting final
+{
+public:
+	struct Usage
+	{
+		std::int64_t currentBytes{ 0 };
+		std::int64_t peakBytes{ 0 };
+	};
+
+	static MemoryAccounting& getInstance() noexcept;
+
+	void adjust(MemorySubsystem const subsystem, std::int64_t const deltaBytes) noexcept;
+	Usage getUsage(MemorySubsystem const subsystem) const noexcept;
+
+	/** Returns a single line summary of all subsystems, suitable for the log */
+	QString snapshot() const noexcept;
+
+	static QString subsystemName(MemorySubsystem const subsystem) noexcept;
+	static QString formatBytes(std::int64_t const bytes) noexcept;
+
+	// Deleted compiler auto-generated methods
+	MemoryAccounting(MemoryAccounting&&) = delete;
+	MemoryAccounting(MemoryAccounting const&) = delete;
+	MemoryAccounting& operator=(MemoryAccounting const&) = delete;
+	MemoryAccounting& operator=(MemoryAccounting&&) = delete;
+
+private:
+	static constexpr auto SubsystemsCount = static_cast<std::size_t>(MemorySubsystem::Count);
+
+	MemoryAccounting() noexcept = default;
+
+	std::array<std::atomic<std::int64_t>, SubsystemsCount> _currentBytes{};
+	std::array<std::atomic<std::int64_t>, SubsystemsCount> _peakBytes{};
+};
+
+/** Bytes owned by a single object, accounted to a subsystem and released when the object is destroyed */
+class MemoryAccount final
+{
+public:
+	explicit MemoryAccount(MemorySubsystem const subsystem) noexcept
+		: _accounting{ MemoryAccounting::getInstance() } // Also makes sure the accounting singleton outlives static accounts
+		, _subsystem{ subsystem }
+	{
+	}
+
+	~MemoryAccount() noexcept
+	{
+		set(0);
+	}
+
+	/** Sets the total bytes owned by the object */
+	void set(std::int64_t const bytes) noexcept
+	{
+		if (bytes != _bytes)
+		{
+			_accounting.adjust(_subsystem, bytes - _bytes);
+			_bytes = bytes;
+		}
+	}
+
+	void add(std::int64_t const bytes) noexcept
+	{
+		set(_bytes + bytes);
+	}
+
+	std::int64_t bytes() const noexcept
+	{
+		return _bytes;
+	}
+
+	// Deleted compiler auto-generated methods
+	MemoryAccount(MemoryAccount&&) = delete;
+	MemoryAccount(MemoryAccount const&) = delete;
+	MemoryAccount& operator=(MemoryAccount const&) = delete;
+	MemoryAccount& operator=(MemoryAccount&&) = delete;
+
+private:
+	MemoryAccounting& _accounting;
+	MemorySubsystem const _subsystem{ MemorySubsystem::Logger };
+	std::int64_t _bytes{ 0 };
+};
+
+/** Estimated bytes of the characters of a QString (shared data is counted by each owner) */
+inline std::int64_t stringBytes(QString const& string) noexcept
+{
+	return static_cast<std::int64_t>(string.capacity()) * static_cast<std::int64_t>(sizeof(QChar));
+}
+
+} // namespace profiler
@@ -0,0 +1,133 @@
+/*
+* Copyright 2017-2018, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be usefu_state,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "memoryUsageDialog.hpp"
+#include "memoryAccounting.hpp"
+
+#include <QHeaderView>
+#include <QTableWidget>
+#include <QTimer>
+#include <QVBoxLayout>
+
+namespace profiler
+{
+class MemoryUsageDialogImpl final
+{
+public:
+	MemoryUsageDialogImpl(MemoryUsageDialog* parent)
+		: _layout{ parent }
+		, _table{ SubsystemsCount + 1, 3, parent }
+		, _refreshTimer{ parent }
+	{
+		_table.setHorizontalHeaderLabels({ "Subsystem", "Current", "Peak" });
+		_table.verticalHeader()->hide();
+		_table.horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+		_table.setEditTriggers(QAbstractItemView::NoEditTriggers);
+		_table.setSelectionMode(QAbstractItemView::NoSelection);
+
+		for (auto row = 0; row <= SubsystemsCount; ++row)
+		{
+			auto const name = row < SubsystemsCount ? MemoryAccounting::subsystemName(static_cast<MemorySubsystem>(row)) : QString{ "Total" };
+			_table.setItem(row, 0, new QTableWidgetItem{ name });
+			for (auto column = 1; column < 3; ++column)
+			{
+				auto* item = new QTableWidgetItem{};
+				item->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
+				_table.setItem(row, column, item);
+			}
+		}
+
+		_layout.addWidget(&_table);
+
+		_refreshTimer.setInterval(1000);
+		QObject::connect(&_refreshTimer, &QTimer::timeout, parent, [this]()
+		{
+			refresh();
+		});
+	}
+
+	void refresh() noexcept
+	{
+		auto const& accounting = MemoryAccounting::getInstance();
+
+		auto totalCurrent = std::int64_t{ 0 };
+		auto totalPeak = std::int64_t{ 0 }; // Sum of the peaks, which is an upper bound of the total peak
+		for (auto row = 0; row < SubsystemsCount; ++row)
+		{
+			auto const usage = accounting.getUsage(static_cast<MemorySubsystem>(row));
+			setRow(row, usage.currentBytes, usage.peakBytes);
+			totalCurrent += usage.currentBytes;
+			totalPeak += usage.peakBytes;
+		}
+		setRow(SubsystemsCount, totalCurrent, totalPeak);
+	}
+
+	void setActive(bool const active) noexcept
+	{
+		if (active)
+		{
+			refresh();
+			_refreshTimer.start();
+		}
+		else
+		{
+			_refreshTimer.stop();
+		}
+	}
+
+private:
+	static constexpr auto SubsystemsCount = static_cast<int>(MemorySubsystem::Count);
+
+	void setRow(int const row, std::int64_t const currentBytes, std::int64_t const peakBytes) noexcept
+	{
+		_table.item(row, 1)->setText(MemoryAccounting::formatBytes(currentBytes));
+		_table.item(row, 2)->setText(MemoryAccounting::formatBytes(peakBytes));
+	}
+
+	QVBoxLayout _layout;
+	QTableWidget _table;
+	QTimer _refreshTimer;
+};
+
+MemoryUsageDialog::MemoryUsageDialog(QWidget* parent)
+	: QDialog(parent)
+	, _pImpl(new MemoryUsageDialogImpl(this))
+{
+	setWindowTitle("Memory Usage");
+	resize(420, 240);
+}
+
+MemoryUsageDialog::~MemoryUsageDialog() noexcept
+{
+	delete _pImpl;
+}
+
+void MemoryUsageDialog::showEvent(QShowEvent* event)
+{
+	QDialog::showEvent(event);
+	_pImpl->setActive(true);
+}
+
+void MemoryUsageDialog::hideEvent(QHideEvent* event)
+{
+	_pImpl->setActive(false);
+	QDialog::hideEvent(event);
+}
+
+} // namespace profiler
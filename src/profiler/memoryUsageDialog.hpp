@@ -0,0 +1,48 @@
+/*
+* Copyright 2017-2018, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be usefu_state,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <QDialog>
+
+namespace profiler
+{
+class MemoryUsageDialogImpl;
+
+/** Live view of the current and peak bytes accounted by each subsystem, refreshed every second while visible */
+class MemoryUsageDialog : public QDialog
+{
+public:
+	MemoryUsageDialog(QWidget* parent = nullptr);
+	virtual ~MemoryUsageDialog() noexcept;
+
+	// Deleted compiler auto-generated methods
+	MemoryUsageDialog(MemoryUsageDialog&&) = delete;
+	MemoryUsageDialog(MemoryUsageDialog const&) = delete;
+	MemoryUsageDialog& operator=(MemoryUsageDialog const&) = delete;
+	MemoryUsageDialog& operator=(MemoryUsageDialog&&) = delete;
+
+private:
+	virtual void showEvent(QShowEvent* event) override;
+	virtual void hideEvent(QHideEvent* event) override;
+
+	MemoryUsageDialogImpl* _pImpl{ nullptr };
+};
+
+} // namespace profiler
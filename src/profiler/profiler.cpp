@@ -0,0 +1,348 @@
+/*
+* Copyright 2017-2018, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be usefu_state,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "profiler.hpp"
+
+#include <QCoreApplication>
+#include <QFile>
+#include <QThread>
+#include <QTextStream>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace profiler
+{
+namespace
+{
+/** Origin of all timestamps, so they fit in a double (as Chrome trace JSON expects) without losing precision */
+static auto const s_origin = std::chrono::steady_clock::now();
+
+struct Event
+{
+	char const* category{ nullptr };
+	char const* name{ nullptr };
+	std::int64_t timestampUs{ 0 };
+	std::int64_t durationUs{ 0 };
+	std::uint64_t id{ 0u };
+	char phase{ 'X' };
+};
+
+/** Single producer (the owning thread), single consumer (the GUI thread) ring buffer */
+class ThreadBuffer final
+{
+public:
+	static constexpr std::uint64_t Capacity = 65536u;
+
+	ThreadBuffer(QString const& threadName, int const threadID) noexcept
+		: _threadName{ threadName }
+		, _threadID{ threadID }
+	{
+	}
+
+	void push(Event const& event) noexcept
+	{
+		auto const writeIndex = _writeIndex.load(std::memory_order_relaxed);
+		if (writeIndex - _readIndex.load(std::memory_order_acquire) >= Capacity)
+		{
+			_dropped.fetch_add(1u, std::memory_order_relaxed);
+			return;
+		}
+		_events[writeIndex % Capacity] = event;
+		_writeIndex.store(writeIndex + 1u, std::memory_order_release);
+	}
+
+	/** Consumer side: discards everything recorded so far */
+	void clear() noexcept
+	{
+		_readIndex.store(_writeIndex.load(std::memory_order_acquire), std::memory_order_release);
+		_dropped.store(0u, std::memory_order_relaxed);
+	}
+
+	/** Consumer side: calls the handler for each recorded event, without consuming them */
+	template<typename Handler>
+	void forEach(Handler const& handler) const noexcept
+	{
+		auto const writeIndex = _writeIndex.load(std::memory_order_acquire);
+		for (auto index = _readIndex.load(std::memory_order_relaxed); index < writeIndex; ++index)
+		{
+			handler(_events[index % Capacity]);
+		}
+	}
+
+	QString const& threadName() const noexcept
+	{
+		return _threadName;
+	}
+
+	int threadID() const noexcept
+	{
+		return _threadID;
+	}
+
+	std::uint64_t dropped() const noexcept
+	{
+		return _dropped.load(std::memory_order_relaxed);
+	}
+
+	/** Owned by a running thread (ownership is only changed and checked with the profiler lock held) */
+	bool isInUse() const noexcept
+	{
+		return _inUse;
+	}
+
+	/** Hands the buffer of an exited thread to a new thread, discarding the events of the previous one */
+	void reuse(QString const& threadName, int const threadID) noexcept
+	{
+		clear();
+		_threadName = threadName;
+		_threadID = threadID;
+		_inUse = true;
+	}
+
+	void release() noexcept
+	{
+		_inUse = false;
+	}
+
+private:
+	QString _threadName{};
+	int _threadID{ 0 };
+	bool _inUse{ true };
+	std::unique_ptr<Event[]> const _events{ new Event[Capacity] };
+	std::atomic<std::uint64_t> _writeIndex{ 0u };
+	std::atomic<std::uint64_t> _readIndex{ 0u };
+	std::atomic<std::uint64_t> _dropped{ 0u };
+};
+
+} // namespace
+
+class ProfilerImpl final : public Profiler
+{
+public:
+	virtual void setEnabled(bool const enabled) noexcept override
+	{
+		if (enabled && !isEnabled())
+		{
+			clear();
+		}
+		_enabled.store(enabled, std::memory_order_relaxed);
+	}
+
+	virtual void clear() noexcept override
+	{
+		auto const lg = std::lock_guard{ _lock };
+		for (auto const& buffer : _buffers)
+		{
+			buffer->clear();
+		}
+		_unbufferedEvents.store(0u, std::memory_order_relaxed);
+	}
+
+	virtual bool save(QString const& filePath) const noexcept override
+	{
+		auto file = QFile{ filePath };
+		if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text))
+		{
+			return false;
+		}
+
+		auto const pid = QCoreApplication::applicationPid();
+		auto stream = QTextStream{ &file };
+		auto first = true;
+		auto const separator = [&stream, &first]()
+		{
+			if (!first)
+			{
+				stream << ",\n";
+			}
+			first = false;
+		};
+
+		stream << "{\"traceEvents\":[\n";
+		if (auto const unbuffered = _unbufferedEvents.load(std::memory_order_relaxed); unbuffered != 0u)
+		{
+			separator();
+			stream << "{\"ph\":\"i\",\"s\":\"p\",\"cat\":\"profiler\",\"name\":\"Dropped events (too many threads)\",\"ts\":0,\"pid\":" << pid << ",\"tid\":0,\"args\":{\"count\":" << unbuffered << "}}";
+		}
+		{
+			auto const lg = std::lock_guard{ _lock };
+			for (auto const& buffer : _buffers)
+			{
+				auto const tid = buffer->threadID();
+				separator();
+				stream << "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":" << pid << ",\"tid\":" << tid << ",\"args\":{\"name\":\"" << buffer->threadName() << "\"}}";
+
+				if (auto const dropped = buffer->dropped(); dropped != 0u)
+				{
+					separator();
+					stream << "{\"ph\":\"i\",\"s\":\"t\",\"cat\":\"profiler\",\"name\":\"Dropped events\",\"ts\":0,\"pid\":" << pid << ",\"tid\":" << tid << ",\"args\":{\"count\":" << dropped << "}}";
+				}
+
+				buffer->forEach(
+					[&stream, &separator, pid, tid](Event const& event)
+					{
+						separator();
+						stream << "{\"ph\":\"" << event.phase << "\",\"cat\":\"" << event.category << "\",\"name\":\"" << event.name << "\",\"ts\":" << event.timestampUs << ",\"pid\":" << pid << ",\"tid\":" << tid;
+						if (event.phase == 'X')
+						{
+							stream << ",\"dur\":" << event.durationUs;
+						}
+						else
+						{
+							stream << ",\"id\":\"0x" << QString::number(event.id, 16) << "\"";
+						}
+						stream << "}";
+					});
+			}
+		}
+		stream << "\n],\"displayTimeUnit\":\"ms\"}\n";
+		stream.flush();
+
+		return file.error() == QFileDevice::NoError;
+	}
+
+	virtual void addComplete(char const* const category, char const* const name, std::int64_t const beginUs, std::int64_t const endUs) noexcept override
+	{
+		record(Event{ category, name, beginUs, endUs - beginUs, 0u, 'X' });
+	}
+
+	virtual void addAsyncBegin(char const* const category, char const* const name, std::uint64_t const id) noexcept override
+	{
+		if (isEnabled())
+		{
+			record(Event{ category, name, now(), 0, id, 'b' });
+		}
+	}
+
+	virtual void addAsyncEnd(char const* const category, char const* const name, std::uint64_t const id) noexcept override
+	{
+		if (isEnabled())
+		{
+			record(Event{ category, name, now(), 0, id, 'e' });
+		}
+	}
+
+private:
+	static constexpr auto MaxThreadBuffers = std::size_t{ 64u };
+
+	/** Registration of the calling thread, giving its buffer back for reuse when the thread exits */
+	class ThreadRegistration final
+	{
+	public:
+		ThreadRegistration(ProfilerImpl& profiler) noexcept
+			: _profiler{ profiler }
+			, _buffer{ profiler.acquireBuffer() }
+		{
+		}
+
+		~ThreadRegistration() noexcept
+		{
+			if (_buffer)
+			{
+				_profiler.releaseBuffer(*_buffer);
+			}
+		}
+
+		ThreadBuffer* buffer() const noexcept
+		{
+			return _buffer;
+		}
+
+		// Deleted compiler auto-generated methods
+		ThreadRegistration(ThreadRegistration const&) = delete;
+		ThreadRegistration(ThreadRegistration&&) = delete;
+		ThreadRegistration& operator=(ThreadRegistration const&) = delete;
+		ThreadRegistration& operator=(ThreadRegistration&&) = delete;
+
+	private:
+		ProfilerImpl& _profiler;
+		ThreadBuffer* const _buffer{ nullptr };
+	};
+
+	/** Appends the event to the calling thread's buffer, registering the thread on first use */
+	void record(Event const& event) noexcept
+	{
+		static thread_local ThreadRegistration s_registration{ *this };
+		if (auto* const buffer = s_registration.buffer())
+		{
+			buffer->push(event);
+		}
+		else
+		{
+			_unbufferedEvents.fetch_add(1u, std::memory_order_relaxed);
+		}
+	}
+
+	/** Gets a buffer for the calling thread: one released by an exited thread (its events are kept until then), else a new one unless the limit is reached */
+	ThreadBuffer* acquireBuffer() noexcept
+	{
+		auto const lg = std::lock_guard{ _lock };
+
+		// Each thread gets its own trace thread ID, even when reusing a buffer
+		auto const threadID = ++_lastThreadID;
+		auto const* const app = QCoreApplication::instance();
+		auto const isGuiThread = app && app->thread() == QThread::currentThread();
+		auto const threadName = isGuiThread ? QString{ "GUI thread" } : QString{ "Thread %1" }.arg(threadID);
+
+		for (auto const& buffer : _buffers)
+		{
+			if (!buffer->isInUse())
+			{
+				buffer->reuse(threadName, threadID);
+				return buffer.get();
+			}
+		}
+		if (_buffers.size() >= MaxThreadBuffers)
+		{
+			return nullptr;
+		}
+		_buffers.push_back(std::make_unique<ThreadBuffer>(threadName, threadID));
+		return _buffers.back().get();
+	}
+
+	void releaseBuffer(ThreadBuffer& buffer) noexcept
+	{
+		auto const lg = std::lock_guard{ _lock };
+		buffer.release();
+	}
+
+	// Private members
+	mutable std::mutex _lock{};
+	std::vector<std::unique_ptr<ThreadBuffer>> _buffers{}; // Never shrinks, buffers of exited threads are reused by new ones
+	int _lastThreadID{ 0 }; // Trace thread IDs start at 1, 0 is used for process wide events
+	std::atomic<std::uint64_t> _unbufferedEvents{ 0u }; // Events of threads started after MaxThreadBuffers were all in use
+};
+
+Profiler& Profiler::getInstance() noexcept
+{
+	static ProfilerImpl s_Profiler{};
+
+	return s_Profiler;
+}
+
+std::int64_t Profiler::now() noexcept
+{
+	return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - s_origin).count();
+}
+
+} // namespace profiler
@@ -0,0 +1,119 @@
+/*
+* Copyright 2017-2018, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be usefu_state,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <QString>
+#include <atomic>
+#include <cstdint>
+
+namespace profiler
+{
+/**
+* @brief Chrome trace-event recorder.
+* @details Events are appended to a lock-free buffer owned by the calling thread (only registering a new thread takes a lock),
+*          and dropped when that buffer is full. The buffer of an exited thread is reused by the next new thread, dropping its events, and at most 64 threads record at once.
+*          Nothing is recorded until the profiler is enabled, and enabling it discards previously recorded events so a trace always starts empty.
+*          The saved JSON can be opened in Perfetto or chrome://tracing.
+* @note Category and name of an event are stored as raw pointers and must be string literals.
+*       setEnabled, save and clear must be called from the GUI thread, recording functions are callable from any thread.
+*/
+class Profiler
+{
+public:
+	static Profiler& getInstance() noexcept;
+
+	virtual void setEnabled(bool const enabled) noexcept = 0;
+	bool isEnabled() const noexcept
+	{
+		return _enabled.load(std::memory_order_relaxed);
+	}
+
+	/** Discards all recorded events */
+	virtual void clear() noexcept = 0;
+	/** Writes all recorded events as Chrome trace-event JSON. Returns false if the file cannot be written */
+	virtual bool save(QString const& filePath) const noexcept = 0;
+
+	/** Records a complete ('X') event */
+	virtual void addComplete(char const* const category, char const* const name, std::int64_t const beginUs, std::int64_t const endUs) noexcept = 0;
+	/** Records the beginning ('b') of an asynchronous event, ended by a call to addAsyncEnd with the same category, name and id */
+	virtual void addAsyncBegin(char const* const category, char const* const name, std::uint64_t const id) noexcept = 0;
+	/** Records the end ('e') of an asynchronous event */
+	virtual void addAsyncEnd(char const* const category, char const* const name, std::uint64_t const id) noexcept = 0;
+
+	/** Current timestamp, in microseconds */
+	static std::int64_t now() noexcept;
+
+	// Deleted compiler auto-generated methods
+	Profiler(Profiler&&) = delete;
+	Profiler(Profiler const&) = delete;
+	Profiler& operator=(Profiler const&) = delete;
+	Profiler& operator=(Profiler&&) = delete;
+
+protected:
+	Profiler() = default;
+	virtual ~Profiler() = default;
+
+	std::atomic_bool _enabled{ false };
+};
+
+/** RAII helper recording a complete event covering its lifetime. Costs a single relaxed load when the profiler is disabled */
+class Scope final
+{
+public:
+	Scope(char const* const category, char const* const name) noexcept
+		: _category{ category }
+		, _name{ name }
+	{
+		if (Profiler::getInstance().isEnabled())
+		{
+			_beginUs = Profiler::now();
+		}
+	}
+
+	~Scope() noexcept
+	{
+		if (_beginUs >= 0)
+		{
+			auto& profiler = Profiler::getInstance();
+			if (profiler.isEnabled())
+			{
+				profiler.addComplete(_category, _name, _beginUs, Profiler::now());
+			}
+		}
+	}
+
+	// Deleted compiler auto-generated methods
+	Scope(Scope&&) = delete;
+	Scope(Scope const&) = delete;
+	Scope& operator=(Scope const&) = delete;
+	Scope& operator=(Scope&&) = delete;
+
+private:
+	char const* const _category{ nullptr };
+	char const* const _name{ nullptr };
+	std::int64_t _beginUs{ -1 };
+};
+
+} // namespace profiler
+
+#define PROFILER_CONCAT_IMPL(a, b) a##b
+#define PROFILER_CONCAT(a, b) PROFILER_CONCAT_IMPL(a, b)
+/** Records the enclosing scope, category and name must be string literals */
+#define PROFILER_SCOPE(category, name) profiler::Scope const PROFILER_CONCAT(_profilerScope, __LINE__)(category, name)
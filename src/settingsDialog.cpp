@@ -34,18 +34,17 @@ public:
 		setupUi(parent);
 
 		// Initialize settings (blocking signals)
-		auto& settings = settings::SettingsManager::getInstance();
-		
+
 		// Automatic PNG Download
 		{
 			QSignalBlocker lock(automaticPNGDownloadCheckBox);
-			automaticPNGDownloadCheckBox->setChecked(settings.getValue(settings::AutomaticPNGDownloadEnabled.name).toBool());
+			automaticPNGDownloadCheckBox->setChecked(settings::AutomaticPNGDownloadEnabled.get());
 		}
 
 		// AEM Cache
 		{
 			QSignalBlocker lock(enableAEMCacheCheckBox);
-			enableAEMCacheCheckBox->setChecked(settings.getValue(settings::AemCacheEnabled.name).toBool());
+			enableAEMCacheCheckBox->setChecked(settings::AemCacheEnabled.get());
 		}
 	}
 };
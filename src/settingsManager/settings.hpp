@@ -27,11 +27,12 @@ namespace settings
 // Settings with a default initial value
 static SettingsManager::SettingDefault LastLaunchedVersion = { "LastLaunchedVersion", "1.0.0.0" };
 
-// General settings
-static SettingsManager::SettingDefault AutomaticPNGDownloadEnabled = { "avdecc/general/enableAutomaticPNGDownload", false };
+// General settings (typed handles are shared by all translation units, so each caches its slot only once)
+inline SettingsManager::TypedSetting<bool> AutomaticPNGDownloadEnabled{ "avdecc/general/enableAutomaticPNGDownload", false };
+inline SettingsManager::TypedSetting<int> LogoCacheMemoryBudget{ "avdecc/general/logoCacheMemoryBudget", 32 }; // In MiB
 	
 // Controller settings
-static SettingsManager::SettingDefault AemCacheEnabled = { "avdecc/controller/enableAemCache", false };
+inline SettingsManager::TypedSetting<bool> AemCacheEnabled{ "avdecc/controller/enableAemCache", false };
 
 // Settings with no default initial value (no need to register with the SettingsManager) - Not allowed to call registerSettingObserver for those
 static SettingsManager::Setting ProtocolType = { "protocolType" };
@@ -42,5 +43,6 @@ static SettingsManager::Setting EntityInspectorState = { "entityInspector/state"
 static SettingsManager::Setting SplitterState = { "splitter/state" };
 static SettingsManager::Setting MainWindowGeometry = { "mainWindow/geometry" };
 static SettingsManager::Setting MainWindowState = { "mainWindow/state" };
+static SettingsManager::Setting MappingPresets = { "mappingPresets" };
 
 } // namespace settings
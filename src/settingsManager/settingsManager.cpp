@@ -21,6 +21,12 @@
 #include <la/avdecc/utils.hpp>
 #include <QSettings>
 #include <QHash>
+#include <QTimer>
+#include <QThreadPool>
+#include <QRunnable>
+#include <QCoreApplication>
+#include <memory>
+#include <mutex>
 #include <unordered_map>
 
 struct QStringHash
@@ -36,18 +42,139 @@ namespace settings
 
 class SettingsManagerImpl : public SettingsManager
 {
+public:
+	SettingsManagerImpl() noexcept
+	{
+		// All values are loaded in memory, QSettings is only used to persist changes
+		auto values = std::make_shared<Values>();
+		{
+			auto const qSettings = QSettings{};
+			_filePath = qSettings.fileName();
+			for (auto const& key : qSettings.allKeys())
+			{
+				values->insert({ key, qSettings.value(key) });
+			}
+		}
+		std::atomic_store(&_values, std::shared_ptr<Values const>{ std::move(values) });
+
+		// A single writer thread, so batches are written in order
+		_flushPool.setMaxThreadCount(1);
+
+		_flushTimer.setSingleShot(true);
+		_flushTimer.setInterval(FlushDelay);
+		QObject::connect(&_flushTimer, &QTimer::timeout, [this]()
+		{
+			flushPendingWrites(false);
+		});
+		if (auto* const app = QCoreApplication::instance())
+		{
+			QObject::connect(app, &QCoreApplication::aboutToQuit, [this]()
+			{
+				flush();
+			});
+		}
+	}
+
+	// Nothing to flush here: pending writes are flushed on aboutToQuit, QSettings and the writer thread cannot be used during static destruction
+	~SettingsManagerImpl() noexcept = default;
+
 private:
+	using Values = std::unordered_map<QString, QVariant, QStringHash>;
+
+	// Delay between a change and its write to disk, changes done in the meantime are written in the same batch
+	static constexpr int FlushDelay = 1000;
+
+	/** Writes a batch of changes to disk, from the writer thread */
+	class FlushRunnable : public QRunnable
+	{
+	public:
+		FlushRunnable(Values&& batch) noexcept
+			: _batch(std::move(batch))
+		{
+		}
+
+		virtual void run() override
+		{
+			write(_batch);
+		}
+
+		static void write(Values const& batch) noexcept
+		{
+			// QSettings is reentrant, this instance shares the parsed file with the others
+			auto qSettings = QSettings{};
+			for (auto const& [name, value] : batch)
+			{
+				qSettings.setValue(name, value);
+			}
+			qSettings.sync();
+		}
+
+	private:
+		Values _batch{};
+	};
+
+	/** Publishes a new snapshot with the value changed and queues the change to be written to disk */
+	void storeValue(Setting const& name, QVariant const& value) noexcept
+	{
+		{
+			auto const lg = std::lock_guard{ _lock };
+
+			// Copy-on-write: readers keep using the previous snapshot until they load the new one
+			auto values = std::make_shared<Values>(*std::atomic_load(&_values));
+			(*values)[name] = value;
+			std::atomic_store(&_values, std::shared_ptr<Values const>{ std::move(values) });
+
+			auto const slotIt = _typedSlots.find(name);
+			if (slotIt != _typedSlots.end())
+			{
+				auto& slot = *slotIt->second;
+				slot.bits.store(slot.fromVariant(value), std::memory_order_release);
+			}
+
+			_pendingWrites[name] = value;
+		}
+
+		// At most one write to disk per FlushDelay, however often the value changes
+		if (!_flushTimer.isActive())
+		{
+			_flushTimer.start();
+		}
+	}
+
+	void flushPendingWrites(bool const synchronous) noexcept
+	{
+		auto batch = Values{};
+		{
+			auto const lg = std::lock_guard{ _lock };
+			batch.swap(_pendingWrites);
+		}
+
+		if (synchronous)
+		{
+			_flushPool.waitForDone();
+			if (!batch.empty())
+			{
+				FlushRunnable::write(batch);
+			}
+		}
+		else if (!batch.empty())
+		{
+			_flushPool.start(new FlushRunnable{ std::move(batch) });
+		}
+	}
+
+	// SettingsManager overrides
 	virtual void registerSetting(SettingDefault const& setting) noexcept override
 	{
-		if (!_settings.contains(setting.name))
+		if (!std::atomic_load(&_values)->count(setting.name))
 		{
-			_settings.setValue(setting.name, setting.initialValue);
+			storeValue(setting.name, setting.initialValue);
 		}
 	}
 
 	virtual void setValue(Setting const& name, QVariant const& value, Observer const* const dontNotifyObserver) noexcept override
 	{
-		_settings.setValue(name, value);
+		storeValue(name, value);
 
 		// Notify observers
 		auto const observersIt = _observers.find(name);
@@ -65,19 +192,26 @@ private:
 
 	virtual QVariant getValue(Setting const& name) const noexcept override
 	{
-		return _settings.value(name);
+		auto const values = std::atomic_load(&_values);
+		auto const it = values->find(name);
+		if (it == values->end())
+		{
+			return {};
+		}
+		return it->second;
 	}
 
 	virtual void registerSettingObserver(Setting const& name, Observer* const observer) noexcept override
 	{
-		if (AVDECC_ASSERT_WITH_RET(_settings.contains(name), "registerSettingObserver not allowed for a Setting without initial Value"))
+		auto const values = std::atomic_load(&_values);
+		auto const valueIt = values->find(name);
+		if (AVDECC_ASSERT_WITH_RET(valueIt != values->end(), "registerSettingObserver not allowed for a Setting without initial Value"))
 		{
 			auto& observers = _observers[name];
 			try
 			{
 				observers.registerObserver(observer);
-				auto const value = _settings.value(name);
-				la::avdecc::invokeProtectedMethod(&Observer::onSettingChanged, observer, name, value);
+				la::avdecc::invokeProtectedMethod(&Observer::onSettingChanged, observer, name, valueIt->second);
 			}
 			catch (...)
 			{
@@ -102,14 +236,16 @@ private:
 
 	virtual void triggerSettingObserver(Setting const& name, Observer* const observer) noexcept override
 	{
-		if (AVDECC_ASSERT_WITH_RET(_settings.contains(name), "triggerSettingObserver not allowed for a Setting without initial Value"))
+		auto const values = std::atomic_load(&_values);
+		auto const valueIt = values->find(name);
+		if (AVDECC_ASSERT_WITH_RET(valueIt != values->end(), "triggerSettingObserver not allowed for a Setting without initial Value"))
 		{
 			auto const observersIt = _observers.find(name);
 			if (observersIt != _observers.end())
 			{
 				if (observersIt->second.isObserverRegistered(observer))
 				{
-					la::avdecc::invokeProtectedMethod(&Observer::onSettingChanged, observer, name, _settings.value(name));
+					la::avdecc::invokeProtectedMethod(&Observer::onSettingChanged, observer, name, valueIt->second);
 				}
 			}
 		}
@@ -117,11 +253,50 @@ private:
 
 	virtual QString getFilePath() const noexcept override
 	{
-		return _settings.fileName();
+		return _filePath;
+	}
+
+	virtual void flush() noexcept override
+	{
+		_flushTimer.stop();
+		flushPendingWrites(true);
+	}
+
+	virtual void registerTypedSlot(Setting const& name, TypedSlot::Converter const converter) noexcept override
+	{
+		auto const lg = std::lock_guard{ _lock };
+		auto& slot = _typedSlots[name];
+		if (!slot)
+		{
+			slot = std::unique_ptr<TypedSlot>{ new TypedSlot{ converter } };
+			auto const values = std::atomic_load(&_values);
+			auto const valueIt = values->find(name);
+			if (valueIt != values->end())
+			{
+				slot->bits.store(converter(valueIt->second), std::memory_order_release);
+			}
+		}
+	}
+
+	virtual TypedSlot const* getTypedSlot(Setting const& name) const noexcept override
+	{
+		auto const lg = std::lock_guard{ _lock };
+		auto const slotIt = _typedSlots.find(name);
+		if (slotIt == _typedSlots.end())
+		{
+			return nullptr;
+		}
+		return slotIt->second.get();
 	}
 
 	// Private Members
-	QSettings _settings{};
+	mutable std::mutex _lock{}; // Protects writers of _values, _typedSlots and _pendingWrites
+	std::shared_ptr<Values const> _values{}; // Published snapshot, only accessed through std::atomic_load/store
+	std::unordered_map<QString, std::unique_ptr<TypedSlot>, QStringHash> _typedSlots{}; // Slots are never removed, handles cache their address
+	Values _pendingWrites{};
+	QString _filePath{};
+	QTimer _flushTimer{};
+	QThreadPool _flushPool{};
 	std::unordered_map<QString, Subject, QStringHash> _observers{};
 };
 
@@ -22,6 +22,10 @@
 #include <QString>
 #include <QVariant>
 #include <la/avdecc/utils.hpp>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
 
 namespace settings
 {
@@ -38,6 +42,69 @@ public:
 		QVariant initialValue{};
 	};
 
+	/** Current value of a typed setting, stored as raw bits so it can be read without lock */
+	struct TypedSlot
+	{
+		using Converter = std::uint64_t (*)(QVariant const& value);
+		Converter const fromVariant{ nullptr };
+		std::atomic<std::uint64_t> bits{ 0u };
+	};
+
+	/**
+	* @brief Handle on a setting of a small trivially copyable type (bool, int, enum), with an initial value.
+	* @details Reading only loads the value published by the SettingsManager (no lock, no QSettings access) and can be done from any thread.
+	*          The handle must be registered (see registerSetting) before being read, the initial value is returned otherwise.
+	*/
+	template<typename T>
+	class TypedSetting
+	{
+	public:
+		static_assert(std::is_trivially_copyable_v<T> && sizeof(T) <= sizeof(std::uint64_t), "TypedSetting only supports small trivially copyable types");
+
+		TypedSetting(Setting const& settingName, T const initialSettingValue) noexcept
+			: name{ settingName }
+			, initialValue{ initialSettingValue }
+		{
+		}
+
+		operator SettingDefault() const
+		{
+			return SettingDefault{ name, QVariant::fromValue(initialValue) };
+		}
+
+		T get() const noexcept
+		{
+			auto const* slot = _slot.load(std::memory_order_acquire);
+			if (!slot)
+			{
+				slot = SettingsManager::getInstance().getTypedSlot(name);
+				if (!slot)
+				{
+					return initialValue;
+				}
+				_slot.store(slot, std::memory_order_release);
+			}
+			auto value = T{};
+			auto const bits = slot->bits.load(std::memory_order_acquire);
+			std::memcpy(&value, &bits, sizeof(T));
+			return value;
+		}
+
+		static std::uint64_t toBits(QVariant const& variant) noexcept
+		{
+			auto const value = variant.value<T>();
+			auto bits = std::uint64_t{ 0u };
+			std::memcpy(&bits, &value, sizeof(T));
+			return bits;
+		}
+
+		Setting const name{};
+		T const initialValue{};
+
+	private:
+		mutable std::atomic<TypedSlot const*> _slot{ nullptr };
+	};
+
 	class Observer : public la::avdecc::Observer<Subject>
 	{
 	public:
@@ -47,8 +114,16 @@ public:
 	static SettingsManager& getInstance() noexcept;
 
 	virtual void registerSetting(SettingDefault const& setting) noexcept = 0;
+	template<typename T>
+	void registerSetting(TypedSetting<T> const& setting) noexcept
+	{
+		registerSetting(static_cast<SettingDefault>(setting));
+		registerTypedSlot(setting.name, &TypedSetting<T>::toBits);
+	}
 
+	/** Changes are visible right away, and written to disk in the background shortly after (consecutive changes are coalesced). Must be called from the GUI thread. */
 	virtual void setValue(Setting const& name, QVariant const& value, Observer const* const dontNotifyObserver = nullptr) noexcept = 0;
+	/** Returns the value from the in-memory snapshot of the settings, without lock. Can be called from any thread. */
 	virtual QVariant getValue(Setting const& name) const noexcept = 0;
 
 	virtual void registerSettingObserver(Setting const& name, Observer* const observer) noexcept = 0;
@@ -57,8 +132,14 @@ public:
 	
 	virtual QString getFilePath() const noexcept = 0;
 
+	/** Writes pending changes to disk, blocking until done */
+	virtual void flush() noexcept = 0;
+
 protected:
 	SettingsManager() = default;
+
+	virtual void registerTypedSlot(Setting const& name, TypedSlot::Converter const converter) noexcept = 0;
+	virtual TypedSlot const* getTypedSlot(Setting const& name) const noexcept = 0;
 };
 
 } // namespace settings
@@ -0,0 +1,115 @@
+/*
+* Copyright 2017-2018, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be usefu_state,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "startupTrace.hpp"
+#include "avdecc/hiveLogItems.hpp"
+
+#include <QCoreApplication>
+#include <QThread>
+
+#include <chrono>
+#include <mutex>
+#include <vector>
+
+namespace startup
+{
+
+namespace
+{
+
+using Clock = std::chrono::steady_clock;
+
+struct Phase
+{
+	QString name{};
+	Clock::time_point end{};
+	bool guiThread{ true };
+};
+
+struct Trace
+{
+	std::mutex lock{};
+	Clock::time_point start{ Clock::now() };
+	std::vector<Phase> phases{};
+	bool completed{ false };
+};
+
+Trace& getTrace() noexcept
+{
+	static Trace s_Trace{};
+
+	return s_Trace;
+}
+
+qint64 elapsedMs(Clock::time_point const from, Clock::time_point const to) noexcept
+{
+	return std::chrono::duration_cast<std::chrono::milliseconds>(to - from).count();
+}
+
+} // namespace
+
+void traceStart() noexcept
+{
+	auto& trace = getTrace();
+	auto const lg = std::lock_guard{ trace.lock };
+	trace.start = Clock::now();
+	trace.phases.clear();
+	trace.completed = false;
+}
+
+void tracePhase(QString const& phaseName) noexcept
+{
+	auto const now = Clock::now();
+	auto const guiThread = !qApp || QThread::currentThread() == qApp->thread();
+
+	auto& trace = getTrace();
+	auto const lg = std::lock_guard{ trace.lock };
+	if (!trace.completed)
+	{
+		trace.phases.push_back(Phase{ phaseName, now, guiThread });
+	}
+}
+
+void traceUsable() noexcept
+{
+	auto const now = Clock::now();
+
+	auto& trace = getTrace();
+	auto phases = std::vector<Phase>{};
+	auto start = Clock::time_point{};
+	{
+		auto const lg = std::lock_guard{ trace.lock };
+		if (trace.completed)
+		{
+			return;
+		}
+		trace.completed = true;
+		phases = std::move(trace.phases);
+		start = trace.start;
+	}
+
+	// Log outside the lock, phases are relative to the application start
+	for (auto const& phase : phases)
+	{
+		LOG_HIVE_INFO(QString{ "Startup: %1 done at %2 ms%3" }.arg(phase.name).arg(elapsedMs(start, phase.end)).arg(phase.guiThread ? "" : " (worker thread)"));
+	}
+	LOG_HIVE_INFO(QString{ "Startup: window usable after %1 ms" }.arg(elapsedMs(start, now)));
+}
+
+} // namespace startup
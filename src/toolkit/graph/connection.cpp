@@ -40,16 +40,39 @@ ConnectionItem::~ConnectionItem()
 
 void ConnectionItem::setStart(QPointF const& p)
 {
-	_start = p;
+	if (p != _start)
+	{
+		_start = p;
+		_pathDirty = true;
+	}
 	updatePath();
 }
 
 void ConnectionItem::setStop(QPointF const& p)
 {
-	_stop = p;
+	if (p != _stop)
+	{
+		_stop = p;
+		_pathDirty = true;
+	}
 	updatePath();
 }
 
+void ConnectionItem::setPreview(bool const preview)
+{
+	if (preview != _preview)
+	{
+		_preview = preview;
+		_pathDirty = true;
+	}
+	updatePath();
+}
+
+bool ConnectionItem::isPreview() const
+{
+	return _preview;
+}
+
 int ConnectionItem::type() const
 {
 	return ItemType::Connection;
@@ -119,11 +142,30 @@ void ConnectionItem::paint(QPainter* painter, const QStyleOptionGraphicsItem* op
 	pen.setWidth(3);
 	pen.setColor(NodeItemColor);
 	painter->setPen(pen);
+	if (_preview)
+	{
+		painter->setRenderHint(QPainter::Antialiasing, false);
+	}
 	painter->drawPath(path());
 }
 
 void ConnectionItem::updatePath()
 {
+	// Only rebuild the path (and the item geometry) when one of its inputs changed
+	if (!_pathDirty)
+	{
+		return;
+	}
+	_pathDirty = false;
+
+	if (_preview)
+	{
+		QPainterPath path(_start);
+		path.lineTo(_stop);
+		setPath(path);
+		return;
+	}
+
 	auto dist = _start.x() - _stop.x();
 
 	auto ratio = 0.5f;
@@ -37,6 +37,10 @@ public:
 	void setStart(QPointF const& p);
 	void setStop(QPointF const& p);
 
+	/** While in preview mode (during drag-editing), the connection is drawn as a cheap straight line */
+	void setPreview(bool const preview);
+	bool isPreview() const;
+
 	virtual int type() const override;
 
 	void connectInput(InputSocketItem* input);
@@ -56,6 +60,8 @@ private:
 private:
 	QPointF _start{};
 	QPointF _stop{};
+	bool _preview{false};
+	bool _pathDirty{true};
 
 	InputSocketItem* _input{nullptr};
 	OutputSocketItem* _output{nullptr};
@@ -21,6 +21,9 @@
 #include "inputSocket.hpp"
 #include "outputSocket.hpp"
 #include "type.hpp"
+#include "view.hpp"
+
+#include <QGraphicsScene>
 
 #include <QPainter>
 
@@ -40,6 +43,12 @@ NodeItem::NodeItem(int id, QString const& text, QGraphicsItem* parent)
 	updateGeometry();
 }
 
+NodeItem::~NodeItem()
+{
+	// Sockets are about to be destroyed
+	invalidateSocketIndex();
+}
+
 int NodeItem::type() const
 {
 	return ItemType::Node;
@@ -106,6 +115,12 @@ QVariant NodeItem::itemChange(GraphicsItemChange change, QVariant const& value)
 		propagateChanges();
 	}
 
+	// Sockets are leaving the current scene, or entering a new one
+	if (change == QGraphicsItem::ItemSceneChange || change == QGraphicsItem::ItemSceneHasChanged)
+	{
+		invalidateSocketIndex();
+	}
+
 	return QGraphicsItem::itemChange(change, value);
 }
 
@@ -167,6 +182,8 @@ void NodeItem::updateGeometry()
 
 void NodeItem::propagateChanges()
 {
+	invalidateSocketIndex();
+
 	for (auto& input : _inputs)
 	{
 		input->updateGeometry();
@@ -177,4 +194,18 @@ void NodeItem::propagateChanges()
 	}
 }
 
+void NodeItem::invalidateSocketIndex() const
+{
+	if (auto* const itemScene = scene())
+	{
+		for (auto* view : itemScene->views())
+		{
+			if (auto* graphicsView = qobject_cast<GraphicsView*>(view))
+			{
+				graphicsView->invalidateSocketIndex();
+			}
+		}
+	}
+}
+
 } // namespace graph
@@ -31,6 +31,7 @@ class NodeItem : public QGraphicsItem
 {
 public:
 	NodeItem(int id, QString const& text, QGraphicsItem* parent = nullptr);
+	~NodeItem();
 
 	virtual int type() const override;
 
@@ -48,6 +49,7 @@ private:
 
 	void updateGeometry();
 	void propagateChanges();
+	void invalidateSocketIndex() const;
 
 private:
 	int _id{-1};
@@ -0,0 +1,111 @@
+/*
+* Copyright 2017-2018, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be usefu_state,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "socketIndex.hpp"
+#include "socket.hpp"
+#include "type.hpp"
+
+#include <QGraphicsScene>
+
+#include <cmath>
+
+namespace graph
+{
+
+void SocketIndex::rebuild(QGraphicsScene const* scene)
+{
+	_cells.clear();
+	_scene = scene;
+	_valid = true;
+
+	if (!scene)
+	{
+		return;
+	}
+
+	for (auto* item : scene->items())
+	{
+		switch (item->type())
+		{
+			case ItemType::Input:
+			case ItemType::Output:
+			{
+				auto const rect = item->sceneBoundingRect();
+				auto const entry = Entry{ rect, static_cast<SocketItem*>(item) };
+
+				// A socket is registered in every cell its rect overlaps
+				auto const left = cellCoordinate(rect.left());
+				auto const right = cellCoordinate(rect.right());
+				auto const top = cellCoordinate(rect.top());
+				auto const bottom = cellCoordinate(rect.bottom());
+				for (auto y = top; y <= bottom; ++y)
+				{
+					for (auto x = left; x <= right; ++x)
+					{
+						_cells[cellKey(x, y)].push_back(entry);
+					}
+				}
+				break;
+			}
+			default:
+				break;
+		}
+	}
+}
+
+void SocketIndex::invalidate() noexcept
+{
+	_valid = false;
+}
+
+bool SocketIndex::isValid(QGraphicsScene const* scene) const noexcept
+{
+	return _valid && _scene == scene;
+}
+
+SocketItem* SocketIndex::socketAt(QPointF const& scenePos) const
+{
+	auto const it = _cells.find(cellKey(cellCoordinate(scenePos.x()), cellCoordinate(scenePos.y())));
+	if (it == _cells.end())
+	{
+		return nullptr;
+	}
+
+	for (auto const& [rect, socket] : it->second)
+	{
+		if (rect.contains(scenePos))
+		{
+			return socket;
+		}
+	}
+
+	return nullptr;
+}
+
+int SocketIndex::cellCoordinate(qreal const value) noexcept
+{
+	return static_cast<int>(std::floor(value / CellSize));
+}
+
+SocketIndex::CellKey SocketIndex::cellKey(int const x, int const y) noexcept
+{
+	return (static_cast<CellKey>(static_cast<std::uint32_t>(x)) << 32) | static_cast<std::uint32_t>(y);
+}
+
+} // namespace graph
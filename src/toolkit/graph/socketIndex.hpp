@@ -0,0 +1,66 @@
+/*
+* Copyright 2017-2018, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be usefu_state,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <QPointF>
+#include <QRectF>
+
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+class QGraphicsScene;
+
+namespace graph
+{
+
+class SocketItem;
+
+/**
+* @brief Uniform grid of the socket items of a scene, in scene coordinates.
+* @details Hit-testing a position only looks at the sockets of a single cell instead of querying all scene items.
+*          The index does not track item changes, it has to be invalidated when sockets are moved, added or removed.
+*/
+class SocketIndex final
+{
+public:
+	void rebuild(QGraphicsScene const* scene);
+	void invalidate() noexcept;
+	bool isValid(QGraphicsScene const* scene) const noexcept;
+
+	/** Returns the socket which scene bounding rect contains the specified position, or nullptr */
+	SocketItem* socketAt(QPointF const& scenePos) const;
+
+private:
+	using CellKey = std::uint64_t;
+	using Entry = std::pair<QRectF, SocketItem*>;
+
+	static constexpr qreal CellSize = 64.0;
+
+	static int cellCoordinate(qreal const value) noexcept;
+	static CellKey cellKey(int const x, int const y) noexcept;
+
+	QGraphicsScene const* _scene{ nullptr };
+	bool _valid{ false };
+	std::unordered_map<CellKey, std::vector<Entry>> _cells{};
+};
+
+} // namespace graph
@@ -24,6 +24,10 @@
 #include "type.hpp"
 
 #include <QMouseEvent>
+#include <QScreen>
+#include <QWindow>
+
+#include <algorithm>
 
 namespace graph
 {
@@ -37,6 +41,20 @@ GraphicsView::GraphicsView(QWidget* parent)
 	setTransformationAnchor(AnchorUnderMouse);
 	setDragMode(QGraphicsView::ScrollHandDrag);
 	setRenderHints(QPainter::Antialiasing | QPainter::TextAntialiasing | QPainter::HighQualityAntialiasing | QPainter::SmoothPixmapTransform);
+
+	_connectionDragTimer.setSingleShot(true);
+	connect(&_connectionDragTimer, &QTimer::timeout, this, [this]()
+	{
+		if (_connectionDragPending)
+		{
+			applyConnectionDrag();
+		}
+	});
+}
+
+void GraphicsView::invalidateSocketIndex()
+{
+	_socketIndex.invalidate();
 }
 
 void GraphicsView::mousePressEvent(QMouseEvent* event)
@@ -82,6 +100,7 @@ void GraphicsView::mousePressEvent(QMouseEvent* event)
 						}
 						event->ignore();
 					}
+					beginConnectionDrag();
 					return;
 				}
 				case ItemType::Output:
@@ -115,6 +134,7 @@ void GraphicsView::mousePressEvent(QMouseEvent* event)
 						}
 						event->ignore();
 					}
+					beginConnectionDrag();
 					return;
 				}
 				default:
@@ -128,33 +148,9 @@ void GraphicsView::mousePressEvent(QMouseEvent* event)
 
 void GraphicsView::mouseMoveEvent(QMouseEvent* event)
 {
-	auto const scenePos = mapToScene(event->pos());
-
 	if (_connectionDragEvent && event->buttons().testFlag(Qt::LeftButton))
 	{
-		switch (_connectionDragEvent->mode)
-		{
-			case ConnectionDragMode::ConnectToInput:
-			case ConnectionDragMode::MoveToInput:
-			{
-				for (auto& connection : _connectionDragEvent->connections)
-				{
-					connection->setStop(scenePos);
-				}
-				break;
-			}
-			case ConnectionDragMode::ConnectToOutput:
-			case ConnectionDragMode::MoveToOutput:
-			{
-				for (auto& connection : _connectionDragEvent->connections)
-				{
-					connection->setStart(scenePos);
-				}
-				break;
-			}
-			default:
-				break;
-		}
+		updateConnectionDrag(mapToScene(event->pos()));
 
 		auto* item = socketAt(event->pos());
 		if (item)
@@ -185,6 +181,9 @@ void GraphicsView::mouseReleaseEvent(QMouseEvent* event)
 	{
 		if (_connectionDragEvent)
 		{
+			_connectionDragTimer.stop();
+			_connectionDragPending = false;
+
 			auto item = socketAt(event->pos());
 			if (!item || !acceptableConnection(item))
 			{
@@ -211,6 +210,7 @@ void GraphicsView::mouseReleaseEvent(QMouseEvent* event)
 
 						for (auto& connection : _connectionDragEvent->connections)
 						{
+							connection->setPreview(false);
 							connection->connectInput(socket);
 							emit connectionCreated(connection);
 						}
@@ -223,6 +223,7 @@ void GraphicsView::mouseReleaseEvent(QMouseEvent* event)
 
 						for (auto& connection : _connectionDragEvent->connections)
 						{
+							connection->setPreview(false);
 							connection->connectOutput(socket);
 							emit connectionCreated(connection);
 						}
@@ -264,19 +265,86 @@ bool GraphicsView::acceptableConnection(SocketItem* item) const
 
 SocketItem* GraphicsView::socketAt(QPoint const& pos) const
 {
-	for (auto const& item : items(pos))
+	auto const* const currentScene = scene();
+	if (!_socketIndex.isValid(currentScene))
+	{
+		_socketIndex.rebuild(currentScene);
+	}
+
+	return _socketIndex.socketAt(mapToScene(pos));
+}
+
+void GraphicsView::beginConnectionDrag()
+{
+	if (!_connectionDragEvent)
 	{
-		switch (item->type())
+		return;
+	}
+
+	for (auto& connection : _connectionDragEvent->connections)
+	{
+		connection->setPreview(true);
+	}
+
+	// Throttle the dragged connections updates to the refresh rate of the display the view is shown on
+	auto refreshRate = qreal{ 60.0 };
+	if (auto const* const windowHandle = window()->windowHandle())
+	{
+		if (auto const* const screen = windowHandle->screen())
 		{
-			case ItemType::Input:
-			case ItemType::Output:
-				return static_cast<SocketItem*>(item);
-			default:
-				break;
+			refreshRate = std::max(refreshRate, screen->refreshRate());
 		}
 	}
+	_connectionDragTimer.setInterval(static_cast<int>(1000.0 / refreshRate));
+	_connectionDragPending = false;
+}
+
+void GraphicsView::updateConnectionDrag(QPointF const& scenePos)
+{
+	_connectionDragPos = scenePos;
+	_connectionDragPending = true;
+
+	// Apply right away if no update was done during the current frame, otherwise wait for the next one
+	if (!_connectionDragTimer.isActive())
+	{
+		applyConnectionDrag();
+	}
+}
+
+void GraphicsView::applyConnectionDrag()
+{
+	_connectionDragPending = false;
+
+	if (!_connectionDragEvent)
+	{
+		return;
+	}
+
+	switch (_connectionDragEvent->mode)
+	{
+		case ConnectionDragMode::ConnectToInput:
+		case ConnectionDragMode::MoveToInput:
+		{
+			for (auto& connection : _connectionDragEvent->connections)
+			{
+				connection->setStop(_connectionDragPos);
+			}
+			break;
+		}
+		case ConnectionDragMode::ConnectToOutput:
+		case ConnectionDragMode::MoveToOutput:
+		{
+			for (auto& connection : _connectionDragEvent->connections)
+			{
+				connection->setStart(_connectionDragPos);
+			}
+			break;
+		}
+		default:
+			break;
+	}
 
-	return nullptr;
+	_connectionDragTimer.start();
 }
 
 } // namespace graph
@@ -20,7 +20,9 @@
 #pragma once
 
 #include <QGraphicsView>
+#include <QTimer>
 #include "connection.hpp"
+#include "socketIndex.hpp"
 #include <memory>
 
 namespace graph
@@ -53,6 +55,9 @@ public:
 	Q_SIGNAL void connectionCreated(ConnectionItem* connection);
 	Q_SIGNAL void connectionDeleted(ConnectionItem* connection);
 
+	/** Must be called when sockets of the scene are moved, added or removed */
+	void invalidateSocketIndex();
+
 private:
 	virtual void mousePressEvent(QMouseEvent* event) override;
 	virtual void mouseMoveEvent(QMouseEvent* event) override;
@@ -61,9 +66,18 @@ private:
 private:
 	bool acceptableConnection(SocketItem* item) const;
 	SocketItem* socketAt(QPoint const& pos) const;
+	void beginConnectionDrag();
+	void updateConnectionDrag(QPointF const& scenePos);
+	void applyConnectionDrag();
 
 private:
 	std::unique_ptr<ConnectionDragEvent> _connectionDragEvent{};
+	mutable SocketIndex _socketIndex{};
+
+	// Dragged connections are moved at most once per display frame
+	QTimer _connectionDragTimer{};
+	QPointF _connectionDragPos{};
+	bool _connectionDragPending{false};
 };
 
 } // namespace graph
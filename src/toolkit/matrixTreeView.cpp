@@ -20,6 +20,7 @@
 #include "connectionMatrix.hpp"
 #include "matrixTreeView.hpp"
 #include "avdecc/helper.hpp"
+#include "profiler/memoryAccounting.hpp"
 
 #include <vector>
 #include <cassert>
@@ -44,6 +45,14 @@ public:
 	int indexForUserData(std::vector<std::unique_ptr<Node>> const& nodes, QVariant const& userData, std::function<bool(QVariant const& lhs, QVariant const& rhs)> const& comparisonFunction) const noexcept;
 	std::pair<int, Node const*> indexAndNodeForUserData(std::vector<std::unique_ptr<Node>> const& nodes, QVariant const& userData, std::function<bool(QVariant const& lhs, QVariant const& rhs)> const& comparisonFunction) const noexcept;
 
+	/** Accounts the node storage: the nodes themselves, the owning vectors and the reference held by the parent (or root) node */
+	void updateMemoryAccount() noexcept
+	{
+		auto const nodesCount = _vNodes.size() + _hNodes.size();
+		auto const storageCapacity = _vNodes.capacity() + _hNodes.capacity();
+		_memoryAccount.set(static_cast<std::int64_t>(nodesCount * (sizeof(Node) + sizeof(Node*)) + storageCapacity * sizeof(std::unique_ptr<Node>)));
+	}
+
 protected:
 	MatrixModel* const q_ptr{ nullptr };
 	Q_DECLARE_PUBLIC(MatrixModel);
@@ -53,6 +62,8 @@ protected:
 
 	std::vector<std::unique_ptr<Node>>  _hNodes{}; // Columns
 	Node _hRootNode{ nullptr }; // Root horizontal node
+
+	profiler::MemoryAccount _memoryAccount{ profiler::MemorySubsystem::MatrixNodes };
 };
 
 int MatrixModel::MatrixModelPrivate::indexForUserData(std::vector<std::unique_ptr<Node>> const& nodes, QVariant const& userData, std::function<bool(QVariant const& lhs, QVariant const& rhs)> const& comparisonFunction) const noexcept
@@ -146,6 +157,9 @@ std::pair<QModelIndex, MatrixModel::Node&> MatrixModel::appendRow(QModelIndex co
 
 void MatrixModel::endAppendRows()
 {
+	Q_D(MatrixModel);
+
+	d->updateMemoryAccount();
 	endInsertRows();
 }
 
@@ -162,6 +176,7 @@ bool MatrixModel::removeRows(int row, int count, QModelIndex const& parent)
 	auto const beginIt = d->_vNodes.begin() + row;
 	auto const endIt = beginIt + count;
 	d->_vNodes.erase(beginIt, endIt);
+	d->updateMemoryAccount();
 	endRemoveRows();
 
 	return true;
@@ -205,6 +220,9 @@ std::pair<QModelIndex, MatrixModel::Node&> MatrixModel::appendColumn(QModelIndex
 
 void MatrixModel::endAppendColumns()
 {
+	Q_D(MatrixModel);
+
+	d->updateMemoryAccount();
 	endInsertColumns();
 }
 
@@ -221,6 +239,7 @@ bool MatrixModel::removeColumns(int column, int count, QModelIndex const& parent
 	auto const beginIt = d->_hNodes.begin() + column;
 	auto const endIt = beginIt + count;
 	d->_hNodes.erase(beginIt, endIt);
+	d->updateMemoryAccount();
 	endRemoveColumns();
 
 	return true;
@@ -238,6 +257,8 @@ void MatrixModel::clearModel() noexcept
 	d->_hNodes.clear();
 	d->_hRootNode = nullptr;
 
+	d->updateMemoryAccount();
+
 	endResetModel();
 }
 
@@ -0,0 +1,144 @@
+/*
+* Copyright 2017-2018, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be usefu_state,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "connectionMatrix.hpp"
+#include <benchmark/benchmark.h>
+#include <QImage>
+#include <QPainter>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace
+{
+constexpr auto StreamFormat8Channels = la::avdecc::entity::model::StreamFormat{ 0x00A0020840000800 }; // IEC 61883-6 AM824, 48kHz, 8 channels
+constexpr auto StreamFormat2Channels = la::avdecc::entity::model::StreamFormat{ 0x00A0020240000200 }; // IEC 61883-6 AM824, 48kHz, 2 channels
+constexpr auto CellSize = 20;
+
+/** Synthetic talker and listener streams of a populated network, some of them connected, some with a mismatching format */
+class SyntheticStreams final
+{
+public:
+	SyntheticStreams(std::size_t const streamCount)
+	{
+		_talkerModels.resize(streamCount);
+		_listenerModels.resize(streamCount);
+		_talkers.reserve(streamCount);
+		_listeners.reserve(streamCount);
+
+		for (auto i = std::size_t{ 0u }; i < streamCount; ++i)
+		{
+			auto const streamIndex = static_cast<la::avdecc::entity::model::StreamIndex>(i);
+
+			auto& talkerModel = _talkerModels[i];
+			talkerModel.currentFormat = (i % 4u == 3u) ? StreamFormat2Channels : StreamFormat8Channels;
+			_talkers.emplace_back(streamIndex);
+			_talkers.back().dynamicModel = &talkerModel;
+
+			// Every other listener is connected to the talker stream with the same index
+			auto& listenerModel = _listenerModels[i];
+			listenerModel.currentFormat = StreamFormat8Channels;
+			if (i % 2u == 0u)
+			{
+				listenerModel.connectionState.state = la::avdecc::controller::model::StreamConnectionState::State::Connected;
+				listenerModel.connectionState.talkerStream = la::avdecc::entity::model::StreamIdentification{ talkerID(i), streamIndex };
+			}
+			_listeners.emplace_back(streamIndex);
+			_listeners.back().dynamicModel = &listenerModel;
+		}
+	}
+
+	static la::avdecc::UniqueIdentifier talkerID(std::size_t const streamIndex) noexcept
+	{
+		return la::avdecc::UniqueIdentifier{ 0x0001020304050000 + streamIndex / 8u };
+	}
+
+	std::vector<la::avdecc::controller::model::StreamOutputNode> const& talkers() const noexcept
+	{
+		return _talkers;
+	}
+
+	std::vector<la::avdecc::controller::model::StreamInputNode> const& listeners() const noexcept
+	{
+		return _listeners;
+	}
+
+private:
+	std::vector<la::avdecc::controller::model::StreamOutputNodeDynamicModel> _talkerModels{};
+	std::vector<la::avdecc::controller::model::StreamInputNodeDynamicModel> _listenerModels{};
+	std::vector<la::avdecc::controller::model::StreamOutputNode> _talkers{};
+	std::vector<la::avdecc::controller::model::StreamInputNode> _listeners{};
+};
+} // namespace
+
+static void BM_ConnectionMatrix_ConnectionCapabilities(benchmark::State& state)
+{
+	auto const streamCount = static_cast<std::size_t>(state.range(0));
+	auto const streams = SyntheticStreams{ streamCount };
+
+	for (auto _ : state)
+	{
+		for (auto t = std::size_t{ 0u }; t < streamCount; ++t)
+		{
+			auto const& talker = streams.talkers()[t];
+			auto const talkerID = SyntheticStreams::talkerID(t);
+			for (auto const& listener : streams.listeners())
+			{
+				benchmark::DoNotOptimize(connectionMatrix::computeStreamCapabilities(talkerID, talker, listener, (t % 16u) != 0u));
+			}
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * streamCount * streamCount);
+}
+BENCHMARK(BM_ConnectionMatrix_ConnectionCapabilities)->Arg(64)->Arg(256);
+
+static void BM_ConnectionMatrix_ItemDelegatePaint(benchmark::State& state)
+{
+	auto const cellCount = static_cast<int>(state.range(0));
+	auto image = QImage{ cellCount * CellSize, cellCount * CellSize, QImage::Format_ARGB32_Premultiplied };
+
+	// Every kind of cell the delegate can draw
+	using Caps = connectionMatrix::ConnectionCapabilities;
+	auto const capabilities = std::array<Caps, 8>{
+		Caps::Connectable,
+		Caps::Connectable | Caps::WrongDomain,
+		Caps::Connectable | Caps::WrongFormat,
+		Caps::Connectable | Caps::Connected,
+		Caps::Connectable | Caps::Connected | Caps::WrongDomain,
+		Caps::Connectable | Caps::Connected | Caps::WrongFormat,
+		Caps::Connectable | Caps::FastConnecting,
+		Caps::Connectable | Caps::PartiallyConnected,
+	};
+
+	for (auto _ : state)
+	{
+		image.fill(Qt::white);
+		auto painter = QPainter{ &image };
+		for (auto row = 0; row < cellCount; ++row)
+		{
+			for (auto column = 0; column < cellCount; ++column)
+			{
+				auto const caps = capabilities[static_cast<std::size_t>(row + column) % capabilities.size()];
+				connectionMatrix::ConnectionMatrixItemDelegate::drawCapabilities(&painter, QRect{ column * CellSize, row * CellSize, CellSize, CellSize }, caps, (row % 3) == 0);
+			}
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * cellCount * cellCount);
+}
+BENCHMARK(BM_ConnectionMatrix_ItemDelegatePaint)->Arg(32)->Arg(128)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,68 @@
+/*
+* Copyright 2017-2018, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be usefu_state,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "avdecc/loggerModel.hpp"
+#include "avdecc/loggerLevels.hpp"
+#include "avdecc/hiveLogItems.hpp"
+#include <benchmark/benchmark.h>
+#include <QCoreApplication>
+
+/** Log storm: every message goes through the level filter and rate limiter, and the ones passing them are appended to the model */
+static void BM_LoggerModel_Ingest(benchmark::State& state)
+{
+	auto const messageCount = static_cast<int>(state.range(0));
+	avdecc::logger::LayerLevels::getInstance().setLevel(la::avdecc::logger::Layer::FirstUserLayer, la::avdecc::logger::Level::Info);
+
+	auto model = avdecc::LoggerModel{};
+	auto const message = QString{ "Synthetic log message for entity 0x0001020304050607" };
+
+	for (auto _ : state)
+	{
+		for (auto i = 0; i < messageCount; ++i)
+		{
+			LOG_HIVE_INFO(message);
+		}
+		QCoreApplication::processEvents();
+
+		state.PauseTiming();
+		state.counters["Rows"] = model.rowCount();
+		model.clear();
+		state.ResumeTiming();
+	}
+	state.SetItemsProcessed(state.iterations() * messageCount);
+}
+BENCHMARK(BM_LoggerModel_Ingest)->Arg(100)->Arg(10000)->Unit(benchmark::kMicrosecond);
+
+/** Messages of a disabled level are dropped before being built */
+static void BM_LoggerModel_IngestFiltered(benchmark::State& state)
+{
+	avdecc::logger::LayerLevels::getInstance().setLevel(la::avdecc::logger::Layer::FirstUserLayer, la::avdecc::logger::Level::Error);
+
+	auto model = avdecc::LoggerModel{};
+	auto const message = QString{ "Synthetic log message for entity 0x0001020304050607" };
+
+	for (auto _ : state)
+	{
+		LOG_HIVE_INFO(message);
+	}
+	state.SetItemsProcessed(state.iterations());
+
+	avdecc::logger::LayerLevels::getInstance().setLevel(la::avdecc::logger::Layer::FirstUserLayer, la::avdecc::logger::Level::Info);
+}
+BENCHMARK(BM_LoggerModel_IngestFiltered);
@@ -0,0 +1,60 @@
+/*
+* Copyright 2017-2018, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be usefu_state,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <benchmark/benchmark.h>
+#include <QApplication>
+#include <cstring>
+#include <string>
+#include <vector>
+
+int main(int argc, char* argv[])
+{
+	// Widgets are painted into images, no display is required
+	if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+	{
+		qputenv("QT_QPA_PLATFORM", "offscreen");
+	}
+	QApplication app(argc, argv);
+
+	// Always write JSON results (unless specified otherwise on the command line), so they can be tracked per commit
+	auto arguments = std::vector<char*>{ argv, argv + argc };
+	auto hasOutput = false;
+	for (auto const* const arg : arguments)
+	{
+		hasOutput |= std::strncmp(arg, "--benchmark_out=", 16) == 0;
+	}
+	auto outArg = std::string{ "--benchmark_out=HiveBenchmarks.json" };
+	auto formatArg = std::string{ "--benchmark_out_format=json" };
+	if (!hasOutput)
+	{
+		arguments.push_back(outArg.data());
+		arguments.push_back(formatArg.data());
+	}
+	auto argCount = static_cast<int>(arguments.size());
+
+	benchmark::Initialize(&argCount, arguments.data());
+	if (benchmark::ReportUnrecognizedArguments(argCount, arguments.data()))
+	{
+		return 1;
+	}
+	benchmark::RunSpecifiedBenchmarks();
+	benchmark::Shutdown();
+
+	return 0;
+}
@@ -0,0 +1,128 @@
+/*
+* Copyright 2017-2018, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be usefu_state,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "toolkit/matrixTreeView.hpp"
+#include <benchmark/benchmark.h>
+#include <QVariant>
+#include <memory>
+#include <random>
+
+namespace
+{
+constexpr auto StreamsPerEntity = 8;
+
+/** Appends nodeCount rows, grouped as one entity row followed by its stream rows (like the connection matrix does) */
+void populateRows(qt::toolkit::MatrixModel& model, int const nodeCount)
+{
+	model.beginAppendRows({}, nodeCount);
+	auto parentIndex = QModelIndex{};
+	for (auto i = 0; i < nodeCount; ++i)
+	{
+		if (i % (StreamsPerEntity + 1) == 0)
+		{
+			auto const result = model.appendRow();
+			result.second.userData = i;
+			parentIndex = result.first;
+		}
+		else
+		{
+			auto const result = model.appendRow(parentIndex);
+			result.second.userData = i;
+		}
+	}
+	model.endAppendRows();
+}
+
+bool compareUserData(QVariant const& lhs, QVariant const& rhs)
+{
+	return lhs.toInt() == rhs.toInt();
+}
+} // namespace
+
+static void BM_MatrixModel_AppendRows(benchmark::State& state)
+{
+	auto const nodeCount = static_cast<int>(state.range(0));
+	for (auto _ : state)
+	{
+		auto model = qt::toolkit::MatrixModel{};
+		populateRows(model, nodeCount);
+		benchmark::DoNotOptimize(model.rowCount({}));
+	}
+	state.SetItemsProcessed(state.iterations() * nodeCount);
+}
+BENCHMARK(BM_MatrixModel_AppendRows)->Arg(1000)->Arg(10000)->Unit(benchmark::kMillisecond);
+
+static void BM_MatrixModel_RemoveRows(benchmark::State& state)
+{
+	auto const nodeCount = static_cast<int>(state.range(0));
+	auto constexpr RemoveCount = 1000;
+	auto random = std::mt19937{ 42u };
+	for (auto _ : state)
+	{
+		state.PauseTiming();
+		auto model = std::make_unique<qt::toolkit::MatrixModel>();
+		populateRows(*model, nodeCount);
+		state.ResumeTiming();
+
+		// Remove single rows at random positions, as entities going offline do
+		for (auto i = 0; i < RemoveCount; ++i)
+		{
+			auto const row = static_cast<int>(random() % static_cast<unsigned>(model->rowCount({})));
+			model->removeRows(row, 1);
+		}
+
+		state.PauseTiming();
+		model.reset();
+		state.ResumeTiming();
+	}
+	state.SetItemsProcessed(state.iterations() * RemoveCount);
+}
+BENCHMARK(BM_MatrixModel_RemoveRows)->Arg(10000)->Unit(benchmark::kMillisecond);
+
+static void BM_MatrixModel_RowForUserData(benchmark::State& state)
+{
+	auto const nodeCount = static_cast<int>(state.range(0));
+	auto model = qt::toolkit::MatrixModel{};
+	populateRows(model, nodeCount);
+
+	auto random = std::mt19937{ 42u };
+	for (auto _ : state)
+	{
+		auto const userData = QVariant{ static_cast<int>(random() % static_cast<unsigned>(nodeCount)) };
+		benchmark::DoNotOptimize(model.rowForUserData(userData, compareUserData));
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_MatrixModel_RowForUserData)->Arg(1000)->Arg(10000);
+
+static void BM_MatrixModel_NodeAtRow(benchmark::State& state)
+{
+	auto const nodeCount = static_cast<int>(state.range(0));
+	auto model = qt::toolkit::MatrixModel{};
+	populateRows(model, nodeCount);
+
+	auto row = 0;
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(model.nodeAtRow(row));
+		row = (row + 1) % nodeCount;
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_MatrixModel_NodeAtRow)->Arg(10000);
@@ -0,0 +1,126 @@
+/*
+* Copyright 2017-2018, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be usefu_state,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "nodeTreeDynamicWidgets/streamPortMappings.hpp"
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace
+{
+constexpr auto StreamCount = 64u;
+constexpr auto ChannelsPerStream = 8u;
+constexpr auto ChannelCount = StreamCount * ChannelsPerStream; // 512 channels, each mapped to a mono cluster
+
+/** Synthetic StreamPortInput fully mapped: each of the 512 stream channels to its own cluster */
+class SyntheticStreamPort final
+{
+public:
+	SyntheticStreamPort()
+	{
+		_streams.reserve(StreamCount);
+		for (auto streamIndex = 0u; streamIndex < StreamCount; ++streamIndex)
+		{
+			_streams.emplace_back(static_cast<la::avdecc::entity::model::StreamIndex>(streamIndex));
+			auto mapping = streamPortMappings::NodeMapping{ static_cast<la::avdecc::entity::model::DescriptorIndex>(streamIndex) };
+			for (auto channel = 0u; channel < ChannelsPerStream; ++channel)
+			{
+				mapping.channels.push_back(static_cast<std::uint16_t>(channel));
+			}
+			_streamMappings.push_back(std::move(mapping));
+		}
+		for (auto const& stream : _streams)
+		{
+			_streamNodes.push_back(&stream);
+		}
+
+		for (auto cluster = 0u; cluster < ChannelCount; ++cluster)
+		{
+			_clusterMappings.push_back(streamPortMappings::NodeMapping{ static_cast<la::avdecc::entity::model::DescriptorIndex>(cluster), { 0u } });
+			_dynamicModel.dynamicAudioMap.push_back(la::avdecc::entity::model::AudioMapping{ static_cast<la::avdecc::entity::model::StreamIndex>(cluster / ChannelsPerStream), static_cast<std::uint16_t>(cluster % ChannelsPerStream), static_cast<la::avdecc::entity::model::ClusterIndex>(cluster), 0u });
+		}
+		_streamPort.dynamicModel = &_dynamicModel;
+	}
+
+	mappingMatrix::Connections buildConnections() const
+	{
+		return streamPortMappings::buildConnections(_streamPort, _streamNodes, _streamMappings, _clusterMappings,
+			[](mappingMatrix::SlotID const streamSlotID, mappingMatrix::SlotID const clusterSlotID)
+			{
+				return std::make_pair(streamSlotID, clusterSlotID);
+			});
+	}
+
+private:
+	la::avdecc::controller::model::StreamPortNodeDynamicModel _dynamicModel{};
+	la::avdecc::controller::model::StreamPortNode _streamPort{ la::avdecc::entity::model::DescriptorType::StreamPortInput, la::avdecc::entity::model::StreamPortIndex{ 0u } };
+	std::vector<la::avdecc::controller::model::StreamInputNode> _streams{};
+	std::vector<la::avdecc::controller::model::StreamInputNode const*> _streamNodes{};
+	streamPortMappings::NodeMappings _streamMappings{};
+	streamPortMappings::NodeMappings _clusterMappings{};
+};
+} // namespace
+
+static void BM_StreamPortMappings_BuildConnections(benchmark::State& state)
+{
+	auto const streamPort = SyntheticStreamPort{};
+
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(streamPort.buildConnections());
+	}
+	state.SetItemsProcessed(state.iterations() * ChannelCount);
+}
+BENCHMARK(BM_StreamPortMappings_BuildConnections);
+
+static void BM_StreamPortMappings_HashConnectionsList(benchmark::State& state)
+{
+	auto connections = SyntheticStreamPort{}.buildConnections();
+	// Matrix connections are in the user's edition order, not sorted
+	std::reverse(connections.begin(), connections.end());
+
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(streamPortMappings::hashConnectionsList(connections));
+	}
+	state.SetItemsProcessed(state.iterations() * connections.size());
+}
+BENCHMARK(BM_StreamPortMappings_HashConnectionsList);
+
+/** Diff between the current mappings and an edition that moved every other channel, as done when applying the mapping matrix */
+static void BM_StreamPortMappings_Diff(benchmark::State& state)
+{
+	auto const oldConnections = SyntheticStreamPort{}.buildConnections();
+	auto newConnections = oldConnections;
+	for (auto i = std::size_t{ 0u }; i < newConnections.size(); i += 2u)
+	{
+		newConnections[i].second.first = (newConnections[i].second.first + 1u) % ChannelCount;
+	}
+
+	for (auto _ : state)
+	{
+		auto const oldList = streamPortMappings::hashConnectionsList(oldConnections);
+		auto const newList = streamPortMappings::hashConnectionsList(newConnections);
+		benchmark::DoNotOptimize(streamPortMappings::substractList(oldList, newList));
+		benchmark::DoNotOptimize(streamPortMappings::substractList(newList, oldList));
+	}
+	state.SetItemsProcessed(state.iterations() * ChannelCount);
+}
+BENCHMARK(BM_StreamPortMappings_Diff);